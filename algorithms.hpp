@@ -0,0 +1,289 @@
+/**@file
+ * @brief Saturating reductions: sums, dot products and prefix sums.
+ *
+ * A `for (auto v : x) s += v;` loop over saturating values clamps after every element, so each addition has to
+ * wait for the clamp of the previous one. The functions in this header avoid that dependency chain where they
+ * can:
+ * - `reduction::once` sums exactly, in a wide type spread over multiple independent lanes (which compilers
+ *   turn into vector adds), and clamps the total to `MIN` ... `MAX` at the end.
+ * - `reduction::per_step` saturates after every element, identical to the loop above. This is inherently
+ *   serial.
+ * - `reduction::automatic` (the default) picks `once` whenever it provably produces the per step result.
+ *   That is the case when all elements share a sign (any unsigned type or non-negative range for instance),
+ *   because a running sum that only moves in one direction stays at a limit once it reaches it. Otherwise
+ *   `per_step` is used.
+ *
+ * `init` is taken as is, also outside of `MIN` ... `MAX` (the default `T{}` is 0, even for a range excluding
+ * 0). Per step it is clamped together with the first element, so `init = 0` and values `5, 5` in `100 ... 200`
+ * give 100 and 105, while `once` adds it to the exact sum and gives 100 twice. `automatic` only picks `once`
+ * for an `init` within the limits, where both agree.
+ *
+ * Floating point values are always summed per step. The result type `T` can be a plain arithmetic type or a
+ * `saturating::type`, its limits are respected either way. With C++20 `std::span` overloads are provided as
+ * well.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<span>) && __cplusplus > 201703L
+#include <span>
+#endif
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+
+namespace saturating {
+    /** How a reduction handles intermediate results outside of the result range. */
+    enum class reduction {
+        /** `once` when that matches `per_step`, `per_step` otherwise. */
+        automatic,
+        /** Saturate after every element, like a loop over saturating types does. */
+        per_step,
+        /** Saturate the exact result (integral types only). */
+        once
+    };
+
+    namespace detail {
+        /** Lane accumulator for terms of type `P`, leaving room for many additions before it can overflow. */
+        template <typename P>
+        using lane_t = std::conditional_t<(sizeof(P) <= 2), std::int32_t,
+                       std::conditional_t<(sizeof(P) <= 4), std::int64_t,
+                                          widest_t>>;
+
+        /** Sign shared by all values of `V`: 1 for none negative, -1 for none positive, 0 otherwise. */
+        template <typename V>
+        constexpr int sign_of_v = !is_negative(range_of<V>::min_val) ? 1 : (!(range_of<V>::max_val > 0) ? -1 : 0);
+
+        template <typename... V>
+        constexpr bool integral_v = (is_integral_v<typename range_of<V>::value_type> && ...);
+
+        /**
+         * Does summing values of `V` once from `init` give the per step result? The values must share a sign and
+         * `init` must be within `MIN` ... `MAX`, per step it is only clamped once there is an element.
+         */
+        template <typename V, typename VT, limit_t<VT> MIN, limit_t<VT> MAX>
+        constexpr bool once_is_per_step(const VT& init) noexcept {
+            return sign_of_v<V> != 0 && !(init < MIN) && !(init > MAX);
+        }
+
+        constexpr widest_t wide_add(const widest_t& a, const widest_t& b) noexcept {
+            widest_t r = 0;
+            if (__builtin_add_overflow(a, b, &r)) {
+                r = b < 0 ? std::numeric_limits<widest_t>::lowest() : std::numeric_limits<widest_t>::max();
+            }
+            return r;
+        }
+
+        /** Exact product of integral `a` and `b`, products that don't fit `widest_t` saturate to it. */
+        template <typename A, typename B>
+        constexpr auto product(const A& a, const B& b) noexcept {
+            using TP = next_up_t<fit_all_t<A, B>>;
+            if constexpr (sizeof(TP) < sizeof(widest_t)) {
+                return static_cast<TP>(static_cast<TP>(a) * static_cast<TP>(b));
+            } else {
+                widest_t r = 0;
+                if (__builtin_mul_overflow(a, b, &r)) {
+                    r = is_negative(a) != is_negative(b) ? std::numeric_limits<widest_t>::lowest() : std::numeric_limits<widest_t>::max();
+                }
+                return r;
+            }
+        }
+
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX>
+        constexpr T from_wide(const widest_t& val) noexcept {
+            return val < static_cast<widest_t>(MIN) ? static_cast<T>(MIN)
+                 : val > static_cast<widest_t>(MAX) ? static_cast<T>(MAX)
+                 : static_cast<T>(val);
+        }
+
+        /**
+         * Exact sum of `term(0) ... term(n - 1)`, each returning values of integral type `P`. Independent lane
+         * accumulators are used for blocks small enough to never overflow them.
+         */
+        template <typename P, typename F>
+        inline widest_t wide_sum(std::size_t n, const F& term) noexcept {
+            using TA = lane_t<P>;
+            constexpr int spare = std::numeric_limits<TA>::digits - std::numeric_limits<P>::digits;
+
+            widest_t total = 0;
+            if constexpr (spare < 8) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    total = wide_add(total, static_cast<widest_t>(term(i)));
+                }
+            } else {
+                constexpr std::size_t lanes = 64 / sizeof(TA);
+                constexpr std::size_t block = std::size_t(1) << (spare < 40 ? spare : 40);
+                std::size_t i = 0;
+                while (i < n) {
+                    const std::size_t end = n - i > block ? i + block : n;
+                    TA acc[lanes] = {};
+                    for (; i + lanes <= end; i += lanes) {
+                        for (std::size_t l = 0; l < lanes; ++l) {
+                            acc[l] += static_cast<TA>(term(i + l));
+                        }
+                    }
+                    for (; i < end; ++i) {
+                        acc[0] += static_cast<TA>(term(i));
+                    }
+                    TA s = 0;
+                    for (std::size_t l = 0; l < lanes; ++l) {
+                        s += acc[l];
+                    }
+                    total = wide_add(total, static_cast<widest_t>(s));
+                }
+            }
+            return total;
+        }
+    } // namespace detail
+
+    /**
+     * Saturating sum of `n` elements of `x`, starting at `init`.
+     * @param  x    Values, plain or saturating
+     * @param  n    Number of elements
+     * @param  init Initial value, its type `T` determines the result type and limits. Not clamped, see above.
+     * @param  mode See `saturating::reduction`
+     * @return      The sum, saturated to the limits of `T`
+     */
+    template <typename T, typename V>
+    inline T accumulate(const V* x, std::size_t n, const T& init = T{}, reduction mode = reduction::automatic) noexcept {
+        using R = range_of<T>;
+        using VT = typename R::value_type;
+        constexpr auto MIN = R::min_val;
+        constexpr auto MAX = R::max_val;
+
+        if constexpr (detail::integral_v<T, V>) {
+            if (mode == reduction::once || (mode == reduction::automatic && detail::once_is_per_step<V, VT, MIN, MAX>(detail::value_of(init)))) {
+                const auto total = detail::wide_sum<typename range_of<V>::value_type>(
+                    n, [x](std::size_t i) { return detail::value_of(x[i]); });
+                return static_cast<T>(detail::from_wide<VT, MIN, MAX>(
+                    detail::wide_add(total, static_cast<detail::widest_t>(detail::value_of(init)))));
+            }
+        }
+        VT s = detail::value_of(init);
+        for (std::size_t i = 0; i < n; ++i) {
+            s = saturating::add<VT, MIN, MAX>(s, detail::value_of(x[i]));
+        }
+        return static_cast<T>(s);
+    }
+
+    /**
+     * Saturating dot product of `n` elements of `a` and `b`, starting at `init`. Per step this is
+     * `s = add(s, multiply(a[i], b[i]))`, so each product saturates to the limits of `T` as well.
+     * @param  a    Left hand side values, plain or saturating
+     * @param  b    Right hand side values, plain or saturating
+     * @param  n    Number of elements
+     * @param  init Initial value, its type `T` determines the result type and limits
+     * @param  mode See `saturating::reduction`, `automatic` only sums once when all products share a sign and
+     *              neither they nor `init` can be clamped towards zero.
+     * @return      The dot product, saturated to the limits of `T`
+     */
+    template <typename T, typename A, typename B>
+    inline T dot(const A* a, const B* b, std::size_t n, const T& init = T{}, reduction mode = reduction::automatic) noexcept {
+        using R = range_of<T>;
+        using VT = typename R::value_type;
+        constexpr auto MIN = R::min_val;
+        constexpr auto MAX = R::max_val;
+
+        if constexpr (detail::integral_v<T, A, B>) {
+            constexpr int sign = detail::sign_of_v<A> * detail::sign_of_v<B>;
+            const VT& s0 = detail::value_of(init);
+            const bool same = (sign > 0 && !(MIN > 0) && !is_negative(s0)) ||
+                              (sign < 0 && !is_negative(MAX) && !(s0 > 0));
+            if (mode == reduction::once || (mode == reduction::automatic && same)) {
+                using P = decltype(detail::product(detail::value_of(a[0]), detail::value_of(b[0])));
+                const auto total = detail::wide_sum<P>(
+                    n, [a, b](std::size_t i) { return detail::product(detail::value_of(a[i]), detail::value_of(b[i])); });
+                return static_cast<T>(detail::from_wide<VT, MIN, MAX>(
+                    detail::wide_add(total, static_cast<detail::widest_t>(s0))));
+            }
+        }
+        VT s = detail::value_of(init);
+        for (std::size_t i = 0; i < n; ++i) {
+            s = saturating::add<VT, MIN, MAX>(s, saturating::multiply<VT, MIN, MAX>(detail::value_of(a[i]), detail::value_of(b[i])));
+        }
+        return static_cast<T>(s);
+    }
+
+    /**
+     * Saturating prefix sums: `out[i]` is the sum of `init` and `x[0] ... x[i]`.
+     * @param  x    Values, plain or saturating
+     * @param  out  Output buffer, its type `T` determines the limits. May be equal to `x` if of the same type.
+     * @param  n    Number of elements
+     * @param  init Initial value, not clamped (see above)
+     * @param  mode See `saturating::reduction`
+     */
+    template <typename T, typename V>
+    inline void inclusive_scan(const V* x, T* out, std::size_t n, const T& init = T{}, reduction mode = reduction::automatic) noexcept {
+        using R = range_of<T>;
+        using VT = typename R::value_type;
+        using XT = typename range_of<V>::value_type;
+        constexpr auto MIN = R::min_val;
+        constexpr auto MAX = R::max_val;
+
+        if constexpr (detail::integral_v<T, V>) {
+            constexpr int sign = detail::sign_of_v<V>;
+            if constexpr (sign != 0 && sizeof(VT) <= 4 && sizeof(XT) <= 4) {
+                // Moving in one direction only: once the limit ahead is reached the remaining sums all equal it.
+                // Behind the other limit per step saturation holds the sum at that limit, `once` doesn't.
+                constexpr auto ahead  = static_cast<std::int64_t>(sign > 0 ? MAX : MIN);
+                constexpr auto behind = static_cast<std::int64_t>(sign > 0 ? MIN : MAX);
+                const bool step = mode != reduction::once;
+                std::int64_t s = detail::value_of(init);
+                for (std::size_t i = 0; i < n; ++i) {
+                    s += detail::value_of(x[i]);
+                    if (sign > 0 ? s >= ahead : s <= ahead) {
+                        for (; i < n; ++i) {
+                            out[i] = static_cast<T>(static_cast<VT>(ahead));
+                        }
+                        return;
+                    }
+                    if (sign > 0 ? s < behind : s > behind) {
+                        if (step) s = behind;
+                        out[i] = static_cast<T>(static_cast<VT>(behind));
+                    } else {
+                        out[i] = static_cast<T>(static_cast<VT>(s));
+                    }
+                }
+                return;
+            } else {
+                if (mode == reduction::once || (mode == reduction::automatic && detail::once_is_per_step<V, VT, MIN, MAX>(detail::value_of(init)))) {
+                    detail::widest_t s = detail::value_of(init);
+                    for (std::size_t i = 0; i < n; ++i) {
+                        s = detail::wide_add(s, static_cast<detail::widest_t>(detail::value_of(x[i])));
+                        out[i] = static_cast<T>(detail::from_wide<VT, MIN, MAX>(s));
+                    }
+                    return;
+                }
+            }
+        }
+        VT s = detail::value_of(init);
+        for (std::size_t i = 0; i < n; ++i) {
+            s = saturating::add<VT, MIN, MAX>(s, detail::value_of(x[i]));
+            out[i] = static_cast<T>(s);
+        }
+    }
+
+#ifdef __cpp_lib_span
+    template <typename T, typename V, std::size_t E>
+    inline T accumulate(std::span<V, E> x, const T& init = T{}, reduction mode = reduction::automatic) noexcept {
+        return saturating::accumulate<T>(x.data(), x.size(), init, mode);
+    }
+
+    template <typename T, typename A, typename B, std::size_t EA, std::size_t EB>
+    inline T dot(std::span<A, EA> a, std::span<B, EB> b, const T& init = T{}, reduction mode = reduction::automatic) noexcept {
+        return saturating::dot<T>(a.data(), b.data(), std::min(a.size(), b.size()), init, mode);
+    }
+
+    template <typename T, typename V, std::size_t EX, std::size_t EO>
+    inline void inclusive_scan(std::span<V, EX> x, std::span<T, EO> out, const T& init = T{}, reduction mode = reduction::automatic) noexcept {
+        saturating::inclusive_scan(x.data(), out.data(), std::min(x.size(), out.size()), init, mode);
+    }
+#endif // __cpp_lib_span
+} // namespace saturating
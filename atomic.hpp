@@ -0,0 +1,197 @@
+/**@file
+ * @brief Lock free saturating counters.
+ *
+ * `saturating::atomic<S>` holds a saturating integer (`type<T, MIN, MAX>` or a plain integer) shared between
+ * threads. `fetch_add` and `fetch_sub` saturate instead of wrapping, in one of two ways:
+ * - Types with headroom, where `T` reaches well beyond `MIN` ... `MAX` (like `type<uint32_t, 0, 1000000>`), use a
+ *   single `lock xadd`. A value beyond a bound reads as that bound, and the thread that pushed it there folds
+ *   it back. Updates towards a bound are exact, an update away from it that races with the fold may be absorbed
+ *   by the bound. `atomic<S, false>` always takes the exact path below.
+ * - Full range types, and deltas too large for the headroom, use a compare-exchange loop that returns without
+ *   writing once the value is pinned at the bound it is pushed against.
+ *
+ * Every counter is aligned to (and so fills) a cache line, neighbouring counters never share one.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "./utilities.hpp"
+#include "./stats.hpp"
+
+namespace saturating {
+    namespace detail {
+        /** Largest delta the lock free path may add towards `MAX` (`up`) or `MIN`: 1 / 65536th of the headroom. */
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX>
+        constexpr std::uint64_t headroom(bool up) noexcept {
+            // Modulo 2^64 the differences are exact for signed types as well
+            return (up ? static_cast<std::uint64_t>(std::numeric_limits<T>::max()) - static_cast<std::uint64_t>(MAX)
+                       : static_cast<std::uint64_t>(MIN) - static_cast<std::uint64_t>(std::numeric_limits<T>::lowest())) >> 16;
+        }
+
+        /** The strongest order valid for a load that is part of an `order` operation. */
+        constexpr std::memory_order load_order(std::memory_order order) noexcept {
+            return order == std::memory_order_release ? std::memory_order_relaxed
+                 : order == std::memory_order_acq_rel ? std::memory_order_acquire
+                 :                                      order;
+        }
+    } // namespace detail
+
+    /**
+     * Saturating integer `S`, updated atomically.
+     * @tparam S    `saturating::type` or integral type
+     * @tparam Lazy Use the `lock xadd` path when the headroom allows (see the file description)
+     */
+    template <typename S,
+              bool Lazy = (detail::headroom<typename range_of<S>::value_type, range_of<S>::min_val, range_of<S>::max_val>(true) > 0 ||
+                           detail::headroom<typename range_of<S>::value_type, range_of<S>::min_val, range_of<S>::max_val>(false) > 0)>
+    class alignas(detail::cache_line) atomic {
+        using T = typename range_of<S>::value_type;
+        static constexpr T MIN = range_of<S>::min_val;
+        static constexpr T MAX = range_of<S>::max_val;
+
+        static_assert(is_integral_v<T> && sizeof(T) <= sizeof(std::uint64_t), "Saturating counters hold integers up to 64 bit");
+
+    public:
+        using value_type = S;
+
+        static constexpr bool is_always_lock_free = std::atomic<T>::is_always_lock_free;
+
+        /** Zero, like `type`. */
+        constexpr atomic() noexcept : raw{ 0 } {}
+
+        /** Initial value `val`, as is. */
+        constexpr atomic(const S& val) noexcept : raw{ detail::value_of(val) } {}
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+
+        bool is_lock_free() const noexcept { return raw.is_lock_free(); }
+
+        S load(std::memory_order order = std::memory_order_seq_cst) const noexcept { return clamp(raw.load(order)); }
+        operator S() const noexcept { return load(); }
+
+        void store(const S& val, std::memory_order order = std::memory_order_seq_cst) noexcept { raw.store(detail::value_of(val), order); }
+        S operator=(const S& val) noexcept { store(val); return val; }
+
+        S exchange(const S& val, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return clamp(raw.exchange(detail::value_of(val), order));
+        }
+
+        /**
+         * Replace the value with `desired` if it is `expected`, otherwise load it into `expected`.
+         * @return Was the value replaced?
+         */
+        bool compare_exchange_strong(S& expected, const S& desired, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            T cur = raw.load(detail::load_order(order));
+            for (;;) {
+                // Values beyond the bounds compare as the bounds
+                if (detail::value_of(clamp(cur)) != detail::value_of(expected)) {
+                    expected = clamp(cur);
+                    return false;
+                }
+                if (raw.compare_exchange_weak(cur, detail::value_of(desired), order, detail::load_order(order))) return true;
+            }
+        }
+
+        /**
+         * Add `delta`, saturating at `MIN` and `MAX`.
+         * @param  delta Integer, may be negative
+         * @param  order Memory order of the update
+         * @return       Previous value
+         */
+        template <typename U>
+        std::enable_if_t<is_integral_v<typename range_of<U>::value_type>, S>
+        fetch_add(const U& delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return update(!is_negative(detail::value_of(delta)), magnitude<std::uint64_t>(detail::value_of(delta)), order);
+        }
+
+        /**
+         * Subtract `delta`, saturating at `MIN` and `MAX`.
+         * @param  delta Integer, may be negative
+         * @param  order Memory order of the update
+         * @return       Previous value
+         */
+        template <typename U>
+        std::enable_if_t<is_integral_v<typename range_of<U>::value_type>, S>
+        fetch_sub(const U& delta, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return update(is_negative(detail::value_of(delta)), magnitude<std::uint64_t>(detail::value_of(delta)), order);
+        }
+
+        S operator++() noexcept { return step(update(true, 1, std::memory_order_seq_cst), true, 1); }
+        S operator--() noexcept { return step(update(false, 1, std::memory_order_seq_cst), false, 1); }
+        S operator++(int) noexcept { return update(true, 1, std::memory_order_seq_cst); }
+        S operator--(int) noexcept { return update(false, 1, std::memory_order_seq_cst); }
+
+        template <typename U>
+        std::enable_if_t<is_integral_v<typename range_of<U>::value_type>, S> operator+=(const U& delta) noexcept {
+            const bool up = !is_negative(detail::value_of(delta));
+            const std::uint64_t m = magnitude<std::uint64_t>(detail::value_of(delta));
+            return step(update(up, m, std::memory_order_seq_cst), up, m);
+        }
+        template <typename U>
+        std::enable_if_t<is_integral_v<typename range_of<U>::value_type>, S> operator-=(const U& delta) noexcept {
+            const bool up = is_negative(detail::value_of(delta));
+            const std::uint64_t m = magnitude<std::uint64_t>(detail::value_of(delta));
+            return step(update(up, m, std::memory_order_seq_cst), up, m);
+        }
+
+    private:
+        static constexpr S clamp(const T& v) noexcept { return static_cast<T>(v < MIN ? MIN : (v > MAX ? MAX : v)); }
+
+        /** Distance from `v` (in range) to the bound in direction `up`. */
+        static constexpr std::uint64_t room(const T& v, bool up) noexcept {
+            return up ? static_cast<std::uint64_t>(MAX) - static_cast<std::uint64_t>(v) : static_cast<std::uint64_t>(v) - static_cast<std::uint64_t>(MIN);
+        }
+
+        /** `v` (in range) moved `m` towards the bound in direction `up`, saturated. */
+        static constexpr T step(const S& v, bool up, std::uint64_t m) noexcept {
+            const T x = detail::value_of(v);
+            if (m >= room(x, up)) return up ? MAX : MIN;
+            return up ? static_cast<T>(static_cast<std::uint64_t>(x) + m) : static_cast<T>(static_cast<std::uint64_t>(x) - m);
+        }
+
+        /** Move `m` towards `MAX` (`up`) or `MIN`, returning the previous value. */
+        S update(bool up, std::uint64_t m, std::memory_order order) noexcept {
+            if constexpr (Lazy) {
+                if (m <= detail::headroom<T, MIN, MAX>(up)) {
+                    if (m == 0) return load(detail::load_order(order));
+                    // Can't wrap: at most one headroom share per thread is in flight beyond the bound
+                    const T old = up ? raw.fetch_add(static_cast<T>(m), order) : raw.fetch_sub(static_cast<T>(m), order);
+                    const T now = up ? static_cast<T>(static_cast<std::uint64_t>(old) + m) : static_cast<T>(static_cast<std::uint64_t>(old) - m);
+                    if (up ? now > MAX : now < MIN) {
+                        detail::overflowed<stats::op::add>(true, up);
+                        fold(now, up);
+                    }
+                    return clamp(old);
+                }
+            }
+            T cur = raw.load(detail::load_order(order));
+            for (;;) {
+                const S prev = clamp(cur);
+                if (room(detail::value_of(prev), up) == 0) {
+                    // Pinned, nothing to write
+                    detail::overflowed<stats::op::add>(m != 0, up);
+                    return prev;
+                }
+                if (raw.compare_exchange_weak(cur, step(prev, up, m), order, detail::load_order(order))) {
+                    detail::overflowed<stats::op::add>(m > room(detail::value_of(prev), up), up);
+                    return prev;
+                }
+            }
+        }
+
+        /** Bring a value pushed beyond the bound in direction `up` back to that bound. */
+        void fold(T cur, bool up) noexcept {
+            const T bound = up ? MAX : MIN;
+            while ((up ? cur > MAX : cur < MIN) && !raw.compare_exchange_weak(cur, bound, std::memory_order_relaxed)) {}
+        }
+
+        std::atomic<T> raw;
+    };
+} // namespace saturating
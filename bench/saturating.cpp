@@ -0,0 +1,412 @@
+/**
+ * Google Benchmark suite for the saturating functions, see the README for build instructions.
+ *
+ * For every operation and global saturating type:
+ * - `latency`:    a dependency chain through the result, the cost of a single call
+ * - `throughput`: independent calls over pre-generated buffers
+ * - `raw`:        the same buffers with plain (wrapping) arithmetic, as a baseline
+ * Followed by the bulk kernels and reductions over the same buffer size.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "../functions.hpp"
+#include "../types.hpp"
+#include "../bulk.hpp"
+#include "../algorithms.hpp"
+#include "../divider.hpp"
+#include "../atomic.hpp"
+#include "../sharded_counter.hpp"
+#include "../histogram.hpp"
+#include "../table.hpp"
+#include "../stream.hpp"
+#include "../buffer.hpp"
+
+namespace {
+    constexpr std::size_t buffer_size = 4096;
+
+    /** Random values in the range of `T`, never zero (or -1, which traps for a plain `lowest / -1`). */
+    template <typename T>
+    std::vector<typename T::value_type> values(unsigned seed) {
+        using V = typename T::value_type;
+        std::mt19937_64 gen(seed);
+        std::vector<V> out(buffer_size);
+        for (auto& v : out) {
+            do {
+                if constexpr (std::is_floating_point_v<V>) {
+                    v = static_cast<V>(std::uniform_real_distribution<double>(saturating::range_of<T>::min_val, saturating::range_of<T>::max_val)(gen));
+                } else {
+                    v = static_cast<V>(std::uniform_int_distribution<long long>(
+                        static_cast<long long>(saturating::range_of<T>::min_val),
+                        static_cast<long long>(std::min<std::uint64_t>(saturating::range_of<T>::max_val, std::numeric_limits<long long>::max())))(gen));
+                }
+            } while (v == 0 || (std::is_signed_v<V> && v == static_cast<V>(-1)));
+        }
+        return out;
+    }
+
+    /** Plain arithmetic, wrapping for integers. */
+    template <typename V>
+    using raw_t = std::conditional_t<std::is_integral_v<V>, saturating::unsigned_t<V>, V>;
+
+    struct op_add {
+        template <typename T, typename V>
+        static V sat(const V& a, const V& b) noexcept { return saturating::add<V, saturating::range_of<T>::min_val, saturating::range_of<T>::max_val>(a, b); }
+        template <typename V>
+        static V raw(const V& a, const V& b) noexcept { return static_cast<V>(static_cast<raw_t<V>>(a) + static_cast<raw_t<V>>(b)); }
+    };
+
+    struct op_subtract {
+        template <typename T, typename V>
+        static V sat(const V& a, const V& b) noexcept { return saturating::subtract<V, saturating::range_of<T>::min_val, saturating::range_of<T>::max_val>(a, b); }
+        template <typename V>
+        static V raw(const V& a, const V& b) noexcept { return static_cast<V>(static_cast<raw_t<V>>(a) - static_cast<raw_t<V>>(b)); }
+    };
+
+    struct op_multiply {
+        template <typename T, typename V>
+        static V sat(const V& a, const V& b) noexcept { return saturating::multiply<V, saturating::range_of<T>::min_val, saturating::range_of<T>::max_val>(a, b); }
+        template <typename V>
+        static V raw(const V& a, const V& b) noexcept { return static_cast<V>(static_cast<raw_t<V>>(a) * static_cast<raw_t<V>>(b)); }
+    };
+
+    struct op_divide {
+        template <typename T, typename V>
+        static V sat(const V& a, const V& b) noexcept { return saturating::divide<V, saturating::range_of<T>::min_val, saturating::range_of<T>::max_val>(a, b); }
+        template <typename V>
+        static V raw(const V& a, const V& b) noexcept { return static_cast<V>(a / b); }
+    };
+
+    template <typename Op, typename T>
+    void latency(benchmark::State& state) {
+        const auto b = values<T>(2);
+        auto x = values<T>(1)[0];
+        for (auto _ : state) {
+            for (const auto& v : b) {
+                x = Op::template sat<T>(x, v);
+            }
+            benchmark::DoNotOptimize(x);
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    template <typename Op, typename T>
+    void throughput(benchmark::State& state) {
+        const auto a = values<T>(1);
+        const auto b = values<T>(2);
+        std::vector<typename T::value_type> out(buffer_size);
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < buffer_size; ++i) {
+                out[i] = Op::template sat<T>(a[i], b[i]);
+            }
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    template <typename Op, typename T>
+    void raw(benchmark::State& state) {
+        const auto a = values<T>(1);
+        const auto b = values<T>(2);
+        std::vector<typename T::value_type> out(buffer_size);
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < buffer_size; ++i) {
+                out[i] = Op::raw(a[i], b[i]);
+            }
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    template <typename T>
+    void bulk_add(benchmark::State& state) {
+        const auto a = values<T>(1);
+        const auto b = values<T>(2);
+        std::vector<typename T::value_type> out(buffer_size);
+        for (auto _ : state) {
+            saturating::add<typename T::value_type, saturating::range_of<T>::min_val, saturating::range_of<T>::max_val>(a.data(), b.data(), out.data(), buffer_size);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    /** `bulk_add` on `saturating::buffer`s of an odd size, over their padded size. */
+    template <typename T>
+    void bulk_add_buffer(benchmark::State& state) {
+        constexpr std::size_t n = buffer_size - 5;
+        const auto a = values<T>(1);
+        const auto b = values<T>(2);
+        saturating::buffer<T> x(n), y(n), out(n);
+        std::copy_n(a.begin(), n, x.begin());
+        std::copy_n(b.begin(), n, y.begin());
+        for (auto _ : state) {
+            saturating::add(x.data(), y.data(), out.data(), out.padded_size());
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+    }
+
+    template <typename T>
+    void bulk_divider(benchmark::State& state) {
+        const auto a = values<T>(1);
+        const saturating::divider<typename T::value_type, saturating::range_of<T>::min_val, saturating::range_of<T>::max_val> d { values<T>(2)[0] };
+        std::vector<typename T::value_type> out(buffer_size);
+        for (auto _ : state) {
+            saturating::divide(a.data(), d, out.data(), buffer_size);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    template <typename T, typename Src>
+    void bulk_scale(benchmark::State& state) {
+        const auto a = values<Src>(1);
+        std::vector<T> out(buffer_size);
+        for (auto _ : state) {
+            saturating::scale_buffer(a.data(), out.data(), buffer_size);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    /** `narrow` from `Src` to `Dst`, rounding to nearest even for floating point sources. */
+    template <typename Dst, typename Src>
+    void bulk_narrow(benchmark::State& state) {
+        const auto a = values<Src>(1);
+        std::vector<Dst> out(buffer_size);
+        for (auto _ : state) {
+            saturating::narrow<Dst, saturating::rounding::even>(a.data(), out.data(), buffer_size);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    /** The `from()` loop `narrow` replaces. */
+    template <typename Dst, typename Src>
+    void narrow_loop(benchmark::State& state) {
+        const auto a = values<Src>(1);
+        std::vector<Dst> out(buffer_size);
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < buffer_size; ++i) {
+                out[i] = Dst::from(a[i]);
+            }
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    /** `+` of `saturating::type` `T` in a loop, to compare policies. Operands are halved, so trapping ones run. */
+    template <typename T>
+    void type_add(benchmark::State& state) {
+        auto a = values<T>(1);
+        auto b = values<T>(2);
+        for (auto& v : a) v /= 2;
+        for (auto& v : b) v /= 2;
+        std::vector<T> out(buffer_size);
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < buffer_size; ++i) {
+                out[i] = T::from_unchecked(a[i]) + T::from_unchecked(b[i]);
+            }
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    template <typename T, typename V>
+    void reduce_accumulate(benchmark::State& state) {
+        const auto a = values<V>(1);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(saturating::accumulate<T>(a.data(), buffer_size));
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    /** The loop `accumulate` replaces. */
+    template <typename T, typename V>
+    void reduce_loop(benchmark::State& state) {
+        const auto a = values<V>(1);
+        for (auto _ : state) {
+            T s {};
+            for (const auto& v : a) {
+                s += v;
+            }
+            benchmark::DoNotOptimize(s);
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    using budget_t = saturating::type<uint32_t, 0, 1000000000>;
+
+    /** Increments of a counter shared by all threads. */
+    template <typename C>
+    void counter(benchmark::State& state) {
+        static C c {};
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(c.fetch_add(1, std::memory_order_relaxed));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /** Increments of a sharded counter shared by all threads. */
+    template <typename S>
+    void sharded(benchmark::State& state) {
+        static saturating::sharded_counter<S> c;
+        for (auto _ : state) {
+            ++c;
+        }
+        benchmark::DoNotOptimize(c.load());
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /** `Op` through a lookup table, compare with `throughput<Op, T>`. */
+    template <typename Op, typename T>
+    void lookup(benchmark::State& state) {
+        const auto a = values<T>(1);
+        const auto b = values<T>(2);
+        using V = typename T::value_type;
+        static const saturating::table<V> t { [](const V& x, const V& y) { return Op::template sat<T>(x, y); } };
+        std::vector<V> out(buffer_size);
+        for (auto _ : state) {
+            saturating::apply(t, a.data(), b.data(), out.data(), buffer_size);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    /** `scale_buffer` through a lookup table, compare with `bulk_scale<T, Src>`. */
+    template <typename T, typename Src>
+    void lookup_scale(benchmark::State& state) {
+        const auto a = values<Src>(1);
+        std::vector<T> out(buffer_size);
+        for (auto _ : state) {
+            saturating::apply(saturating::scale_table<T, Src>, a.data(), out.data(), buffer_size);
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    /** Bulk insertion of int16_t samples into a histogram of `S`. */
+    template <typename S>
+    void histogram_insert(benchmark::State& state) {
+        const auto a = values<int_sat16_t>(1);
+        saturating::histogram<S> h;
+        for (auto _ : state) {
+            h.insert(a.data(), buffer_size);
+            benchmark::DoNotOptimize(h[0]);
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    /** The clamp and increment loop bulk insertion replaces. */
+    template <typename S>
+    void histogram_loop(benchmark::State& state) {
+        const auto a = values<int_sat16_t>(1);
+        saturating::histogram<S> h;
+        for (auto _ : state) {
+            for (const auto& v : a) {
+                h.insert(v);
+            }
+            benchmark::DoNotOptimize(h[0]);
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+
+    /** Deltas of a stream of `T` samples arriving in chunks of `state.range(0)` samples. */
+    template <typename T>
+    void stream_delta(benchmark::State& state) {
+        using V = typename T::value_type;
+        const auto a = values<T>(1);
+        const auto chunk = static_cast<std::size_t>(state.range(0));
+        std::vector<V> out(buffer_size);
+        saturating::stream_processor<saturating::stream::delta, V> p;
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < buffer_size; i += chunk) {
+                p(a.data() + i, out.data() + i, std::min(chunk, buffer_size - i));
+            }
+            benchmark::DoNotOptimize(out.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * buffer_size);
+    }
+} // namespace
+
+#define SATURATING_BENCH_TYPES(bm, op)                \
+    BENCHMARK_TEMPLATE(bm, op, int_sat8_t);           \
+    BENCHMARK_TEMPLATE(bm, op, uint_sat8_t);          \
+    BENCHMARK_TEMPLATE(bm, op, int_sat16_t);          \
+    BENCHMARK_TEMPLATE(bm, op, uint_sat16_t);         \
+    BENCHMARK_TEMPLATE(bm, op, int_sat32_t);          \
+    BENCHMARK_TEMPLATE(bm, op, uint_sat32_t);         \
+    BENCHMARK_TEMPLATE(bm, op, int_sat64_t);          \
+    BENCHMARK_TEMPLATE(bm, op, uint_sat64_t);         \
+    BENCHMARK_TEMPLATE(bm, op, float_sat_t);          \
+    BENCHMARK_TEMPLATE(bm, op, double_sat_t)
+
+#define SATURATING_BENCH_OP(op)                       \
+    SATURATING_BENCH_TYPES(latency, op);              \
+    SATURATING_BENCH_TYPES(throughput, op);           \
+    SATURATING_BENCH_TYPES(raw, op)
+
+SATURATING_BENCH_OP(op_add);
+SATURATING_BENCH_OP(op_subtract);
+SATURATING_BENCH_OP(op_multiply);
+SATURATING_BENCH_OP(op_divide);
+
+BENCHMARK_TEMPLATE(bulk_add, uint_sat8_t);
+BENCHMARK_TEMPLATE(bulk_add, int_sat16_t);
+BENCHMARK_TEMPLATE(bulk_add, int_sat32_t);
+BENCHMARK_TEMPLATE(bulk_add, saturating::type<int16_t, -1000, 1000>);
+BENCHMARK_TEMPLATE(bulk_add_buffer, int_sat16_t);
+BENCHMARK_TEMPLATE(bulk_add_buffer, saturating::type<int16_t, -1000, 1000>);
+BENCHMARK_TEMPLATE(bulk_divider, int_sat16_t);
+BENCHMARK_TEMPLATE(bulk_divider, int_sat32_t);
+BENCHMARK_TEMPLATE(bulk_divider, uint_sat64_t);
+BENCHMARK_TEMPLATE(bulk_scale, saturating::type<int8_t, 16, 32>, int_sat16_t);
+BENCHMARK_TEMPLATE(bulk_scale, saturating::type<int8_t, 16, 32>, uint_sat8_t);
+BENCHMARK_TEMPLATE(lookup_scale, saturating::type<int8_t, 16, 32>, uint_sat8_t);
+BENCHMARK_TEMPLATE(bulk_narrow, int_sat16_t, int_sat32_t);
+BENCHMARK_TEMPLATE(narrow_loop, int_sat16_t, int_sat32_t);
+BENCHMARK_TEMPLATE(bulk_narrow, uint_sat8_t, int_sat32_t);
+BENCHMARK_TEMPLATE(narrow_loop, uint_sat8_t, int_sat32_t);
+BENCHMARK_TEMPLATE(bulk_narrow, saturating::type<int8_t, 16, 32>, int_sat16_t);
+BENCHMARK_TEMPLATE(bulk_narrow, int_sat16_t, float_sat_t);
+BENCHMARK_TEMPLATE(narrow_loop, int_sat16_t, float_sat_t);
+BENCHMARK_TEMPLATE(lookup, op_multiply, uint_sat8_t);
+BENCHMARK_TEMPLATE(lookup, op_multiply, int_sat8_t);
+BENCHMARK_TEMPLATE(lookup, op_divide, uint_sat8_t);
+BENCHMARK_TEMPLATE(lookup, op_divide, int_sat8_t);
+BENCHMARK_TEMPLATE(type_add, int_sat16_t);
+BENCHMARK_TEMPLATE(type_add, saturating::type<int16_t, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max(), saturating::policy::trap>);
+BENCHMARK_TEMPLATE(reduce_accumulate, uint_sat32_t, uint_sat8_t);
+BENCHMARK_TEMPLATE(reduce_loop, uint_sat32_t, uint_sat8_t);
+BENCHMARK_TEMPLATE(reduce_accumulate, int_sat32_t, int_sat16_t);
+BENCHMARK_TEMPLATE(reduce_loop, int_sat32_t, int_sat16_t);
+BENCHMARK_TEMPLATE(counter, std::atomic<uint32_t>)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(counter, saturating::atomic<budget_t>)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(counter, saturating::atomic<uint_sat32_t>)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(sharded, budget_t)->ThreadRange(1, 8);
+BENCHMARK_TEMPLATE(histogram_insert, saturating::type<int8_t, 16, 32>);
+BENCHMARK_TEMPLATE(histogram_loop, saturating::type<int8_t, 16, 32>);
+BENCHMARK_TEMPLATE(histogram_insert, uint_sat8_t);
+BENCHMARK_TEMPLATE(histogram_loop, uint_sat8_t);
+BENCHMARK_TEMPLATE(stream_delta, int_sat16_t)->Arg(61)->Arg(256)->Arg(4093);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,166 @@
+/**@file
+ * @brief Aligned, padded storage for the bulk functions.
+ *
+ * The bulk kernels run whole vector registers and finish with a scalar loop for the remaining elements. A
+ * `std::vector<int_sat16_t>` is aligned for `int16_t` only and ends wherever its size ends, so every call pays for
+ * split loads and for that tail. `saturating::buffer<S>` starts on a cache line (`detail::cache_line`, as wide as
+ * the widest register) and rounds its storage up to a whole number of cache lines. The padding always holds valid
+ * values of `S`, so passing `padded_size()` instead of `size()` to the bulk functions lets them run whole
+ * registers only:
+ *
+ *     saturating::add(a.data(), b.data(), out.data(), out.padded_size());
+ *
+ * Memory comes from a `std::pmr::memory_resource`, the default resource unless one is passed, so buffers can be
+ * carved from an arena (`std::pmr::monotonic_buffer_resource`) or a pool (`std::pmr::unsynchronized_pool_resource`).
+ * `reset(n)` resizes a buffer without touching the resource as long as `n` fits its capacity, which makes reusing
+ * buffers for every frame of a stream free of allocations.
+ *
+ * Elements are `S` itself (a `saturating::type` or plain arithmetic type), which must be trivially copyable.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<span>) && __cplusplus > 201703L
+#include <span>
+#endif
+
+#include "./utilities.hpp"
+
+namespace saturating {
+    /**
+     * Cache line aligned, padded buffer of `S`.
+     * @tparam S Element type, saturating or plain arithmetic
+     */
+    template <typename S>
+    class buffer {
+        using R = range_of<S>;
+        using VT = typename R::value_type;
+
+        static_assert(is_arithmetic_v<S> && std::is_trivially_copyable_v<S>, "Buffers hold saturating or arithmetic types");
+        static_assert(detail::cache_line % sizeof(S) == 0, "Elements must tile a cache line");
+
+    public:
+        using value_type = S;
+        using size_type = std::size_t;
+        using iterator = S*;
+        using const_iterator = const S*;
+
+        /** Alignment of the storage in bytes. */
+        static constexpr std::size_t alignment = detail::cache_line;
+
+        /** Elements per `alignment`, storage is a multiple of this. */
+        static constexpr std::size_t granule = alignment / sizeof(S);
+
+        /** Value of the padding: the value in `MIN` ... `MAX` closest to zero. */
+        static constexpr VT pad = R::min_val > 0 ? static_cast<VT>(R::min_val) : (R::max_val < 0 ? static_cast<VT>(R::max_val) : VT(0));
+
+        /** `n` rounded up to a whole number of granules. */
+        static constexpr std::size_t padded(std::size_t n) noexcept { return (n + granule - 1) / granule * granule; }
+
+        explicit buffer(std::pmr::memory_resource* r = std::pmr::get_default_resource()) noexcept : res{ r } {}
+
+        /** Buffer of `n` elements, all set to `pad`. */
+        explicit buffer(std::size_t n, std::pmr::memory_resource* r = std::pmr::get_default_resource()) : res{ r } {
+            reset(n);
+        }
+
+        buffer(const buffer&) = delete;
+        buffer& operator=(const buffer&) = delete;
+
+        buffer(buffer&& other) noexcept
+            : res{ other.res }, ptr{ std::exchange(other.ptr, nullptr) },
+              count{ std::exchange(other.count, 0) }, cap{ std::exchange(other.cap, 0) } {}
+
+        buffer& operator=(buffer&& other) noexcept {
+            if (this != &other) {
+                release();
+                res = other.res;
+                ptr = std::exchange(other.ptr, nullptr);
+                count = std::exchange(other.count, 0);
+                cap = std::exchange(other.cap, 0);
+            }
+            return *this;
+        }
+
+        ~buffer() { release(); }
+
+        /**
+         * Resize to `n` elements for reuse. Storage is only allocated when `n` exceeds the capacity, which then
+         * grows to the padded size of `n`. Elements up to the old size keep their values, others are left to be
+         * overwritten, and the padding behind element `n - 1` is set to `pad`.
+         */
+        void reset(std::size_t n) {
+            const std::size_t p = padded(n);
+            if (p > cap) {
+                S* q = static_cast<S*>(res->allocate(p * sizeof(S), alignment));
+                std::uninitialized_fill_n(q, p, static_cast<S>(pad));
+                std::copy_n(ptr, std::min(count, n), q);
+                release();
+                ptr = q;
+                cap = p;
+            } else {
+                std::fill(ptr + n, ptr + p, static_cast<S>(pad));
+            }
+            count = n;
+        }
+
+        /** Drop all elements, keeping the storage. */
+        void reset() noexcept { count = 0; }
+
+        constexpr std::size_t size() const noexcept { return count; }
+        constexpr bool empty() const noexcept { return count == 0; }
+
+        /** `size()` rounded up to whole granules, every element up to here is a valid `S`. */
+        constexpr std::size_t padded_size() const noexcept { return padded(count); }
+
+        /** Number of elements the storage holds. */
+        constexpr std::size_t capacity() const noexcept { return cap; }
+
+        /** The resource the storage comes from. */
+        std::pmr::memory_resource* resource() const noexcept { return res; }
+
+        S* data() noexcept { return ptr; }
+        const S* data() const noexcept { return ptr; }
+
+        S& operator[](std::size_t i) noexcept { return ptr[i]; }
+        const S& operator[](std::size_t i) const noexcept { return ptr[i]; }
+
+        iterator begin() noexcept { return ptr; }
+        iterator end() noexcept { return ptr + count; }
+        const_iterator begin() const noexcept { return ptr; }
+        const_iterator end() const noexcept { return ptr + count; }
+
+#ifdef __cpp_lib_span
+        /** The elements, without padding. */
+        std::span<S> span() noexcept { return { ptr, count }; }
+        std::span<const S> span() const noexcept { return { ptr, count }; }
+
+        /** The elements including the padding, for the bulk functions. */
+        std::span<S> padded_span() noexcept { return { ptr, padded_size() }; }
+        std::span<const S> padded_span() const noexcept { return { ptr, padded_size() }; }
+#endif
+
+    private:
+        void release() noexcept {
+            if (ptr != nullptr) {
+                res->deallocate(ptr, cap * sizeof(S), alignment);
+                ptr = nullptr;
+                cap = 0;
+            }
+        }
+
+        std::pmr::memory_resource* res;
+        S* ptr = nullptr;
+        std::size_t count = 0;
+        std::size_t cap = 0;
+    };
+} // namespace saturating
@@ -0,0 +1,659 @@
+/**@file
+ * @brief Saturating arithmetic over contiguous buffers.
+ *
+ * The bulk functions produce results bit identical to calling the matching `functions.hpp` template for
+ * each element, but are written to keep the vector units busy:
+ * - Same type 8 and 16 bit integers use the native saturating instructions (`paddusb`, `vqadd`, ...),
+ *   custom `MIN`/`MAX` limits add a vector `min`/`max` clamp.
+ * - Other integral combinations are computed in a wide type and clamped branch free, which compilers lower
+ *   to vector compares and blends.
+ * - Anything involving floating point values falls back to the scalar templates.
+ *
+ * `scale_buffer` converts between saturating ranges with compile time multipliers, see `scale.hpp`. `narrow` and
+ * `widen` convert values like `from()` does, narrowing with the saturating packs (`packssdw`, `packuswb`,
+ * `vqmovn`, ...).
+ *
+ * Division has no vector instructions, but dividing a whole buffer by one `saturating::divider` avoids the
+ * hardware divide altogether.
+ *
+ * `saturating::fixed` buffers add and subtract as their raw integers, Q15 multiplies use `pmulhrsw` / `vqrdmulh`.
+ *
+ * The instruction set is the best one enabled at compile time, or with `SATURATING_DISPATCH` defined (x86), the
+ * best one the running CPU supports, selected once per kernel on its first call (see `simd::dispatch`).
+ *
+ * Output buffers may alias an input buffer, the in place versions (`add_to`, `subtract_from`) do just that.
+ * With C++20 `std::span` overloads are provided as well, these process the size of the smallest argument.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<span>) && __cplusplus > 201703L
+#include <span>
+#endif
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+#include "./divider.hpp"
+#include "./scale.hpp"
+#include "./types.hpp"
+#include "./fixed.hpp"
+#include "./simd.hpp"
+
+// The kernels only pass registers wider than the compiler flags allow between always inlined functions, which
+// end up in the `target` of the `simd::dispatch` caller
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+namespace saturating {
+    namespace detail {
+        struct op_add {
+            template <typename ISA, typename T>
+            static constexpr auto vector = &ISA::template adds<T>;
+
+            template <typename TW>
+            static constexpr TW wide(const TW& a, const TW& b) noexcept { return a + b; }
+
+            template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+            static constexpr base_t<T> scalar(const A& a, const B& b) noexcept { return saturating::add<T, MIN, MAX>(a, b); }
+        };
+
+        struct op_subtract {
+            template <typename ISA, typename T>
+            static constexpr auto vector = &ISA::template subs<T>;
+
+            template <typename TW>
+            static constexpr TW wide(const TW& a, const TW& b) noexcept { return a - b; }
+
+            template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+            static constexpr base_t<T> scalar(const A& a, const B& b) noexcept { return saturating::subtract<T, MIN, MAX>(a, b); }
+        };
+
+        /** Do `A` and `B` combine into `T` using only integer arithmetic? */
+        template <typename T, typename A, typename B>
+        constexpr bool all_integral_v = is_integral_v<T> && is_integral_v<A> && is_integral_v<B>;
+
+        /**
+         * Process as many whole registers as fit in `n` using `ISA`.
+         * @return Number of elements processed
+         */
+        template <typename ISA, typename Op, typename T, limit_t<T> MIN, limit_t<T> MAX>
+        SATURATING_INLINE std::size_t
+        binary_native(const T* a, const T* b, T* out, std::size_t n) noexcept {
+            constexpr std::size_t lanes = simd::lanes_v<ISA, T>;
+            std::size_t i = 0;
+            if constexpr (MIN == std::numeric_limits<T>::lowest() && MAX == std::numeric_limits<T>::max()) {
+                for (; i + lanes <= n; i += lanes) {
+                    ISA::template store<T>(out + i, Op::template vector<ISA, T>(ISA::template load<T>(a + i),
+                                                                                ISA::template load<T>(b + i)));
+                }
+            } else {
+                // Saturating to the base type first and clamping after is equal to clamping the exact result
+                const auto lo = ISA::template set1<T>(MIN);
+                const auto hi = ISA::template set1<T>(MAX);
+                for (; i + lanes <= n; i += lanes) {
+                    const auto r = Op::template vector<ISA, T>(ISA::template load<T>(a + i), ISA::template load<T>(b + i));
+                    ISA::template store<T>(out + i, ISA::template max<T>(ISA::template min<T>(r, hi), lo));
+                }
+            }
+            return i;
+        }
+
+        /** `binary_native` as a `simd::dispatch` kernel set. */
+        template <typename Op, typename T, limit_t<T> MIN, limit_t<T> MAX>
+        struct binary_kernel {
+            template <typename ISA>
+            static SATURATING_INLINE std::size_t run(const T* a, const T* b, T* out, std::size_t n) noexcept {
+                return binary_native<ISA, Op, T, MIN, MAX>(a, b, out, n);
+            }
+        };
+
+        /** Exact integer loop: wide intermediate and a branch free clamp. */
+        template <typename Op, typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        inline void binary_wide(const A* a, const B* b, T* out, std::size_t n) noexcept {
+            using TW = signed_t<next_up_t<fit_all_t<T, A, B>>>;
+            constexpr TW lo = static_cast<TW>(MIN);
+            constexpr TW hi = static_cast<TW>(MAX);
+            for (std::size_t i = 0; i < n; ++i) {
+                const TW r = Op::wide(static_cast<TW>(a[i]), static_cast<TW>(b[i]));
+                out[i] = static_cast<T>(r < lo ? lo : (r > hi ? hi : r));
+            }
+        }
+
+        template <typename Op, typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        inline void binary(const A* a, const B* b, T* out, std::size_t n) noexcept {
+            std::size_t i = 0;
+            if constexpr (is_saturating_v<T> && std::is_same_v<A, T> && std::is_same_v<B, T> && simd::native_v<simd::native, base_t<T>>) {
+                // Saturating types have the layout of their base type and `MIN` ... `MAX` lies within their range
+                using V = base_t<T>;
+                binary<Op, V, MIN, MAX>(reinterpret_cast<const V*>(a), reinterpret_cast<const V*>(b), reinterpret_cast<V*>(out), n);
+                return;
+            } else if constexpr (std::is_same_v<A, T> && std::is_same_v<B, T> && simd::native_v<simd::native, T>) {
+                i = simd::dispatch<binary_kernel<Op, T, MIN, MAX>, std::size_t(const T*, const T*, T*, std::size_t)>::call(a, b, out, n);
+            } else if constexpr (all_integral_v<T, A, B>) {
+                binary_wide<Op, T, MIN, MAX>(a, b, out, n);
+                return;
+            }
+            for (std::size_t j = 0; j < n - i; ++j) {
+                out[i + j] = Op::template scalar<T, MIN, MAX>(a[i + j], b[i + j]);
+            }
+        }
+
+        /**
+         * Q15 products of as many whole registers as fit in `n` using `ISA`.
+         * @return Number of elements processed
+         */
+        template <typename ISA, limit_t<int16_t> MIN, limit_t<int16_t> MAX>
+        SATURATING_INLINE std::size_t
+        multiply_q15_native(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) noexcept {
+            constexpr std::size_t lanes = simd::lanes_v<ISA, int16_t>;
+            std::size_t i = 0;
+            if constexpr (MIN == std::numeric_limits<int16_t>::lowest() && MAX == std::numeric_limits<int16_t>::max()) {
+                for (; i + lanes <= n; i += lanes) {
+                    ISA::template store<int16_t>(out + i, ISA::template mulhrs<int16_t>(ISA::template load<int16_t>(a + i),
+                                                                                        ISA::template load<int16_t>(b + i)));
+                }
+            } else {
+                const auto lo = ISA::template set1<int16_t>(MIN);
+                const auto hi = ISA::template set1<int16_t>(MAX);
+                for (; i + lanes <= n; i += lanes) {
+                    const auto r = ISA::template mulhrs<int16_t>(ISA::template load<int16_t>(a + i), ISA::template load<int16_t>(b + i));
+                    ISA::template store<int16_t>(out + i, ISA::template max<int16_t>(ISA::template min<int16_t>(r, hi), lo));
+                }
+            }
+            return i;
+        }
+
+        /** `multiply_q15_native` as a `simd::dispatch` kernel set, instruction sets without `mulhrs` do nothing. */
+        template <limit_t<int16_t> MIN, limit_t<int16_t> MAX>
+        struct multiply_q15_kernel {
+            template <typename ISA>
+            static SATURATING_INLINE std::size_t run(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) noexcept {
+                if constexpr (simd::mulhrs_v<ISA>) {
+                    return multiply_q15_native<ISA, MIN, MAX>(a, b, out, n);
+                } else {
+                    return 0;
+                }
+            }
+        };
+
+        /**
+         * A register of `W` (`int16_t` or `int32_t`) from `S` into `r`, packing two registers where `S` is wider.
+         * Returning the register instead would change the ABI outside of the kernel's target.
+         */
+        template <typename ISA, typename W, typename S>
+        SATURATING_INLINE void load_packed(const S* in, typename ISA::template reg_type<W>::type& r) noexcept {
+            if constexpr (std::is_same_v<S, float>) {
+                if constexpr (sizeof(W) == sizeof(S)) {
+                    r = ISA::load_round(in);
+                } else {
+                    r = ISA::template pack<W>(ISA::load_round(in), ISA::load_round(in + simd::lanes_v<ISA, S>));
+                }
+            } else if constexpr (sizeof(W) == sizeof(S)) {
+                r = ISA::template load<S>(in);
+            } else {
+                r = ISA::template pack<W>(ISA::template load<S>(in), ISA::template load<S>(in + simd::lanes_v<ISA, S>));
+            }
+        }
+
+        /**
+         * Narrow as many whole registers as fit in `n` from `S` to `D` using `ISA`: saturating packs, followed by a
+         * vector clamp for custom limits.
+         * @return Number of elements processed
+         */
+        template <typename ISA, typename D, limit_t<D> MIN, limit_t<D> MAX, typename S>
+        SATURATING_INLINE std::size_t
+        narrow_native(const S* in, D* out, std::size_t n) noexcept {
+            using W = simd::pack_src_t<D>;
+            constexpr std::size_t lanes = simd::lanes_v<ISA, D>;
+            std::size_t i = 0;
+            const auto lo = ISA::template set1<D>(MIN);
+            const auto hi = ISA::template set1<D>(MAX);
+            typename ISA::template reg_type<W>::type x, y;
+            for (; i + lanes <= n; i += lanes) {
+                load_packed<ISA, W>(in + i, x);
+                load_packed<ISA, W>(in + i + lanes / 2, y);
+                auto r = ISA::template pack<D>(x, y);
+                if constexpr (MIN != std::numeric_limits<D>::lowest() || MAX != std::numeric_limits<D>::max()) {
+                    // The packs saturated to `D` already, which makes clamping after equal to clamping the exact value
+                    r = ISA::template max<D>(ISA::template min<D>(r, hi), lo);
+                }
+                ISA::template store<D>(out + i, r);
+            }
+            return i;
+        }
+
+        /** `narrow_native` as a `simd::dispatch` kernel set. */
+        template <typename D, limit_t<D> MIN, limit_t<D> MAX, typename S>
+        struct narrow_kernel {
+            template <typename ISA>
+            static SATURATING_INLINE std::size_t run(const S* in, D* out, std::size_t n) noexcept {
+                return narrow_native<ISA, D, MIN, MAX>(in, out, n);
+            }
+        };
+
+        /** `val` converted to `T`, like `type<T, MIN, MAX>::from()` does. */
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, rounding R, typename U>
+        constexpr T convert(const U& val) noexcept {
+            if constexpr (is_floating_point_v<U> && is_integral_v<T>) {
+                return static_cast<T>(saturate<stats::op::clamp>(MIN, saturating::round<T, R>(val), MAX));
+            } else if constexpr (is_integral_v<U> && is_integral_v<T>) {
+                // Compares only against the limits `U` can cross, none if it fits (widening)
+                return clamp_range<stats::op::clamp, T, MIN, MAX,
+                                   static_cast<widest_t>(std::numeric_limits<U>::lowest()),
+                                   static_cast<widest_t>(std::numeric_limits<U>::max())>(val);
+            } else {
+                return static_cast<T>(saturate<stats::op::clamp>(MIN, val, MAX));
+            }
+        }
+
+        /** Convert `n` values from `Src` to `Dst`, through the packs where available. */
+        template <typename Dst, rounding R, typename Src>
+        inline void convert_buffer(const Src* in, Dst* out, std::size_t n) noexcept {
+            using D = range_of<Dst>;
+            using S = range_of<Src>;
+            using DT = typename D::value_type;
+            using ST = typename S::value_type;
+            const ST* src = reinterpret_cast<const ST*>(in);
+            DT* dst = reinterpret_cast<DT*>(out);
+
+            std::size_t i = 0;
+            if constexpr (simd::pack_v<simd::native, DT, ST> && (!is_floating_point_v<ST> || R == rounding::even)) {
+                i = simd::dispatch<narrow_kernel<DT, D::min_val, D::max_val, ST>, std::size_t(const ST*, DT*, std::size_t)>::call(src, dst, n);
+            }
+            for (; i < n; ++i) {
+                dst[i] = convert<DT, D::min_val, D::max_val, R>(src[i]);
+            }
+        }
+
+        /** The raw integers of a `fixed` buffer, which has the same layout. */
+        template <typename T, unsigned F, limit_t<T> MIN, limit_t<T> MAX>
+        inline const T* raw_of(const fixed<T, F, MIN, MAX>* p) noexcept {
+            static_assert(sizeof(fixed<T, F, MIN, MAX>) == sizeof(T) && std::is_standard_layout_v<fixed<T, F, MIN, MAX>>);
+            return reinterpret_cast<const T*>(p);
+        }
+        template <typename T, unsigned F, limit_t<T> MIN, limit_t<T> MAX>
+        inline T* raw_of(fixed<T, F, MIN, MAX>* p) noexcept {
+            static_assert(sizeof(fixed<T, F, MIN, MAX>) == sizeof(T) && std::is_standard_layout_v<fixed<T, F, MIN, MAX>>);
+            return reinterpret_cast<T*>(p);
+        }
+    } // namespace detail
+
+#pragma GCC diagnostic pop
+
+    /**
+     * Add `a[i]` and `b[i]` for `n` elements, storing the results in `out`.
+     * @param  a   Left hand side values
+     * @param  b   Right hand side values
+     * @param  out Output buffer, may be equal to `a` or `b`
+     * @param  n   Number of elements
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A,
+              typename B>
+    inline void add(const A* a, const B* b, T* out, std::size_t n) noexcept {
+        detail::binary<detail::op_add, T, MIN, MAX>(a, b, out, n);
+    }
+
+    /**
+     * Subtract `b[i]` from `a[i]` for `n` elements, storing the results in `out`.
+     * @param  a   Left hand side values
+     * @param  b   Right hand side values
+     * @param  out Output buffer, may be equal to `a` or `b`
+     * @param  n   Number of elements
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A,
+              typename B>
+    inline void subtract(const A* a, const B* b, T* out, std::size_t n) noexcept {
+        detail::binary<detail::op_subtract, T, MIN, MAX>(a, b, out, n);
+    }
+
+    /**
+     * Multiply `a[i]` and `b[i]` for `n` elements, storing the results in `out`.
+     * @param  a   Left hand side values
+     * @param  b   Right hand side values
+     * @param  out Output buffer, may be equal to `a` or `b`
+     * @param  n   Number of elements
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A,
+              typename B>
+    inline void multiply(const A* a, const B* b, T* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = saturating::multiply<T, MIN, MAX>(a[i], b[i]);
+        }
+    }
+
+    /**
+     * Divide `a[i]` by `b[i]` for `n` elements, storing the results in `out`.
+     * @param  a   Dividends
+     * @param  b   Divisors
+     * @param  out Output buffer, may be equal to `a` or `b`
+     * @param  n   Number of elements
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A,
+              typename B>
+    inline void divide(const A* a, const B* b, T* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = saturating::divide<T, MIN, MAX>(a[i], b[i]);
+        }
+    }
+
+    /**
+     * Fused multiply-add `a[i] * b[i] + c[i]` for `n` elements, saturated once (see `saturating::fma`).
+     * @param  a   Left hand sides of the products
+     * @param  b   Right hand sides of the products
+     * @param  c   Addends
+     * @param  out Output buffer, may be equal to any input
+     * @param  n   Number of elements
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A,
+              typename B,
+              typename C>
+    inline void fma(const A* a, const B* b, const C* c, T* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = saturating::fma<T, MIN, MAX>(a[i], b[i], c[i]);
+        }
+    }
+
+    /**
+     * Interpolate `a[i] + t * (b[i] - a[i])` for `n` elements, saturated once (see `saturating::lerp`).
+     * @param  a   Values at 0
+     * @param  b   Values at 1
+     * @param  t   Floating point weight
+     * @param  out Output buffer, may be equal to `a` or `b`
+     * @param  n   Number of elements
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A,
+              typename B,
+              typename W>
+    inline std::enable_if_t<is_floating_point_v<W>> lerp(const A* a, const B* b, const W& t, T* out, std::size_t n) noexcept {
+        const W local = t;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = saturating::lerp<T, MIN, MAX>(a[i], b[i], local);
+        }
+    }
+
+    /**
+     * Absolute differences `|a[i] - b[i]|` for `n` elements (see `saturating::abs_diff`).
+     * @param  a   Left hand side values
+     * @param  b   Right hand side values
+     * @param  out Output buffer, may be equal to `a` or `b`
+     * @param  n   Number of elements
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A,
+              typename B>
+    inline void abs_diff(const A* a, const B* b, T* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = saturating::abs_diff<T, MIN, MAX>(a[i], b[i]);
+        }
+    }
+
+    /** Saturating sums of `n` fixed point values. */
+    template <typename T, unsigned F, limit_t<T> MIN, limit_t<T> MAX>
+    inline void add(const fixed<T, F, MIN, MAX>* a, const fixed<T, F, MIN, MAX>* b, fixed<T, F, MIN, MAX>* out, std::size_t n) noexcept {
+        detail::binary<detail::op_add, T, MIN, MAX>(detail::raw_of(a), detail::raw_of(b), detail::raw_of(out), n);
+    }
+
+    /** Saturating differences of `n` fixed point values. */
+    template <typename T, unsigned F, limit_t<T> MIN, limit_t<T> MAX>
+    inline void subtract(const fixed<T, F, MIN, MAX>* a, const fixed<T, F, MIN, MAX>* b, fixed<T, F, MIN, MAX>* out, std::size_t n) noexcept {
+        detail::binary<detail::op_subtract, T, MIN, MAX>(detail::raw_of(a), detail::raw_of(b), detail::raw_of(out), n);
+    }
+
+    /**
+     * Rounding products (`fixed::multiply_high`) of `n` fixed point values, Q15 uses the vector rounding
+     * multiply high instructions.
+     * @param  a   Left hand side values
+     * @param  b   Right hand side values
+     * @param  out Output buffer, may be equal to `a` or `b`
+     * @param  n   Number of elements
+     */
+    template <typename T, unsigned F, limit_t<T> MIN, limit_t<T> MAX>
+    inline void multiply(const fixed<T, F, MIN, MAX>* a, const fixed<T, F, MIN, MAX>* b, fixed<T, F, MIN, MAX>* out, std::size_t n) noexcept {
+        std::size_t i = 0;
+        if constexpr (std::is_same_v<T, int16_t> && F == 15) {
+            i = simd::dispatch<detail::multiply_q15_kernel<MIN, MAX>, std::size_t(const int16_t*, const int16_t*, int16_t*, std::size_t)>::call(
+                    detail::raw_of(a), detail::raw_of(b), detail::raw_of(out), n);
+        }
+        for (; i < n; ++i) {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    /**
+     * Divide `n` elements of `a` by the divisor of `d`, storing the results in `out`.
+     * @param  a   Dividends
+     * @param  d   Precomputed divisor
+     * @param  out Output buffer, may be equal to `a`
+     * @param  n   Number of elements
+     */
+    template <typename T, limit_t<T> MIN, limit_t<T> MAX>
+    inline void divide(const T* a, const divider<T, MIN, MAX>& d, T* out, std::size_t n) noexcept {
+        const auto local = d; // Keep the multiplier in registers, `out` could alias `d` as far as the compiler knows
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = local(a[i]);
+        }
+    }
+
+    /**
+     * Scale `n` values from the range of `Src` to the range of `Dst`, like `Dst::scale_from()` does. Both can be
+     * saturating types or plain arithmetic types (using their full range, or `-1 ... 1` for floating point). This is
+     * a plain loop over `saturating::scale`, which GCC only vectorizes at `-O3` (or with `-ftree-vectorize`), at
+     * `-O2` it stays scalar.
+     * @param  in  Input values
+     * @param  out Output buffer
+     * @param  n   Number of elements
+     */
+    template <typename Dst, typename Src>
+    inline void scale_buffer(const Src* in, Dst* out, std::size_t n) noexcept {
+        using S = range_of<Src>;
+        using D = range_of<Dst>;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<Dst>(saturating::scale<typename D::value_type, D::min_val, D::max_val,
+                                                        typename S::value_type, S::min_val, S::max_val>(
+                                          static_cast<const typename S::value_type&>(in[i])));
+        }
+    }
+
+    /**
+     * Convert `n` values to the narrower (or equally wide) `Dst`, like `Dst::from()` does: clamped to its limits
+     * and, for floating point values, rounded with `R` (see `rounding`). Signed 16 and 32 bit sources narrowed to
+     * 8 or 16 bit use the saturating packs (`packssdw`, `packuswb`, `vqmovn`, ...) with a vector clamp for custom
+     * limits. `float`s go through the conversion instructions when rounding to nearest even (`rounding::even`),
+     * the rounding mode they implement; other rounding modes are computed per element.
+     * @param  in  Input values, plain or saturating
+     * @param  out Output buffer, plain or saturating
+     * @param  n   Number of elements
+     */
+    template <typename Dst, rounding R = default_rounding, typename Src>
+    inline void narrow(const Src* in, Dst* out, std::size_t n) noexcept {
+        static_assert(sizeof(base_t<Dst>) <= sizeof(base_t<Src>) || is_floating_point_v<Src>, "Use `widen` to convert to wider types");
+        detail::convert_buffer<Dst, R>(in, out, n);
+    }
+
+    /**
+     * Convert `n` values to the wider (or equally wide) `Dst`, like `Dst::from()` does. Values are only compared
+     * against the limits of `Dst` the range of `Src` can cross, a plain sign or zero extension is left where
+     * `Dst` holds every `Src`, which compilers vectorize (`pmovsx`, `vmovl`).
+     * @param  in  Input values, plain or saturating
+     * @param  out Output buffer, plain or saturating
+     * @param  n   Number of elements
+     */
+    template <typename Dst, typename Src>
+    inline void widen(const Src* in, Dst* out, std::size_t n) noexcept {
+        static_assert(sizeof(base_t<Dst>) >= sizeof(base_t<Src>) && !(is_floating_point_v<Src> && is_integral_v<Dst>),
+                      "Use `narrow` to convert to narrower types");
+        detail::convert_buffer<Dst, default_rounding>(in, out, n);
+    }
+
+    /** In place version of the bulk `add`: `out[i] = add(out[i], val[i])`. */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename B>
+    inline void add_to(T* out, const B* val, std::size_t n) noexcept {
+        detail::binary<detail::op_add, T, MIN, MAX>(static_cast<const T*>(out), val, out, n);
+    }
+
+    /** In place version of the bulk `subtract`: `out[i] = subtract(out[i], val[i])`. */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename B>
+    inline void subtract_from(T* out, const B* val, std::size_t n) noexcept {
+        detail::binary<detail::op_subtract, T, MIN, MAX>(static_cast<const T*>(out), val, out, n);
+    }
+
+#ifdef __cpp_lib_span
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              std::size_t EO>
+    inline std::enable_if_t<!std::is_const_v<T>>
+    add(std::span<A, EA> a, std::span<B, EB> b, std::span<T, EO> out) noexcept {
+        add<T, MIN, MAX>(a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              std::size_t EO>
+    inline std::enable_if_t<!std::is_const_v<T>>
+    subtract(std::span<A, EA> a, std::span<B, EB> b, std::span<T, EO> out) noexcept {
+        subtract<T, MIN, MAX>(a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              std::size_t EO>
+    inline std::enable_if_t<!std::is_const_v<T>>
+    multiply(std::span<A, EA> a, std::span<B, EB> b, std::span<T, EO> out) noexcept {
+        multiply<T, MIN, MAX>(a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              std::size_t EO>
+    inline std::enable_if_t<!std::is_const_v<T>>
+    divide(std::span<A, EA> a, std::span<B, EB> b, std::span<T, EO> out) noexcept {
+        divide<T, MIN, MAX>(a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              typename C, std::size_t EC,
+              std::size_t EO>
+    inline std::enable_if_t<!std::is_const_v<T>>
+    fma(std::span<A, EA> a, std::span<B, EB> b, std::span<C, EC> c, std::span<T, EO> out) noexcept {
+        fma<T, MIN, MAX>(a.data(), b.data(), c.data(), out.data(), std::min({ a.size(), b.size(), c.size(), out.size() }));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              typename W,
+              std::size_t EO>
+    inline std::enable_if_t<!std::is_const_v<T> && is_floating_point_v<W>>
+    lerp(std::span<A, EA> a, std::span<B, EB> b, const W& t, std::span<T, EO> out) noexcept {
+        lerp<T, MIN, MAX>(a.data(), b.data(), t, out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              std::size_t EO>
+    inline std::enable_if_t<!std::is_const_v<T>>
+    abs_diff(std::span<A, EA> a, std::span<B, EB> b, std::span<T, EO> out) noexcept {
+        abs_diff<T, MIN, MAX>(a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T, limit_t<T> MIN, limit_t<T> MAX,
+              typename A, std::size_t EA,
+              std::size_t EO>
+    inline std::enable_if_t<!std::is_const_v<T> && std::is_same_v<std::remove_const_t<A>, T>>
+    divide(std::span<A, EA> a, const divider<T, MIN, MAX>& d, std::span<T, EO> out) noexcept {
+        divide(static_cast<const T*>(a.data()), d, out.data(), std::min(a.size(), out.size()));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              std::size_t EO,
+              typename B, std::size_t EB>
+    inline std::enable_if_t<!std::is_const_v<T>>
+    add_to(std::span<T, EO> out, std::span<B, EB> val) noexcept {
+        add_to<T, MIN, MAX>(out.data(), val.data(), std::min(out.size(), val.size()));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              std::size_t EO,
+              typename B, std::size_t EB>
+    inline std::enable_if_t<!std::is_const_v<T>>
+    subtract_from(std::span<T, EO> out, std::span<B, EB> val) noexcept {
+        subtract_from<T, MIN, MAX>(out.data(), val.data(), std::min(out.size(), val.size()));
+    }
+
+    template <typename Dst, typename Src, std::size_t ES, std::size_t ED>
+    inline std::enable_if_t<!std::is_const_v<Dst>>
+    scale_buffer(std::span<Src, ES> in, std::span<Dst, ED> out) noexcept {
+        scale_buffer<Dst>(static_cast<const std::remove_const_t<Src>*>(in.data()), out.data(), std::min(in.size(), out.size()));
+    }
+
+    template <typename Dst, rounding R = default_rounding, typename Src, std::size_t ES, std::size_t ED>
+    inline std::enable_if_t<!std::is_const_v<Dst>>
+    narrow(std::span<Src, ES> in, std::span<Dst, ED> out) noexcept {
+        narrow<Dst, R>(static_cast<const std::remove_const_t<Src>*>(in.data()), out.data(), std::min(in.size(), out.size()));
+    }
+
+    template <typename Dst, typename Src, std::size_t ES, std::size_t ED>
+    inline std::enable_if_t<!std::is_const_v<Dst>>
+    widen(std::span<Src, ES> in, std::span<Dst, ED> out) noexcept {
+        widen<Dst>(static_cast<const std::remove_const_t<Src>*>(in.data()), out.data(), std::min(in.size(), out.size()));
+    }
+#endif // __cpp_lib_span
+} // namespace saturating
@@ -0,0 +1,116 @@
+/**@file
+ * @brief Saturating division by a divisor that is reused for many dividends.
+ *
+ * `saturating::divider` precomputes a multiplier and shift for its divisor (libdivide style, see Granlund &
+ * Montgomery, "Division by invariant integers using multiplication"), turning each division into a multiply
+ * high, a shift and a few selects. Results are identical to `saturating::divide<T, MIN, MAX>(a, divisor)`.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+
+namespace saturating {
+    namespace detail {
+        /**
+         * Multiplier and shifts for truncating division of unsigned values by a fixed, non-zero `d`. Types
+         * without a wider type for the multiply high keep using the hardware divide.
+         */
+        template <typename TU>
+        struct invariant_divisor {
+            using TW = next_up_t<TU>;
+            static constexpr unsigned bits = sizeof(TU) * 8;
+
+            constexpr invariant_divisor(const TU& d) noexcept : divisor{d} {
+                if constexpr (sizeof(TW) > sizeof(TU)) {
+                    // l = ceil(log2(d)), m = floor(2^bits * (2^l - d) / d) + 1
+                    unsigned l = 0;
+                    while (l < bits && (TU(1) << l) < d) ++l;
+                    const TU pow = l == bits ? TU(0) : static_cast<TU>(TU(1) << l);
+                    multiplier = static_cast<TU>((static_cast<TW>(static_cast<TU>(pow - d)) << bits) / d + 1);
+                    shift1     = l > 0 ? 1 : 0;
+                    shift2     = l > 0 ? l - 1 : 0;
+                }
+            }
+
+            /** Truncated `n / divisor`. */
+            constexpr TU __attribute__((pure))
+            quotient(const TU& n) const noexcept {
+                if constexpr (sizeof(TW) > sizeof(TU)) {
+                    const TU t = static_cast<TU>((static_cast<TW>(multiplier) * n) >> bits);
+                    return static_cast<TU>(static_cast<TU>(t + static_cast<TU>(static_cast<TU>(n - t) >> shift1)) >> shift2);
+                } else {
+                    return static_cast<TU>(n / divisor);
+                }
+            }
+
+            /** `n / divisor`, rounded half up. */
+            constexpr TU __attribute__((pure))
+            rounded(const TU& n) const noexcept { return round_quotient(n, quotient(n), divisor); }
+
+            TU divisor      = 1;
+            TU multiplier   = 0;
+            unsigned shift1 = 0;
+            unsigned shift2 = 0;
+        };
+    } // namespace detail
+
+    /**
+     * Divide values of type `T` by a fixed divisor, saturating to `MIN` ... `MAX`.
+     * Floating point types simply forward to `saturating::divide`.
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>>
+    class divider {
+    public:
+        using value_type = base_t<T>;
+
+        /**
+         * Precompute the multiplier for `d`.
+         * @param  d Divisor, zero is allowed and saturates like `saturating::divide` does.
+         */
+        constexpr divider(const value_type& d) noexcept
+            : divisor{d},
+              inv{std::is_integral_v<value_type> && magnitude<TU>(d) != 0 ? magnitude<TU>(d) : TU(1)},
+              zero{std::is_integral_v<value_type> && magnitude<TU>(d) == 0},
+              negative{is_negative(d)}
+        {}
+
+        /** The divisor this instance was created for. */
+        constexpr const value_type& value() const noexcept { return divisor; }
+
+        /**
+         * Divide `a` by the divisor.
+         * @param  a Dividend
+         * @return   Saturated, rounded quotient
+         */
+        constexpr value_type SATURATING_PURE
+        operator()(const value_type& a) const noexcept {
+            if constexpr (std::is_integral_v<value_type>) {
+                const TU q = inv.rounded(magnitude<TU>(a));
+                return zero
+                           ? static_cast<value_type>(is_negative(a) ? MIN : MAX)
+                           : detail::from_magnitude<value_type, MIN, MAX>(q, is_negative(a) ^ negative);
+            } else {
+                return saturating::divide<value_type, MIN, MAX>(a, divisor);
+            }
+        }
+
+    private:
+        // Floating point types don't use `inv`, any unsigned type will do
+        using TU = std::conditional_t<std::is_integral_v<value_type>, unsigned_t<value_type>, unsigned>;
+
+        value_type divisor;
+        detail::invariant_divisor<TU> inv;
+        bool zero;
+        bool negative;
+    };
+} // namespace saturating
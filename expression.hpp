@@ -0,0 +1,199 @@
+/**@file
+ * @brief Opt-in lazy evaluation of chained saturating operations.
+ *
+ * The `saturating::type` operators saturate after every step. Wrapping an operand in `saturating::lazy()`
+ * instead builds a compile time expression tree out of `+`, `-` and `*`, which is evaluated exactly and
+ * saturated once, when converted to a saturating type or with `to<T>()`:
+ *
+ *     int_sat16_t y = saturating::lazy(a) + saturating::lazy(b) * c - d;
+ *
+ * The range of every node follows from the limits of the operands, the whole tree is evaluated in the
+ * narrowest of `int32_t`, `int64_t` and `widest_t` holding the range of the result (modulo its width, which is
+ * exact for these operations once the result fits). Only if some intermediate range doesn't fit `widest_t` each
+ * step saturates at the limits of `widest_t` instead. The clamp itself is left out when the range of the result
+ * fits the target.
+ *
+ * Note that this changes the result whenever an intermediate step would have saturated (`(200 + 100) - 100` is
+ * 200 for `uint8_t` operands, not 155). Only integral operands up to 64 bit are supported.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+#include "./stats.hpp"
+
+namespace saturating {
+    namespace expr {
+        template <typename D>
+        struct expression;
+
+        template <typename T>
+        constexpr bool is_expression_v = std::is_base_of_v<expression<T>, T>;
+    } // namespace expr
+
+    namespace detail {
+        /** `O` on `a` and `b`, saturating at the limits of `widest_t`. */
+        template <range_op O>
+        constexpr widest_t wide_step(const widest_t& a, const widest_t& b) noexcept {
+            widest_t r = 0;
+            if constexpr (O == range_op::add) {
+                if (__builtin_add_overflow(a, b, &r)) return a < 0 ? std::numeric_limits<widest_t>::lowest() : std::numeric_limits<widest_t>::max();
+            } else if constexpr (O == range_op::subtract) {
+                if (__builtin_sub_overflow(a, b, &r)) return a < 0 ? std::numeric_limits<widest_t>::lowest() : std::numeric_limits<widest_t>::max();
+            } else {
+                if (__builtin_mul_overflow(a, b, &r)) return (a < 0) != (b < 0) ? std::numeric_limits<widest_t>::lowest() : std::numeric_limits<widest_t>::max();
+            }
+            return r;
+        }
+    } // namespace detail
+
+    namespace expr {
+        /** Common interface of all expression nodes `D`. */
+        template <typename D>
+        struct expression {
+            /**
+             * Evaluate the expression, saturating once to the limits of `T` (plain or saturating).
+             * @return Result as `T`
+             */
+            template <typename T>
+            constexpr base_t<T> to() const noexcept {
+                using R = range_of<T>;
+                using V = typename R::value_type;
+                static_assert(is_integral_v<V>, "Lazy expressions only produce integral results");
+                const auto& self = static_cast<const D&>(*this);
+                if constexpr (D::exact) {
+                    using W = detail::evaluation_t<D::lo, D::hi>;
+                    const W v = static_cast<W>(self.template modular<detail::modular_t<W>>());
+                    if constexpr (D::lo >= static_cast<detail::widest_t>(R::min_val) && D::hi <= static_cast<detail::widest_t>(R::max_val)) {
+                        return base_t<T>(static_cast<V>(v));
+                    } else {
+                        // Clamp in `W` if the limits fit, the comparisons stay as narrow as the arithmetic
+                        using C = std::conditional_t<static_cast<detail::widest_t>(R::min_val) >= static_cast<detail::widest_t>(std::numeric_limits<W>::lowest()) &&
+                                                     static_cast<detail::widest_t>(R::max_val) <= static_cast<detail::widest_t>(std::numeric_limits<W>::max()),
+                                                     W,
+                                                     detail::widest_t>;
+                        return base_t<T>(static_cast<V>(clamped<C>(static_cast<C>(R::min_val), static_cast<C>(v), static_cast<C>(R::max_val))));
+                    }
+                } else {
+                    return base_t<T>(static_cast<V>(clamped<detail::widest_t>(static_cast<detail::widest_t>(R::min_val),
+                                                                                     self.saturated(),
+                                                                                     static_cast<detail::widest_t>(R::max_val))));
+                }
+            }
+
+            /** Evaluate the expression when assigned to a saturating type. */
+            template <typename T, auto MIN, auto MAX, typename P>
+            constexpr operator type<T, MIN, MAX, P>() const noexcept {
+                return to<type<T, MIN, MAX, P>>();
+            }
+
+        private:
+            /** Clamp counting as `stats::op::clamp`, compared directly as `widest_t` isn't integral to all traits. */
+            template <typename C>
+            static constexpr C clamped(const C& lo, const C& v, const C& hi) noexcept {
+                const bool high = hi < v;
+                return detail::overflowed<stats::op::clamp>(high || v < lo, high) ? (high ? hi : lo) : v;
+            }
+        };
+
+        /** A plain or saturating integral operand, contributing its limits as range. */
+        template <typename V>
+        struct leaf : expression<leaf<V>> {
+            using value_type = typename range_of<V>::value_type;
+            static_assert(std::is_integral_v<value_type> && sizeof(value_type) < sizeof(detail::widest_t),
+                          "Lazy expressions only take integral operands narrower than the widest integer");
+
+            static constexpr bool exact = true;
+            static constexpr detail::widest_t lo = range_of<V>::min_val;
+            static constexpr detail::widest_t hi = range_of<V>::max_val;
+
+            value_type value;
+
+            constexpr explicit leaf(const V v) noexcept : value{ detail::value_of(v) } {}
+
+            template <typename M>
+            constexpr M modular() const noexcept { return static_cast<M>(value); }
+
+            constexpr detail::widest_t saturated() const noexcept { return value; }
+        };
+
+        /** Operation `O` on sub expressions `L` and `R`. */
+        template <detail::range_op O, typename L, typename R>
+        struct node : expression<node<O, L, R>> {
+            static constexpr detail::value_range range = detail::result_range<O>(L::lo, L::hi, R::lo, R::hi);
+            static constexpr bool exact = L::exact && R::exact && range.exact;
+            static constexpr detail::widest_t lo = range.lo;
+            static constexpr detail::widest_t hi = range.hi;
+
+            L l;
+            R r;
+
+            constexpr node(const L& l, const R& r) noexcept : l{ l }, r{ r } {}
+
+            /** Result modulo the width of unsigned `M`. */
+            template <typename M>
+            constexpr M modular() const noexcept {
+                const M a = l.template modular<M>();
+                const M b = r.template modular<M>();
+                if constexpr (O == detail::range_op::add) {
+                    return static_cast<M>(a + b);
+                } else if constexpr (O == detail::range_op::subtract) {
+                    return static_cast<M>(a - b);
+                } else {
+                    return static_cast<M>(a * b);
+                }
+            }
+
+            /** Result saturating every step at the limits of `widest_t`. */
+            constexpr detail::widest_t saturated() const noexcept {
+                return detail::wide_step<O>(l.saturated(), r.saturated());
+            }
+        };
+
+        /** `v` itself for expressions, a leaf otherwise. */
+        template <typename V>
+        constexpr auto as_expression(const V& v) noexcept {
+            if constexpr (is_expression_v<V>) {
+                return v;
+            } else {
+                return leaf<std::remove_cv_t<V>>{ v };
+            }
+        }
+
+        template <typename L, typename R>
+        using enable_expression_t = std::enable_if_t<is_expression_v<L> || is_expression_v<R>, int>;
+
+        template <detail::range_op O, typename L, typename R>
+        using node_t = node<O, decltype(as_expression(std::declval<const L&>())), decltype(as_expression(std::declval<const R&>()))>;
+
+        template <typename L, typename R, enable_expression_t<L, R> = 0>
+        constexpr auto operator+(const L& l, const R& r) noexcept {
+            return node_t<detail::range_op::add, L, R>{ as_expression(l), as_expression(r) };
+        }
+        template <typename L, typename R, enable_expression_t<L, R> = 0>
+        constexpr auto operator-(const L& l, const R& r) noexcept {
+            return node_t<detail::range_op::subtract, L, R>{ as_expression(l), as_expression(r) };
+        }
+        template <typename L, typename R, enable_expression_t<L, R> = 0>
+        constexpr auto operator*(const L& l, const R& r) noexcept {
+            return node_t<detail::range_op::multiply, L, R>{ as_expression(l), as_expression(r) };
+        }
+    } // namespace expr
+
+    /**
+     * Start a lazy expression from a plain or saturating integral value.
+     * @param  v Operand
+     * @return   Expression leaf, combining with other values through `+`, `-` and `*`
+     */
+    template <typename V>
+    constexpr expr::leaf<std::remove_cv_t<V>> lazy(const V& v) noexcept {
+        return expr::leaf<std::remove_cv_t<V>>{ v };
+    }
+} // namespace saturating
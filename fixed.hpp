@@ -0,0 +1,174 @@
+/**@file
+ * @brief Saturating fixed point (Q format) numbers.
+ *
+ * `saturating::fixed<T, F>` stores a value `v` as the integer `v * 2^F` in a `saturating::type<T, MIN, MAX>`, so
+ * `fixed<int16_t, 15>` is Q15 (-1 ... 1 - 2^-15) and `fixed<int32_t, 31>` is Q31. Addition and subtraction are
+ * the saturating integer operations of the raw type. Multiplication rounds the double width product half up,
+ * like `pmulhrsw` / `vqrdmulh` do, and `multiply_add` accumulates with a single rounding step. All results
+ * saturate to `MIN` ... `MAX` (raw integer limits).
+ *
+ * The bulk `multiply` in `bulk.hpp` uses the rounding multiply high instructions for Q15.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cmath>
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+#include "./types.hpp"
+#include "./stats.hpp"
+
+namespace saturating {
+    /** Fixed point number with `F` fractional bits, stored as (raw) integral `T` saturating to `MIN` ... `MAX`. */
+    template <typename T,
+              unsigned F,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>>
+    class fixed {
+        static_assert(is_integral_v<T> && sizeof(T) <= 4, "Fixed point values are stored in 8 to 32 bit integers");
+        static_assert(F <= std::numeric_limits<T>::digits, "More fractional bits than value bits");
+
+    public:
+        using value_type = base_t<T>;
+        using raw_type   = type<value_type, MIN, MAX>;
+
+        static constexpr unsigned frac_bits = F;
+        static constexpr value_type min_val = MIN;
+        static constexpr value_type max_val = MAX;
+
+        /** Create a new zero-initialized fixed point number. */
+        constexpr fixed() noexcept : value{} {}
+
+        /**
+         * Create a fixed point number from its raw integer representation.
+         * @param  raw Value times `2^F`, clamped to `MIN` ... `MAX`
+         * @return     New fixed point number
+         */
+        template <typename U>
+        static constexpr std::enable_if_t<is_integral_v<U>, fixed>
+        from_raw(const U& raw) noexcept {
+            fixed out;
+            out.value = raw_type::from(raw);
+            return out;
+        }
+
+        /**
+         * Convert a floating point value, rounding to nearest. Out of range values (and infinities) saturate,
+         * NaN maps to zero.
+         * @param  val Value
+         * @return     New fixed point number
+         */
+        template <typename U>
+        static std::enable_if_t<is_floating_point_v<U>, fixed>
+        from(const U& val) noexcept {
+            const U s = std::ldexp(val, static_cast<int>(F));
+            // Clamp in the floating point domain first, the scaled value may not fit any integer
+            const bool low  = s < static_cast<U>(MIN);
+            const bool high = s > static_cast<U>(MAX);
+            fixed out;
+            if (detail::overflowed<stats::op::clamp>(low || high, high)) {
+                out.value = high ? MAX : MIN;
+            } else if (s == s) {
+                out.value = static_cast<value_type>(saturating::round<value_type>(s));
+            }
+            return out;
+        }
+
+        /** The value as floating point type `U`. */
+        template <typename U = double>
+        constexpr std::enable_if_t<is_floating_point_v<U>, U>
+        to() const noexcept {
+            return static_cast<U>(static_cast<value_type>(value)) / static_cast<U>(std::uint64_t{ 1 } << F);
+        }
+
+        /** The raw saturating integer, the value times `2^F`. */
+        constexpr const raw_type& raw() const noexcept { return value; }
+
+        /** Saturating sum. */
+        constexpr fixed SATURATING_CONST operator+(const fixed& other) const noexcept { return from_raw_unchecked(value + other.value); }
+        /** Saturating difference. */
+        constexpr fixed SATURATING_CONST operator-(const fixed& other) const noexcept { return from_raw_unchecked(value - other.value); }
+        /** Saturating product, rounded half up. */
+        constexpr fixed SATURATING_CONST operator*(const fixed& other) const noexcept { return multiply_high(*this, other); }
+        /** Saturating negation. */
+        constexpr fixed SATURATING_CONST operator-() const noexcept { return from_raw_unchecked(raw_type::subtract(value_type{ 0 }, value)); }
+
+        constexpr fixed& operator+=(const fixed& other) noexcept { return *this = *this + other; }
+        constexpr fixed& operator-=(const fixed& other) noexcept { return *this = *this - other; }
+        constexpr fixed& operator*=(const fixed& other) noexcept { return *this = *this * other; }
+
+        constexpr bool operator==(const fixed& other) const noexcept { return static_cast<value_type>(value) == static_cast<value_type>(other.value); }
+        constexpr bool operator!=(const fixed& other) const noexcept { return !(*this == other); }
+        constexpr bool operator< (const fixed& other) const noexcept { return static_cast<value_type>(value) <  static_cast<value_type>(other.value); }
+        constexpr bool operator> (const fixed& other) const noexcept { return other < *this; }
+        constexpr bool operator<=(const fixed& other) const noexcept { return !(other < *this); }
+        constexpr bool operator>=(const fixed& other) const noexcept { return !(*this < other); }
+
+        /**
+         * Rounding multiply high: `(a * b + 2^(F - 1)) >> F`, computed exactly and saturated once.
+         * @param  a Left hand side
+         * @param  b Right hand side
+         * @return   Product
+         */
+        static constexpr fixed SATURATING_CONST
+        multiply_high(const fixed& a, const fixed& b) noexcept {
+            using TW = next_up_t<value_type>;
+            const TW p = static_cast<TW>(static_cast<value_type>(a.value)) * static_cast<TW>(static_cast<value_type>(b.value));
+            return from_raw_unchecked(static_cast<value_type>(detail::saturate<stats::op::multiply>(static_cast<TW>(MIN), rounded_shift<TW>(p), static_cast<TW>(MAX))));
+        }
+
+        /**
+         * Multiply accumulate: `acc + a * b`, with the product kept at full precision until the single rounding.
+         * @param  acc Accumulator
+         * @param  a   Left hand side of the product
+         * @param  b   Right hand side of the product
+         * @return     Sum
+         */
+        static constexpr fixed SATURATING_CONST
+        multiply_add(const fixed& acc, const fixed& a, const fixed& b) noexcept {
+            // `acc << F` plus the product needs one bit more than double width
+            using TW = signed_t<next_up_t<next_up_t<value_type>>>;
+            const TW p = static_cast<TW>(static_cast<value_type>(a.value)) * static_cast<TW>(static_cast<value_type>(b.value));
+            const TW s = static_cast<TW>(static_cast<TW>(static_cast<value_type>(acc.value)) * (TW{ 1 } << F)) + p;
+            return from_raw_unchecked(static_cast<value_type>(detail::saturate<stats::op::add>(static_cast<TW>(MIN), rounded_shift<TW>(s), static_cast<TW>(MAX))));
+        }
+
+    private:
+        /** `raw` already is in range (or saturated). */
+        static constexpr fixed from_raw_unchecked(const value_type& raw) noexcept {
+            fixed out;
+            out.value = raw_type{ raw };
+            return out;
+        }
+
+        /** `v / 2^F` rounded half up, an arithmetic shift for negative values. */
+        template <typename TW>
+        static constexpr TW rounded_shift(const TW& v) noexcept {
+            if constexpr (F == 0) {
+                return v;
+            } else {
+                return static_cast<TW>(v + (TW{ 1 } << (F - 1))) >> F;
+            }
+        }
+
+        raw_type value;
+    };
+
+    /** Saturating `acc + a * b`, see `fixed::multiply_add`. */
+    template <typename T, unsigned F, limit_t<T> MIN, limit_t<T> MAX>
+    constexpr fixed<T, F, MIN, MAX> SATURATING_CONST
+    multiply_add(const fixed<T, F, MIN, MAX>& acc, const fixed<T, F, MIN, MAX>& a, const fixed<T, F, MIN, MAX>& b) noexcept {
+        return fixed<T, F, MIN, MAX>::multiply_add(acc, a, b);
+    }
+
+    /** Q15: `-1 ... 1 - 2^-15` in 16 bits. */
+    using q15_t = fixed<int16_t, 15>;
+    /** Q31: `-1 ... 1 - 2^-31` in 32 bits. */
+    using q31_t = fixed<int32_t, 31>;
+} // namespace saturating
@@ -11,8 +11,13 @@
  * Saturating types and functions
  */
 namespace saturating {
+    namespace policy {
+        struct saturate;
+    }
+
     template <typename T,
               std::enable_if_t<!std::is_const_v<T>,    std::conditional_t<std::is_integral_v<T>, std::decay_t<T>, int>> MIN,
-              std::enable_if_t<!std::is_volatile_v<T>, std::conditional_t<std::is_integral_v<T>, std::decay_t<T>, int>> MAX>
+              std::enable_if_t<!std::is_volatile_v<T>, std::conditional_t<std::is_integral_v<T>, std::decay_t<T>, int>> MAX,
+              typename P>
     class type;
 }
@@ -8,8 +8,160 @@
 #include <cmath>
 
 #include "./utilities.hpp"
+#include "./stats.hpp"
 
 namespace saturating {
+    namespace detail {
+        enum class range_op { add, subtract, multiply };
+
+        /** Exact range of a result, `exact` is false if it doesn't fit `widest_t`. */
+        struct value_range {
+            bool exact;
+            widest_t lo;
+            widest_t hi;
+        };
+
+        /** Unsigned type of the same width as `W`, for exact modular evaluation. */
+        template <typename W>
+        struct modular { using type = unsigned_t<W>; };
+#ifdef __SIZEOF_INT128__
+        template <>
+        struct modular<__int128> { using type = unsigned __int128; };
+#endif
+        template <typename W>
+        using modular_t = typename modular<W>::type;
+
+        /** Narrowest evaluation type holding all of `lo` ... `hi`. */
+        template <widest_t lo, widest_t hi>
+        using evaluation_t = std::conditional_t<lo >= std::numeric_limits<std::int32_t>::lowest() && hi <= std::numeric_limits<std::int32_t>::max(),
+                                                std::int32_t,
+                                                std::conditional_t<lo >= std::numeric_limits<std::int64_t>::lowest() && hi <= std::numeric_limits<std::int64_t>::max(),
+                                                                   std::int64_t,
+                                                                   widest_t>>;
+
+        /** Range of `O` on any values in `alo` ... `ahi` and `blo` ... `bhi`. */
+        template <range_op O>
+        constexpr value_range result_range(widest_t alo, widest_t ahi, widest_t blo, widest_t bhi) noexcept {
+            const widest_t a[2] { alo, ahi };
+            const widest_t b[2] { blo, bhi };
+            value_range out { true, std::numeric_limits<widest_t>::max(), std::numeric_limits<widest_t>::lowest() };
+            // The extremes of all three operations are found in the corners of the operand ranges
+            for (const auto& x : a) {
+                for (const auto& y : b) {
+                    widest_t r = 0;
+                    const bool overflow = O == range_op::add      ? __builtin_add_overflow(x, y, &r)
+                                        : O == range_op::subtract ? __builtin_sub_overflow(x, y, &r)
+                                        :                           __builtin_mul_overflow(x, y, &r);
+                    if (overflow) return { false, std::numeric_limits<widest_t>::lowest(), std::numeric_limits<widest_t>::max() };
+                    out.lo = r < out.lo ? r : out.lo;
+                    out.hi = r > out.hi ? r : out.hi;
+                }
+            }
+            return out;
+        }
+
+        /**
+         * Can the result of `O` on any value in the ranges of `UA` and `UB` (their limits for saturating types)
+         * fall outside `MIN` ... `MAX`? Worked out exactly in `widest_t`, anything that doesn't fit in there
+         * (or involves floating point types) is assumed to possibly overflow.
+         */
+        template <range_op O, typename T, limit_t<T> MIN, limit_t<T> MAX, typename UA, typename UB>
+        constexpr bool provably_fits() noexcept {
+            using A = typename range_of<UA>::value_type;
+            using B = typename range_of<UB>::value_type;
+            if constexpr (is_integral_v<base_t<T>> && is_integral_v<A> && is_integral_v<B> &&
+                          sizeof(base_t<T>) < sizeof(widest_t) && sizeof(A) < sizeof(widest_t) && sizeof(B) < sizeof(widest_t)) {
+                constexpr auto r = result_range<O>(range_of<UA>::min_val, range_of<UA>::max_val,
+                                                   range_of<UB>::min_val, range_of<UB>::max_val);
+                return r.exact && r.lo >= static_cast<widest_t>(MIN) && r.hi <= static_cast<widest_t>(MAX);
+            } else {
+                return false;
+            }
+        }
+
+        /**
+         * Plain `O` on `a` and `b`, only valid when `provably_fits`. Computed modulo the unsigned width of `T`
+         * (at least `unsigned`, avoiding promotion to `int`), which is exact once the result fits.
+         */
+        template <range_op O, typename T, typename UA, typename UB>
+        constexpr base_t<T> __attribute__((pure))
+        unclamped(const UA& a, const UB& b) noexcept {
+            using TM = std::conditional_t<(sizeof(base_t<T>) < sizeof(unsigned)), unsigned, unsigned_t<T>>;
+            const TM x = static_cast<TM>(value_of(a));
+            const TM y = static_cast<TM>(value_of(b));
+            if constexpr (O == range_op::add) {
+                return static_cast<base_t<T>>(static_cast<TM>(x + y));
+            } else if constexpr (O == range_op::subtract) {
+                return static_cast<base_t<T>>(static_cast<TM>(x - y));
+            } else {
+                return static_cast<base_t<T>>(static_cast<TM>(x * y));
+            }
+        }
+
+        /** Does all of `r` fit `MIN` ... `MAX`? */
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX>
+        constexpr bool range_fits(const value_range& r) noexcept {
+            return r.exact && r.lo >= static_cast<widest_t>(MIN) && r.hi <= static_cast<widest_t>(MAX);
+        }
+
+        /** `W` if `MIN` and `MAX` fit it, `widest_t` otherwise: the type to clamp a `W` result in. */
+        template <typename W, typename T, limit_t<T> MIN, limit_t<T> MAX>
+        using clamp_t = std::conditional_t<static_cast<widest_t>(MIN) >= static_cast<widest_t>(std::numeric_limits<W>::lowest()) &&
+                                           static_cast<widest_t>(MAX) <= static_cast<widest_t>(std::numeric_limits<W>::max()),
+                                           W, widest_t>;
+
+        /**
+         * `v`, known to lie in `lo` ... `hi`, saturated to `MIN` ... `MAX`. Only the limits that range reaches
+         * beyond are compared against, no clamp at all is left if it fits.
+         */
+        template <stats::op O, typename T, limit_t<T> MIN, limit_t<T> MAX, widest_t lo, widest_t hi, typename W>
+        constexpr base_t<T> clamp_range(const W& v) noexcept {
+            if constexpr (range_fits<T, MIN, MAX>(value_range{ true, lo, hi })) {
+                return static_cast<base_t<T>>(v);
+            } else {
+                using C = clamp_t<W, T, MIN, MAX>;
+                // A limit of `C` itself is never crossed, the compiler drops that compare
+                constexpr C low  = lo < static_cast<widest_t>(MIN) ? static_cast<C>(MIN) : std::numeric_limits<C>::lowest();
+                constexpr C high = hi > static_cast<widest_t>(MAX) ? static_cast<C>(MAX) : std::numeric_limits<C>::max();
+                return static_cast<base_t<T>>(saturate<O>(low, static_cast<C>(v), high));
+            }
+        }
+
+        /** Are the values of all `U` (saturating or plain) integral and narrower than `widest_t`? */
+        template <typename... U>
+        constexpr bool narrow_integral_v = ((is_integral_v<typename range_of<U>::value_type> &&
+                                             sizeof(typename range_of<U>::value_type) < sizeof(widest_t)) && ...);
+
+        /**
+         * Do the limits of `UA` and `UB` tell more than their base types? Then `ranged` evaluates `O` for them, full
+         * range operands are better served by the native width paths.
+         */
+        template <typename T, typename UA, typename UB>
+        constexpr bool use_ranges_v = (is_saturating_v<UA> || is_saturating_v<UB>) && narrow_integral_v<T, UA, UB> &&
+                                      !(traits<UA>::full_range && traits<UB>::full_range);
+
+        /**
+         * `O` on `a` and `b` (see `use_ranges_v`), evaluated exactly in the narrowest type holding every result
+         * their limits allow, and clamped only at the limits of `MIN` ... `MAX` that range reaches beyond.
+         */
+        template <range_op O, typename T, limit_t<T> MIN, limit_t<T> MAX, typename UA, typename UB>
+        constexpr base_t<T> __attribute__((pure))
+        ranged(const UA& a, const UB& b) noexcept {
+            constexpr auto r = result_range<O>(range_of<UA>::min_val, range_of<UA>::max_val,
+                                               range_of<UB>::min_val, range_of<UB>::max_val);
+            using W = evaluation_t<r.lo, r.hi>;
+            const W x = static_cast<W>(value_of(a));
+            const W y = static_cast<W>(value_of(b));
+            if constexpr (O == range_op::add) {
+                return clamp_range<stats::op::add, T, MIN, MAX, r.lo, r.hi>(static_cast<W>(x + y));
+            } else if constexpr (O == range_op::subtract) {
+                return clamp_range<stats::op::subtract, T, MIN, MAX, r.lo, r.hi>(static_cast<W>(x - y));
+            } else {
+                return clamp_range<stats::op::multiply, T, MIN, MAX, r.lo, r.hi>(static_cast<W>(x * y));
+            }
+        }
+    } // namespace detail
+
     /**
      * Add a and b and store result in a new saturating type.
      * @param  a Left hand side of operator
@@ -18,122 +170,84 @@ namespace saturating {
      */
     template <typename T,
               // Yes, this looks duplicative, but not using an intermediate typename enables easier custom limits
-              std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>
-                    MIN = std::is_floating_point_v<T>
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
                                 ? -1
-                                : (std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>)std::numeric_limits<T>::lowest(),
-              std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>
-                    MAX = std::is_floating_point_v<T>
+                                : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
                                 ? 1
-                                : (std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>)std::numeric_limits<T>::max(),
+                                : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
               typename UA,
               typename UB>
-    constexpr std::enable_if_t<std::is_arithmetic_v<UA> && std::is_arithmetic_v<UB>, std::decay_t<T>>
-    __attribute__((const))
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>, base_t<T>>
+    SATURATING_CONST
     add(const UA& a, const UB& b) noexcept {
-        if constexpr (std::is_floating_point_v<T>) {
-            if constexpr (std::is_floating_point_v<UA> || std::is_floating_point_v<UB>) {
-                return static_cast<std::decay_t<T>>(clamp(MIN, a + b, MAX));
+        if constexpr (detail::provably_fits<detail::range_op::add, T, MIN, MAX, UA, UB>()) {
+            return detail::unclamped<detail::range_op::add, T>(a, b);
+        } else if constexpr (detail::use_ranges_v<T, UA, UB>) {
+            return detail::ranged<detail::range_op::add, T, MIN, MAX>(a, b);
+        } else if constexpr (is_saturating_v<UA> || is_saturating_v<UB>) {
+            return add<T, MIN, MAX>(detail::value_of(a), detail::value_of(b));
+        } else if constexpr (is_floating_point_v<T>) {
+            if constexpr (is_floating_point_v<UA> || is_floating_point_v<UB>) {
+                return static_cast<base_t<T>>(detail::saturate<stats::op::add>(MIN, a + b, MAX));
             } else {
                 using TC = fit_all_t<UA, UB>;
                 if constexpr (MIN == std::numeric_limits<TC>::lowest() && MAX == std::numeric_limits<TC>::max()) {
                     TC temp = 0;
-                    if constexpr (std::is_unsigned_v<TC>) {
+                    if constexpr (is_unsigned_v<TC>) {
                         return {
-                            __builtin_add_overflow(static_cast<TC>(a), static_cast<TC>(b), &temp)
+                            detail::overflowed<stats::op::add>(__builtin_add_overflow(static_cast<TC>(a), static_cast<TC>(b), &temp), true)
                                 ? MAX
                                 : temp
                         };
                     } else {
                         return {
-                            __builtin_add_overflow(static_cast<TC>(a), static_cast<TC>(b), &temp)
-                                ? (static_cast<TC>(b) > static_cast<TC>(a) ? MIN : MAX)
+                            detail::overflowed<stats::op::add>(__builtin_add_overflow(static_cast<TC>(a), static_cast<TC>(b), &temp), !(static_cast<TC>(a) < 0))
+                                ? (static_cast<TC>(a) < 0 ? MIN : MAX)
                                 : temp
                         };
                     }
                 } else {
                     using TO = next_up_t<TC>;
-                    return static_cast<std::decay_t<T>>(clamp(MIN, static_cast<TO>(a) + static_cast<TO>(b), MAX));
+                    return static_cast<base_t<T>>(detail::saturate<stats::op::add>(MIN, static_cast<TO>(a) + static_cast<TO>(b), MAX));
                 }
             }
         } else {
-            if constexpr (std::is_floating_point_v<UA>) {
-                if constexpr (std::is_floating_point_v<UB>) {
-                    return static_cast<std::decay_t<T>>(clamp(MIN, round<T>(a + b), MAX));
+            if constexpr (is_floating_point_v<UA>) {
+                if constexpr (is_floating_point_v<UB>) {
+                    return static_cast<base_t<T>>(detail::saturate<stats::op::add>(MIN, round<T>(a + b), MAX));
                 } else {
                     const auto temp = round<T>(a);
                     using TO = next_up_t<fit_all_t<UB, decltype(temp)>>;
-                    return static_cast<std::decay_t<T>>(clamp(MIN, static_cast<TO>(temp) + static_cast<TO>(b), MAX));
+                    return static_cast<base_t<T>>(detail::saturate<stats::op::add>(MIN, static_cast<TO>(temp) + static_cast<TO>(b), MAX));
                 }
             } else {
-                if constexpr (std::is_floating_point_v<UB>) {
+                if constexpr (is_floating_point_v<UB>) {
                     const auto temp = round<T>(b);
                     using TO = next_up_t<fit_all_t<UA, decltype(temp)>>;
-                    return static_cast<std::decay_t<T>>(clamp(MIN, static_cast<TO>(a) + static_cast<TO>(temp), MAX));
+                    return static_cast<base_t<T>>(detail::saturate<stats::op::add>(MIN, static_cast<TO>(a) + static_cast<TO>(temp), MAX));
                 } else {
                     if constexpr (MIN == std::numeric_limits<T>::lowest() && MAX == std::numeric_limits<T>::max() && std::is_same_v<T, fit_all_t<T, UA, UB>>) {
                         T temp = 0;
-                        if constexpr (std::is_unsigned_v<T>) {
+                        if constexpr (is_unsigned_v<T>) {
                             return {
-                                __builtin_add_overflow(static_cast<T>(a), static_cast<T>(b), &temp)
+                                detail::overflowed<stats::op::add>(__builtin_add_overflow(static_cast<T>(a), static_cast<T>(b), &temp), true)
                                     ? MAX
                                     : temp
                             };
                         } else {
                             return {
-                                __builtin_add_overflow(static_cast<T>(a), static_cast<T>(b), &temp)
-                                    ? (static_cast<T>(b) > static_cast<T>(a) ? MIN : MAX)
+                                detail::overflowed<stats::op::add>(__builtin_add_overflow(static_cast<T>(a), static_cast<T>(b), &temp), !(static_cast<T>(a) < 0))
+                                    ? (static_cast<T>(a) < 0 ? MIN : MAX)
                                     : temp
                             };
                         }
                     } else {
                         using TO = next_up_t<fit_all_t<UA, UB>>;
-                        return static_cast<std::decay_t<T>>(clamp(MIN, static_cast<TO>(a) + static_cast<TO>(b), MAX));
-                    }
-                }
-            }
-        }
-    }
-
-    /**
-     * Add @param{val} to @param{out}, returning if overflow occured.
-     * @param  out Ouput variable
-     * @param  val Value to add
-     * @param  MIN Custom overflow minimum (always integral)
-     * @param  MAX Custom overflow maximum (always integral)
-     * @return     Overflow?
-     */
-    template <typename T, typename U>
-    constexpr bool add_to(T& out,
-                          const U& val,
-                          std::conditional_t<std::is_floating_point_v<T>, int, T> MIN = std::is_floating_point_v<T> ? (int)-1 : std::numeric_limits<T>::lowest(),
-                          std::conditional_t<std::is_floating_point_v<T>, int, T> MAX = std::is_floating_point_v<T> ?  (int)1 : std::numeric_limits<T>::max())
-    {
-        if constexpr (std::is_floating_point_v<T>) {
-            out += static_cast<std::decay_t<T>>(val);
-            if (out > MAX) {
-                out = MAX;
-                return true;
-            } else if (out < MIN) {
-                out = MIN;
-                return true;
-            } else {
-                return false;
-            }
-        } else {
-            if constexpr (MIN == std::numeric_limits<T>::lowest() &&
-                          MAX == std::numeric_limits<T>::max() &&
-                          std::is_same_v<T, fit_all_t<T, U>>)
-            {
-                if (__builtin_add_overflow(out, static_cast<T>(val), &out)) {
-                    if constexpr (std::is_unsigned_v<U>) {
-                        out = MAX;
-                    } else {
-                        out = static_cast<T>(val) > out ? MAX : MIN;
+                        return static_cast<base_t<T>>(detail::saturate<stats::op::add>(MIN, static_cast<TO>(a) + static_cast<TO>(b), MAX));
                     }
-                    return true;
-                } else {
-                    return false;
                 }
             }
         }
@@ -146,115 +260,599 @@ namespace saturating {
      * @return   New saturating type
      */
     template <typename T,
-              std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>
-                    MIN = std::is_floating_point_v<T>
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
                             ? -1
-                            : (std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>)std::numeric_limits<T>::lowest(),
-              std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>
-                    MAX = std::is_floating_point_v<T>
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
                             ? 1
-                            : (std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>)std::numeric_limits<T>::max(),
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
               typename UA,
               typename UB>
-    constexpr std::enable_if_t<std::is_arithmetic_v<UA> && std::is_arithmetic_v<UB>, std::decay_t<T>>
-    __attribute__((const))
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>, base_t<T>>
+    SATURATING_CONST
     subtract(const UA& a, const UB& b) noexcept {
-        using TO = next_up_t<fit_all_t<UA, UB>>;
-        if constexpr (std::is_floating_point_v<T>) {
-            if constexpr (std::is_floating_point_v<UA> || std::is_floating_point_v<UB>) {
-                return clamp(MIN, a - b, MAX);
+        // Unsigned operands can still produce a negative result
+        using TO = signed_t<next_up_t<fit_all_t<UA, UB>>>;
+        if constexpr (detail::provably_fits<detail::range_op::subtract, T, MIN, MAX, UA, UB>()) {
+            return detail::unclamped<detail::range_op::subtract, T>(a, b);
+        } else if constexpr (detail::use_ranges_v<T, UA, UB>) {
+            return detail::ranged<detail::range_op::subtract, T, MIN, MAX>(a, b);
+        } else if constexpr (is_saturating_v<UA> || is_saturating_v<UB>) {
+            return subtract<T, MIN, MAX>(detail::value_of(a), detail::value_of(b));
+        } else if constexpr (is_floating_point_v<T>) {
+            if constexpr (is_floating_point_v<UA> || is_floating_point_v<UB>) {
+                return detail::saturate<stats::op::subtract>(MIN, a - b, MAX);
             } else {
-                return clamp(MIN, static_cast<TO>(a) - b, MAX);
+                return detail::saturate<stats::op::subtract>(MIN, static_cast<TO>(a) - b, MAX);
             }
         } else {
-            if constexpr (std::is_floating_point_v<UA>) {
-                if constexpr (std::is_floating_point_v<UB>) {
-                    return static_cast<std::decay_t<T>>(clamp(MIN, round<T>(a - b), MAX));
+            if constexpr (is_floating_point_v<UA>) {
+                if constexpr (is_floating_point_v<UB>) {
+                    return static_cast<base_t<T>>(detail::saturate<stats::op::subtract>(MIN, round<T>(a - b), MAX));
                 } else {
-                    return static_cast<std::decay_t<T>>(clamp(MIN, round<T>(a - b), MAX));
+                    return static_cast<base_t<T>>(detail::saturate<stats::op::subtract>(MIN, round<T>(a - b), MAX));
                 }
             } else {
-                if constexpr (std::is_floating_point_v<UB>) {
-                    return static_cast<std::decay_t<T>>(clamp(MIN, round<T>(a - b), MAX));
+                if constexpr (is_floating_point_v<UB>) {
+                    return static_cast<base_t<T>>(detail::saturate<stats::op::subtract>(MIN, round<T>(a - b), MAX));
                 } else {
-                    return static_cast<std::decay_t<T>>(clamp(MIN, static_cast<TO>(a) - static_cast<TO>(b), MAX));
+                    return static_cast<base_t<T>>(detail::saturate<stats::op::subtract>(MIN, static_cast<TO>(a) - static_cast<TO>(b), MAX));
                 }
             }
         }
     }
 
     template <typename T,
-              std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>
-                    MIN = std::is_floating_point_v<T>
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
                             ? -1
-                            : (std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>)std::numeric_limits<T>::lowest(),
-              std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>
-                    MAX = std::is_floating_point_v<T>
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
                             ? 1
-                            : (std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>)std::numeric_limits<T>::max(),
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
               typename UA,
               typename UB>
-    constexpr std::enable_if_t<std::is_arithmetic_v<UA> && std::is_arithmetic_v<UB>, std::decay_t<T>>
-    __attribute__((const))
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>, base_t<T>>
+    SATURATING_CONST
     multiply(const UA& a, const UB& b) noexcept {
         using TO = next_up_t<fit_all_t<UA, UB>>;
-        if constexpr (std::is_floating_point_v<T>) {
-            if constexpr (std::is_floating_point_v<UA> || std::is_floating_point_v<UB>) {
-                return clamp(MIN, a * b, MAX);
+        if constexpr (detail::provably_fits<detail::range_op::multiply, T, MIN, MAX, UA, UB>()) {
+            return detail::unclamped<detail::range_op::multiply, T>(a, b);
+        } else if constexpr (detail::use_ranges_v<T, UA, UB>) {
+            return detail::ranged<detail::range_op::multiply, T, MIN, MAX>(a, b);
+        } else if constexpr (is_saturating_v<UA> || is_saturating_v<UB>) {
+            return multiply<T, MIN, MAX>(detail::value_of(a), detail::value_of(b));
+        } else if constexpr (is_floating_point_v<T>) {
+            if constexpr (is_floating_point_v<UA> || is_floating_point_v<UB>) {
+                return detail::saturate<stats::op::multiply>(MIN, a * b, MAX);
             } else {
-                return clamp(MIN, static_cast<TO>(a) * b, MAX);
+                return detail::saturate<stats::op::multiply>(MIN, static_cast<TO>(a) * b, MAX);
             }
         } else {
-            if constexpr (std::is_floating_point_v<UA>) {
-                if constexpr (std::is_floating_point_v<UB>) {
-                    return clamp(MIN, round<T>(a * b), MAX);
+            if constexpr (is_floating_point_v<UA>) {
+                if constexpr (is_floating_point_v<UB>) {
+                    return detail::saturate<stats::op::multiply>(MIN, round<T>(a * b), MAX);
                 } else {
-                    return clamp(MIN, round<T>(a * b), MAX);
+                    return detail::saturate<stats::op::multiply>(MIN, round<T>(a * b), MAX);
                 }
             } else {
-                if constexpr (std::is_floating_point_v<UB>) {
-                    return clamp(MIN, round<T>(a * b), MAX);
+                if constexpr (is_floating_point_v<UB>) {
+                    return detail::saturate<stats::op::multiply>(MIN, round<T>(a * b), MAX);
                 } else {
-                    return clamp(MIN, static_cast<TO>(a) * static_cast<TO>(b), MAX);
+                    using TC = fit_all_t<T, UA, UB>;
+                    if constexpr (MIN == std::numeric_limits<T>::lowest() && MAX == std::numeric_limits<T>::max() && std::is_same_v<T, TC>) {
+                        // Native width, the overflow direction follows from the operand signs
+                        T temp = 0;
+                        if constexpr (is_unsigned_v<T>) {
+                            return detail::overflowed<stats::op::multiply>(__builtin_mul_overflow(static_cast<T>(a), static_cast<T>(b), &temp), true) ? MAX : temp;
+                        } else {
+                            const bool negative = (static_cast<T>(a) < 0) ^ (static_cast<T>(b) < 0);
+                            return detail::overflowed<stats::op::multiply>(__builtin_mul_overflow(static_cast<T>(a), static_cast<T>(b), &temp), !negative)
+                                        ? (negative ? MIN : MAX)
+                                        : temp;
+                        }
+                    } else if constexpr (sizeof(TO) > sizeof(fit_all_t<UA, UB>)) {
+                        return detail::saturate<stats::op::multiply>(MIN, static_cast<TO>(a) * static_cast<TO>(b), MAX);
+                    } else {
+                        // No wider type available (e.g. 64 bit without `__int128`), detect overflow instead
+                        TC temp = 0;
+                        const bool negative = (static_cast<TC>(a) < 0) ^ (static_cast<TC>(b) < 0);
+                        if (detail::overflowed<stats::op::multiply>(__builtin_mul_overflow(static_cast<TC>(a), static_cast<TC>(b), &temp), !negative)) {
+                            return negative ? MIN : MAX;
+                        }
+                        return detail::saturate<stats::op::multiply>(MIN, temp, MAX);
+                    }
                 }
             }
         }
     }
 
+    namespace detail {
+        /**
+         * Round the truncated quotient `q` of magnitudes `n / d` half away from zero, using the remainder.
+         */
+        template <typename TU>
+        constexpr TU __attribute__((pure))
+        round_quotient(const TU& n, const TU& q, const TU& d) noexcept {
+            const TU r = static_cast<TU>(n - q * d);
+            return static_cast<TU>(q + (r >= static_cast<TU>(d - r)));
+        }
+
+        /**
+         * Clamp the value with magnitude `q` and sign `negative` to `MIN` ... `MAX`.
+         */
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename TU>
+        constexpr base_t<T> SATURATING_CONST
+        from_magnitude(const TU& q, bool negative) noexcept {
+            using TW = signed_t<next_up_t<TU>>;
+            if constexpr (sizeof(TW) > sizeof(TU)) {
+                const TW v = negative ? -static_cast<TW>(q) : static_cast<TW>(q);
+                return static_cast<base_t<T>>(detail::saturate<stats::op::divide>(MIN, v, MAX));
+            } else {
+                // No wider type, negate in the unsigned domain (q <= |lowest| here) and cap positive values
+                const TW v = negative
+                                ? static_cast<TW>(static_cast<TU>(TU(0) - q))
+                                : static_cast<TW>(q > static_cast<TU>(std::numeric_limits<TW>::max()) ? std::numeric_limits<TW>::max() : q);
+                return static_cast<base_t<T>>(detail::saturate<stats::op::divide>(MIN, v, MAX));
+            }
+        }
+    } // namespace detail
+
+    /**
+     * Divide `a` by `b` and return a new saturating type. Integer division rounds half away from zero, dividing
+     * by zero saturates to `MIN` for negative `a` and to `MAX` otherwise.
+     * @param  a Left hand side of operator
+     * @param  b Right hand side of operator
+     * @return   New saturating type
+     */
     template <typename T,
-              std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>
-                    MIN = std::is_floating_point_v<T>
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
                             ? -1
-                            : (std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>)std::numeric_limits<T>::lowest(),
-              std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>
-                    MAX = std::is_floating_point_v<T>
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
                             ? 1
-                            : (std::conditional_t<std::is_floating_point_v<T>, int, std::decay_t<T>>)std::numeric_limits<T>::max(),
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
               typename UA,
               typename UB>
-    constexpr std::enable_if_t<std::is_arithmetic_v<UA> && std::is_arithmetic_v<UB>, std::decay_t<T>>
-    __attribute__((const))
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>, base_t<T>>
+    SATURATING_CONST
     divide(const UA& a, const UB& b) noexcept {
-        using TO = next_up_t<fit_all_t<UA, UB>>;
-        if constexpr (std::is_floating_point_v<UA> || std::is_floating_point_v<UB>) {
-            if constexpr (std::is_floating_point_v<T>) {
-                return static_cast<std::decay_t<T>>(clamp(MIN, a / b, MAX));
+        if constexpr (is_saturating_v<UA> || is_saturating_v<UB>) {
+            return divide<T, MIN, MAX>(detail::value_of(a), detail::value_of(b));
+        } else if constexpr (is_floating_point_v<UA> || is_floating_point_v<UB>) {
+            if constexpr (is_floating_point_v<T>) {
+                return static_cast<base_t<T>>(detail::saturate<stats::op::divide>(MIN, a / b, MAX));
             } else {
-                return static_cast<std::decay_t<T>>(clamp(MIN, round<T>(a / b), MAX));
+                return static_cast<base_t<T>>(detail::saturate<stats::op::divide>(MIN, round<T>(a / b), MAX));
             }
         } else {
-            return static_cast<std::decay_t<T>>(clamp(MIN, ((a < 0) ^ (b < 0)) ? ((a - b/2)/b) : ((a + b/2)/b), MAX));
+            // A single unsigned division of the magnitudes, signs, rounding and a zero divisor only need selects
+            using TU = unsigned_t<fit_all_t<UA, UB>>;
+            const TU ua = magnitude<TU>(a);
+            const TU ub = magnitude<TU>(b);
+            const TU d  = ub == 0 ? TU(1) : ub;
+            const TU q  = detail::round_quotient(ua, static_cast<TU>(ua / d), d);
+            return detail::overflowed<stats::op::divide>(ub == 0, !is_negative(a))
+                       ? (is_negative(a) ? MIN : MAX)
+                       : detail::from_magnitude<T, MIN, MAX>(q, is_negative(a) ^ is_negative(b));
         }
     }
 
-    //TODO: increments, pow, square, sqrt, etc...
+    namespace detail {
+        /** Floating point type for `U`: `float` if that holds all of them exactly, `long double` for 64 bit integers. */
+        template <typename... U>
+        using float_for_t = std::conditional_t<((std::is_same_v<typename range_of<U>::value_type, float> ||
+                                                 (is_integral_v<typename range_of<U>::value_type> && sizeof(typename range_of<U>::value_type) <= 2)) && ...),
+                                               float,
+                                               std::conditional_t<((std::is_same_v<typename range_of<U>::value_type, long double> ||
+                                                                    (is_integral_v<typename range_of<U>::value_type> && sizeof(typename range_of<U>::value_type) > 4)) || ...),
+                                                                  long double, double>>;
+
+        /** Floating point `v` saturated to `MIN` ... `MAX`, rounded once for integral `T`. */
+        template <stats::op O, typename T, limit_t<T> MIN, limit_t<T> MAX, typename F>
+        constexpr base_t<T> clamp_float(const F& v) noexcept {
+            if constexpr (is_floating_point_v<base_t<T>>) {
+                return static_cast<base_t<T>>(saturate<O>(static_cast<F>(MIN), v, static_cast<F>(MAX)));
+            } else {
+                return static_cast<base_t<T>>(saturate<O>(MIN, round<T>(v), MAX));
+            }
+        }
+    } // namespace detail
+
+    /**
+     * Fused multiply-add `a * b + c`, computed exactly (or in floating point, rounded once) and saturated once.
+     * For integers the intermediate type follows from the operand ranges (the limits of saturating types), and
+     * the clamp is left out when the result always fits.
+     * @param  a Left hand side of the product
+     * @param  b Right hand side of the product
+     * @param  c Addend
+     * @return   New saturating type
+     */
+    template <typename T,
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
+                            ? -1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
+                            ? 1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
+              typename UA,
+              typename UB,
+              typename UC>
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB> && is_arithmetic_v<UC>, base_t<T>>
+    SATURATING_CONST
+    fma(const UA& a, const UB& b, const UC& c) noexcept {
+        using RA = range_of<UA>;
+        using RB = range_of<UB>;
+        using RC = range_of<UC>;
+        if constexpr (!detail::narrow_integral_v<UA, UB, UC>) {
+            using F = detail::float_for_t<UA, UB, UC>;
+            return detail::clamp_float<stats::op::fma, T, MIN, MAX>(static_cast<F>(detail::value_of(a)) * static_cast<F>(detail::value_of(b)) + static_cast<F>(detail::value_of(c)));
+        } else {
+            constexpr auto p = detail::result_range<detail::range_op::multiply>(RA::min_val, RA::max_val, RB::min_val, RB::max_val);
+            constexpr auto r = detail::result_range<detail::range_op::add>(p.lo, p.hi, RC::min_val, RC::max_val);
+            if constexpr (p.exact && r.exact) {
+                // Modular arithmetic in the evaluation width is exact, as the result fits
+                using W = detail::evaluation_t<r.lo, r.hi>;
+                using M = detail::modular_t<W>;
+                const W v = static_cast<W>(static_cast<M>(static_cast<M>(detail::value_of(a)) * static_cast<M>(detail::value_of(b)) + static_cast<M>(detail::value_of(c))));
+                return detail::clamp_range<stats::op::fma, T, MIN, MAX, r.lo, r.hi>(v);
+            } else {
+                // 64 bit products beyond `widest_t`, only the overflow direction matters then
+                using W = detail::widest_t;
+                W m = 0, v = 0;
+                const bool negative = is_negative(detail::value_of(a)) != is_negative(detail::value_of(b));
+                if (detail::overflowed<stats::op::fma>(__builtin_mul_overflow(static_cast<W>(detail::value_of(a)), static_cast<W>(detail::value_of(b)), &m), !negative)) {
+                    return negative ? MIN : MAX;
+                }
+                if (detail::overflowed<stats::op::fma>(__builtin_add_overflow(m, static_cast<W>(detail::value_of(c)), &v), !(m < 0))) {
+                    return m < 0 ? MIN : MAX;
+                }
+                return static_cast<base_t<T>>(detail::saturate<stats::op::fma>(static_cast<W>(MIN), v, static_cast<W>(MAX)));
+            }
+        }
+    }
+
+    /**
+     * Linear interpolation `a + t * (b - a)`, rounded and saturated once. `t` is a floating point weight, at 0 the
+     * result is `a`, at 1 `b`.
+     * @param  a Value at 0
+     * @param  b Value at 1
+     * @param  t Weight
+     * @return   New saturating type
+     */
+    template <typename T,
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
+                            ? -1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
+                            ? 1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
+              typename UA,
+              typename UB,
+              typename UT>
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB> && is_floating_point_v<typename range_of<UT>::value_type>, base_t<T>>
+    SATURATING_CONST
+    lerp(const UA& a, const UB& b, const UT& t) noexcept {
+        using F = detail::float_for_t<UA, UB, UT>;
+        const F x = static_cast<F>(detail::value_of(a));
+        const F y = static_cast<F>(detail::value_of(b));
+        return detail::clamp_float<stats::op::lerp, T, MIN, MAX>(x + static_cast<F>(detail::value_of(t)) * (y - x));
+    }
+
+    /**
+     * Absolute difference `|a - b|`, computed exactly and saturated once.
+     * @param  a Left hand side of operator
+     * @param  b Right hand side of operator
+     * @return   New saturating type
+     */
+    template <typename T,
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
+                            ? -1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
+                            ? 1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
+              typename UA,
+              typename UB>
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>, base_t<T>>
+    SATURATING_CONST
+    abs_diff(const UA& a, const UB& b) noexcept {
+        using RA = range_of<UA>;
+        using RB = range_of<UB>;
+        if constexpr (!detail::narrow_integral_v<UA, UB>) {
+            using F = detail::float_for_t<UA, UB>;
+            const F d = static_cast<F>(detail::value_of(a)) - static_cast<F>(detail::value_of(b));
+            return detail::clamp_float<stats::op::abs_diff, T, MIN, MAX>(d < 0 ? -d : d);
+        } else {
+            constexpr auto r = detail::result_range<detail::range_op::subtract>(RA::min_val, RA::max_val, RB::min_val, RB::max_val);
+            static_assert(r.exact, "Operands narrower than `widest_t` always fit it");
+            constexpr detail::widest_t hi = -r.lo > r.hi ? -r.lo : r.hi;
+            constexpr detail::widest_t lo = r.lo <= 0 && r.hi >= 0 ? 0 : (r.lo > 0 ? r.lo : -r.hi);
+            // Symmetric, so negating the difference can't overflow
+            using W = detail::evaluation_t<-hi, hi>;
+            using M = detail::modular_t<W>;
+            const W d = static_cast<W>(static_cast<M>(static_cast<M>(detail::value_of(a)) - static_cast<M>(detail::value_of(b))));
+            return detail::clamp_range<stats::op::abs_diff, T, MIN, MAX, lo, hi>(static_cast<W>(d < 0 ? -d : d));
+        }
+    }
+
+    /**
+     * Integer power `a` to the `n`, saturated once. Integers are raised by repeated squaring of the magnitude,
+     * which stops as soon as the result is known to saturate: `pow<int16_t>(10, 1000)` takes two multiplies.
+     * Floating point operands are raised in floating point and rounded once. `pow(a, 0)` is 1.
+     * @param  a Base
+     * @param  n Exponent
+     * @return   New saturating type
+     */
+    template <typename T,
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
+                            ? -1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
+                            ? 1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
+              typename U>
+    constexpr std::enable_if_t<is_arithmetic_v<U>, base_t<T>>
+    SATURATING_CONST
+    pow(const U& a, unsigned n) noexcept {
+        using V = typename range_of<U>::value_type;
+        if constexpr (is_floating_point_v<V> || is_floating_point_v<base_t<T>>) {
+            using F = detail::float_for_t<U>;
+            F r = 1;
+            F b = static_cast<F>(detail::value_of(a));
+            for (; n; n >>= 1, b *= b) {
+                if (n & 1) r *= b;
+            }
+            return detail::clamp_float<stats::op::pow, T, MIN, MAX>(r);
+        } else {
+            const auto v = detail::value_of(a);
+            const bool negative = is_negative(v) && (n & 1);
+            // Largest magnitude of the result, beyond it the result saturates to the limit of its sign
+            const std::uint64_t limit = negative ? (MIN < 0 ? magnitude<std::uint64_t>(MIN) : 0) : (MAX > 0 ? static_cast<std::uint64_t>(MAX) : 0);
+            std::uint64_t r = 1;
+            std::uint64_t b = magnitude<std::uint64_t>(v);
+            for (;;) {
+                if (n & 1) {
+                    if (detail::overflowed<stats::op::pow>(__builtin_mul_overflow(r, b, &r) || r > limit, !negative)) {
+                        return negative ? MIN : MAX;
+                    }
+                }
+                n >>= 1;
+                if (!n) break;
+                // `r` is at least 1 unless `b` is 0, so a square beyond the limit will push `r` over it too
+                if (detail::overflowed<stats::op::pow>(__builtin_mul_overflow(b, b, &b) || b > limit, !negative)) {
+                    return negative ? MIN : MAX;
+                }
+            }
+            using W = detail::widest_t;
+            using M = detail::modular_t<W>;
+            const W w = negative ? static_cast<W>(static_cast<M>(M(0) - static_cast<M>(r))) : static_cast<W>(r);
+            return static_cast<base_t<T>>(detail::saturate<stats::op::pow>(static_cast<W>(MIN), w, static_cast<W>(MAX)));
+        }
+    }
+
+    /**
+     * Square `a * a`, computed exactly (or in floating point, rounded once) and saturated once. The range of
+     * the square follows from the operand range, so `square<int32_t>(int16_t)` needs no clamp at all.
+     * @param  a Value
+     * @return   New saturating type
+     */
+    template <typename T,
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
+                            ? -1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
+                            ? 1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
+              typename U>
+    constexpr std::enable_if_t<is_arithmetic_v<U>, base_t<T>>
+    SATURATING_CONST
+    square(const U& a) noexcept {
+        using R = range_of<U>;
+        if constexpr (!detail::narrow_integral_v<U>) {
+            using F = detail::float_for_t<U>;
+            const F x = static_cast<F>(detail::value_of(a));
+            return detail::clamp_float<stats::op::pow, T, MIN, MAX>(x * x);
+        } else {
+            constexpr auto p = detail::result_range<detail::range_op::multiply>(R::min_val, R::max_val, R::min_val, R::max_val);
+            if constexpr (p.exact) {
+                constexpr detail::widest_t lo = R::min_val <= 0 && R::max_val >= 0
+                                                    ? 0
+                                                    : (R::min_val > 0 ? static_cast<detail::widest_t>(R::min_val) * R::min_val
+                                                                      : static_cast<detail::widest_t>(R::max_val) * R::max_val);
+                using W = detail::evaluation_t<lo, p.hi>;
+                using M = detail::modular_t<W>;
+                const M x = static_cast<M>(detail::value_of(a));
+                return detail::clamp_range<stats::op::pow, T, MIN, MAX, lo, p.hi>(static_cast<W>(static_cast<M>(x * x)));
+            } else {
+                return pow<T, MIN, MAX>(a, 2u);
+            }
+        }
+    }
+
+    namespace detail {
+        /** Floor of the square root of `n`, one result bit at a time. */
+        constexpr std::uint64_t __attribute__((pure))
+        isqrt_bits(std::uint64_t n) noexcept {
+            std::uint64_t r = 0;
+            std::uint64_t bit = std::uint64_t(1) << 62;
+            while (bit > n) bit >>= 2;
+            for (; bit; bit >>= 2) {
+                if (n >= r + bit) {
+                    n -= r + bit;
+                    r = (r >> 1) + bit;
+                } else {
+                    r >>= 1;
+                }
+            }
+            return r;
+        }
+
+        /** `isqrt_bits`, with a hardware estimate outside of constant evaluation. */
+        constexpr std::uint64_t __attribute__((pure))
+        isqrt(std::uint64_t n) noexcept {
+            if (__builtin_is_constant_evaluated()) return isqrt_bits(n);
+            // Exact for `n` below 2^52, beyond that the estimate may be off by one either way
+            std::uint64_t r = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+            if (r > 0xFFFFFFFFu) r = 0xFFFFFFFFu;
+            if (r * r > n) --r;
+            else if (r < 0xFFFFFFFFu && (r + 1) * (r + 1) <= n) ++r;
+            return r;
+        }
+    } // namespace detail
+
+    /**
+     * Integer square root, the floor of the square root of integral `a`, saturated to `MIN` ... `MAX`. Negative
+     * values have no square root and saturate low (to 0, or `MIN` if that is higher).
+     * @param  a Value
+     * @return   New saturating type
+     */
+    template <typename T,
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
+                            ? -1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
+                            ? 1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
+              typename U>
+    constexpr std::enable_if_t<is_integral_v<typename range_of<U>::value_type>, base_t<T>>
+    SATURATING_CONST
+    isqrt(const U& a) noexcept {
+        using R = range_of<U>;
+        constexpr detail::widest_t lo = R::min_val > 0 ? static_cast<detail::widest_t>(detail::isqrt_bits(static_cast<std::uint64_t>(R::min_val))) : 0;
+        constexpr detail::widest_t hi = R::max_val > 0 ? static_cast<detail::widest_t>(detail::isqrt_bits(static_cast<std::uint64_t>(R::max_val))) : 0;
+        const auto v = detail::value_of(a);
+        if (detail::overflowed<stats::op::sqrt>(is_negative(v), false)) {
+            return static_cast<base_t<T>>(MIN > 0 ? MIN : 0);
+        }
+        return detail::clamp_range<stats::op::sqrt, T, MIN, MAX, lo, hi>(static_cast<std::int64_t>(detail::isqrt(static_cast<std::uint64_t>(v))));
+    }
+
+    /**
+     * Shift integral `a` left by `n` bits, `a * 2^n` saturated once. Negative values shift towards `MIN`.
+     * @param  a Value
+     * @param  n Bits to shift
+     * @return   New saturating type
+     */
+    template <typename T,
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MIN = is_floating_point_v<T>
+                            ? -1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::lowest(),
+              std::conditional_t<is_floating_point_v<T>, int, base_t<T>>
+                    MAX = is_floating_point_v<T>
+                            ? 1
+                            : (std::conditional_t<is_floating_point_v<T>, int, base_t<T>>)std::numeric_limits<T>::max(),
+              typename U>
+    constexpr std::enable_if_t<is_integral_v<typename range_of<U>::value_type>, base_t<T>>
+    SATURATING_CONST
+    shift_left(const U& a, unsigned n) noexcept {
+        const auto v = detail::value_of(a);
+        const bool negative = is_negative(v);
+        const std::uint64_t m = magnitude<std::uint64_t>(v);
+        const std::uint64_t limit = negative ? (MIN < 0 ? magnitude<std::uint64_t>(MIN) : 0) : (MAX > 0 ? static_cast<std::uint64_t>(MAX) : 0);
+        if (detail::overflowed<stats::op::shift_left>(m != 0 && (n >= 64 || m > (limit >> n)), !negative)) {
+            return negative ? MIN : MAX;
+        }
+        using W = detail::widest_t;
+        using M = detail::modular_t<W>;
+        const std::uint64_t s = m == 0 ? 0 : m << n;
+        const W w = negative ? static_cast<W>(static_cast<M>(M(0) - static_cast<M>(s))) : static_cast<W>(s);
+        return static_cast<base_t<T>>(detail::saturate<stats::op::shift_left>(static_cast<W>(MIN), w, static_cast<W>(MAX)));
+    }
+
+    namespace detail {
+        /** `out = out O val` saturated to `MIN` ... `MAX`, returning if the exact result was outside of that. */
+        template <range_op O, stats::op S, typename T, limit_t<T> MIN, limit_t<T> MAX, typename U>
+        constexpr bool accumulate(T& out, const U& val) noexcept {
+            const auto v = value_of(val);
+            if constexpr (is_floating_point_v<T> || is_floating_point_v<typename range_of<U>::value_type>) {
+                using F = float_for_t<T, U>;
+                const F s = O == range_op::add ? static_cast<F>(out) + static_cast<F>(v) : static_cast<F>(out) - static_cast<F>(v);
+                const bool low = s < static_cast<F>(MIN);
+                const bool high = s > static_cast<F>(MAX);
+                out = low ? MIN : (high ? MAX : clamp_float<S, T, MIN, MAX>(s));
+                return overflowed<S>(low || high, high);
+            } else if constexpr (narrow_integral_v<T, U> && sizeof(evaluation_t<result_range<O>(range_of<T>::min_val, range_of<T>::max_val, range_of<U>::min_val, range_of<U>::max_val).lo,
+                                                                             result_range<O>(range_of<T>::min_val, range_of<T>::max_val, range_of<U>::min_val, range_of<U>::max_val).hi>) <= sizeof(std::int64_t)) {
+                // Exact in a wider register, clamped with selects
+                constexpr auto r = result_range<O>(range_of<T>::min_val, range_of<T>::max_val, range_of<U>::min_val, range_of<U>::max_val);
+                using W = evaluation_t<r.lo, r.hi>;
+                const W s = O == range_op::add ? static_cast<W>(static_cast<W>(out) + static_cast<W>(v)) : static_cast<W>(static_cast<W>(out) - static_cast<W>(v));
+                const W c = clamp_same(static_cast<W>(MIN), s, static_cast<W>(MAX));
+                out = static_cast<T>(c);
+                return overflowed<S>(c != s, c < s);
+            } else {
+                // The builtins compute the exact result for any pair of integer types, all else are selects
+                T s {};
+                const bool up = O == range_op::add ? !is_negative(v) : is_negative(v);
+                const bool overflow = O == range_op::add ? __builtin_add_overflow(out, v, &s) : __builtin_sub_overflow(out, v, &s);
+                // Both compare against constants, for the full range of `T` they fold away
+                const bool low = overflow ? !up : s < MIN;
+                const bool high = overflow ? up : s > MAX;
+                out = low ? MIN : (high ? MAX : s);
+                return overflowed<S>(low || high, high);
+            }
+        }
+    } // namespace detail
+
+    /**
+     * Add `val` to `out` in place, saturating to `MIN` ... `MAX`.
+     * @param  out Output variable, a plain arithmetic type
+     * @param  val Value to add, of any (saturating or plain) arithmetic type
+     * @return     Did the sum fall outside of `MIN` ... `MAX`?
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename U>
+    constexpr std::enable_if_t<is_arithmetic_v<T> && !is_saturating_v<T> && is_arithmetic_v<U>, bool>
+    add_to(T& out, const U& val) noexcept {
+        return detail::accumulate<detail::range_op::add, stats::op::add, T, MIN, MAX>(out, val);
+    }
+
+    /**
+     * Subtract `val` from `out` in place, saturating to `MIN` ... `MAX`.
+     * @param  out Output variable, a plain arithmetic type
+     * @param  val Value to subtract, of any (saturating or plain) arithmetic type
+     * @return     Did the difference fall outside of `MIN` ... `MAX`?
+     */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename U>
+    constexpr std::enable_if_t<is_arithmetic_v<T> && !is_saturating_v<T> && is_arithmetic_v<U>, bool>
+    subtract_from(T& out, const U& val) noexcept {
+        return detail::accumulate<detail::range_op::subtract, stats::op::subtract, T, MIN, MAX>(out, val);
+    }
 
     template <typename UA, typename UB, typename T>
-    constexpr void add(const UA& a, const UB& b, T& out) noexcept { out = add<T>(a, b); }
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>>
+    add(const UA& a, const UB& b, T& out) noexcept { out = add<T>(a, b); }
     template <typename UA, typename UB, typename T>
-    constexpr void subtract(const UA& a, const UB& b, T& out) noexcept { out = subtract<T>(a, b); }
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>>
+    subtract(const UA& a, const UB& b, T& out) noexcept { out = subtract<T>(a, b); }
     template <typename UA, typename UB, typename T>
-    constexpr void multiply(const UA& a, const UB& b, T& out) noexcept { out = multiply<T>(a, b); }
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>>
+    multiply(const UA& a, const UB& b, T& out) noexcept { out = multiply<T>(a, b); }
     template <typename UA, typename UB, typename T>
-    constexpr void divide(const UA& a, const UB& b, T& out) noexcept { out = divide<T>(a, b); }
+    constexpr std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>>
+    divide(const UA& a, const UB& b, T& out) noexcept { out = divide<T>(a, b); }
 } // namespace saturating
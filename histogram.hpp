@@ -0,0 +1,188 @@
+/**@file
+ * @brief Saturating histograms, one bin per value of a saturating type.
+ *
+ * `saturating::histogram<S, C>` counts samples per value of `S` (`type<T, MIN, MAX>` or an integral type). Samples
+ * are clamped to `MIN` ... `MAX` with `type::clamp`, so values out of range land in the first or last bin, and
+ * every bin is a saturating counter `C` that stops at its limit instead of wrapping.
+ *
+ * Bulk insertion counts into private sub-histograms of plain 32 bit counters, consecutive samples going to
+ * different lanes. A run of equal samples then increments different memory locations, instead of each increment
+ * waiting for the store of the previous one to the same bin. The lanes are added to the bins, saturating, at the
+ * end of each block of samples.
+ *
+ * The bins are allocated on the heap, up to 2^24 of them don't fit a stack. The parallel versions take an
+ * executor (see `parallel.hpp`). Slices of the input are counted into private histograms, which are merged with
+ * every task adding up a range of bins. Each slice counts at least as many samples as there are bins, and all
+ * private histograms together take at most 64 MiB, so wide histograms use fewer slices.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<span>) && __cplusplus > 201703L
+#include <span>
+#endif
+
+#include "./utilities.hpp"
+#include "./types.hpp"
+#include "./parallel.hpp"
+
+namespace saturating {
+    /**
+     * Histogram of saturated samples.
+     * @tparam S `saturating::type` or integral type, one bin per value of `MIN` ... `MAX`
+     * @tparam C Bin counter, an unsigned `saturating::type` starting at zero
+     */
+    template <typename S, typename C = uint_sat32_t>
+    class histogram {
+        using T = typename range_of<S>::value_type;
+        static constexpr T MIN = range_of<S>::min_val;
+        static constexpr T MAX = range_of<S>::max_val;
+        using sample_t = type<T, MIN, MAX>;
+
+        static_assert(is_integral_v<T>, "Histograms have a bin per integer value");
+        static_assert(is_saturating_v<C> && is_unsigned_v<typename range_of<C>::value_type> && range_of<C>::min_val == 0,
+                      "Bins are unsigned saturating counters, starting at zero");
+        // Modulo 2^64 the difference is exact for signed types as well
+        static_assert(static_cast<std::uint64_t>(MAX) - static_cast<std::uint64_t>(MIN) < (std::uint64_t(1) << 24), "At most 2^24 bins");
+
+    public:
+        using value_type = S;
+        using counter_type = C;
+
+        /** Number of bins, `MAX - MIN + 1`. */
+        static constexpr std::size_t bins = static_cast<std::size_t>(static_cast<std::uint64_t>(MAX) - static_cast<std::uint64_t>(MIN)) + 1;
+
+        /** Sub-histograms used by bulk insertion, small histograms only so the lanes stay in cache. */
+        static constexpr std::size_t lanes = bins <= 4096 ? 4 : 1;
+
+        histogram() : counts(bins) {}
+
+        /** Bin of sample `val`, after clamping it to `MIN` ... `MAX`. */
+        template <typename U>
+        static constexpr std::size_t bin(const U& val) noexcept {
+            return static_cast<std::size_t>(static_cast<std::uint64_t>(detail::value_of(sample_t::clamp(detail::value_of(val)))) - static_cast<std::uint64_t>(MIN));
+        }
+
+        /** Sample value counted in bin `b`. */
+        static constexpr S value(std::size_t b) noexcept {
+            return static_cast<T>(static_cast<std::uint64_t>(MIN) + b);
+        }
+
+        /** Count one sample. */
+        template <typename U>
+        void insert(const U& val) noexcept { ++counts[bin(val)]; }
+
+        /** Count samples `x[0] ... x[n - 1]`. */
+        template <typename U>
+        void insert(const U* x, std::size_t n) {
+            if (lanes == 1 || n < lanes * bins) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    insert(x[i]);
+                }
+                return;
+            }
+            std::vector<std::uint32_t> sub(lanes * bins);
+            // No lane sees more than `block / lanes` samples between flushes
+            constexpr std::size_t block = std::size_t(std::numeric_limits<std::uint32_t>::max() / lanes) * lanes;
+            for (std::size_t i = 0; i < n; i += block) {
+                const U* p = x + i;
+                const std::size_t m = std::min(n - i, block);
+                std::size_t j = 0;
+                for (; j + lanes <= m; j += lanes) {
+                    for (std::size_t l = 0; l < lanes; ++l) {
+                        ++sub[l * bins + bin(p[j + l])];
+                    }
+                }
+                for (; j < m; ++j) {
+                    ++sub[bin(p[j])];
+                }
+                for (std::size_t b = 0; b < bins; ++b) {
+                    std::uint64_t c = 0;
+                    for (std::size_t l = 0; l < lanes; ++l) {
+                        c += std::exchange(sub[l * bins + b], 0);
+                    }
+                    counts[b].add_to(c);
+                }
+            }
+        }
+
+        /** Parallel version of the bulk `insert`. */
+        template <typename Exec, typename U>
+        std::enable_if_t<is_executor_v<Exec>> insert(Exec&& exec, const U* x, std::size_t n) {
+            const std::size_t slices = std::min<std::size_t>(max_slices, n / std::max<std::size_t>(bins, detail::chunk_bytes / sizeof(U)));
+            if (slices < 2) {
+                insert(x, n);
+                return;
+            }
+            std::vector<histogram> parts(slices);
+            detail::for_chunks(exec, slices, [&](std::size_t k) { parts[k].insert(x + n * k / slices, n * (k + 1) / slices - n * k / slices); });
+            merge(std::forward<Exec>(exec), parts.data(), slices);
+        }
+
+        /** Add the counts of `other`, saturating. */
+        void merge(const histogram& other) noexcept { merge_bins(&other, 1, 0, bins); }
+
+        /** Add the counts of `others[0] ... others[n - 1]`, saturating, in parallel over ranges of bins. */
+        template <typename Exec>
+        std::enable_if_t<is_executor_v<Exec>> merge(Exec&& exec, const histogram* others, std::size_t n) {
+            // Ranges start on a cache line of bins
+            constexpr std::size_t range = std::max<std::size_t>(detail::cache_line / sizeof(C), 1024);
+            const std::size_t ranges = (bins + range - 1) / range;
+            if (ranges < 2) {
+                merge_bins(others, n, 0, bins);
+            } else {
+                detail::for_chunks(std::forward<Exec>(exec), ranges, [&](std::size_t k) { merge_bins(others, n, k * range, std::min(bins, (k + 1) * range)); });
+            }
+        }
+
+        /** Count of bin `b`. */
+        const C& operator[](std::size_t b) const noexcept { return counts[b]; }
+
+        /** Count of the bin sample `val` goes to. */
+        template <typename U>
+        const C& count(const U& val) const noexcept { return counts[bin(val)]; }
+
+        /** Number of samples counted, saturated to the range of `C`. */
+        C total() const noexcept {
+            C t {};
+            for (const auto& c : counts) {
+                t.add_to(c);
+            }
+            return t;
+        }
+
+        void clear() noexcept { std::fill(counts.begin(), counts.end(), C{}); }
+
+        const C* begin() const noexcept { return counts.data(); }
+        const C* end() const noexcept { return counts.data() + bins; }
+
+#ifdef __cpp_lib_span
+        template <typename U, std::size_t E>
+        void insert(std::span<U, E> x) { insert(x.data(), x.size()); }
+
+        template <typename Exec, typename U, std::size_t E>
+        std::enable_if_t<is_executor_v<Exec>> insert(Exec&& exec, std::span<U, E> x) { insert(std::forward<Exec>(exec), x.data(), x.size()); }
+#endif
+
+    private:
+        /** Upper limit on the private histograms of the parallel `insert`, 64 or fewer taking 64 MiB in total. */
+        static constexpr std::size_t max_slices = std::clamp<std::size_t>((std::size_t(64) << 20) / (bins * sizeof(C)), 1, 64);
+
+        void merge_bins(const histogram* others, std::size_t n, std::size_t first, std::size_t last) noexcept {
+            for (std::size_t b = first; b < last; ++b) {
+                for (std::size_t o = 0; o < n; ++o) {
+                    counts[b].add_to(others[o].counts[b]);
+                }
+            }
+        }
+
+        std::vector<C> counts;
+    };
+} // namespace saturating
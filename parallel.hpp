@@ -0,0 +1,560 @@
+/**@file
+ * @brief Multi threaded versions of the bulk operations and reductions.
+ *
+ * Every function in this header takes an executor as its first argument, either a `saturating::thread_pool` or,
+ * when `<execution>` is included before this header, a standard execution policy like
+ * `std::execution::par_unseq`. The work is split into chunks of about 256 KiB, each processed by the matching
+ * single threaded function from `bulk.hpp` or `algorithms.hpp`:
+ * - Chunk boundaries of element wise operations fall on cache line boundaries of the output buffer, so threads
+ *   never write to the same cache line.
+ * - Chunk boundaries of reductions and prefix sums only depend on the element count, never on the addresses of
+ *   the buffers or the number of threads.
+ * - Partial results of reductions are combined in chunk order. Integral results are identical to those of the
+ *   single threaded functions, floating point results may differ from those by rounding, but are reproducible
+ *   for the same input, wherever it is stored.
+ *
+ * For per step reductions each chunk is summarized as `f(s) = clamp(s + sum, lo, hi)`, which is exactly what
+ * saturating after every element of the chunk does to a starting value `s`.
+ *
+ * Note that libstdc++ implements the parallel execution policies using TBB, which needs `-ltbb`.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<span>) && __cplusplus > 201703L
+#include <span>
+#endif
+
+#if defined(__cpp_lib_execution) && __has_include(<execution>)
+#include <execution>
+#endif
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+#include "./divider.hpp"
+#include "./bulk.hpp"
+#include "./algorithms.hpp"
+
+namespace saturating {
+    /**
+     * Minimal fixed size thread pool. The thread calling `run` takes part in the work, so a pool of `threads`
+     * starts `threads - 1` workers.
+     */
+    class thread_pool {
+    public:
+        explicit thread_pool(unsigned threads = std::thread::hardware_concurrency()) {
+            for (unsigned i = 1; i < threads; ++i) {
+                workers.emplace_back([this] { work(); });
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock { mutex };
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& t : workers) {
+                t.join();
+            }
+        }
+
+        /** Number of threads taking part in `run`, including the caller. */
+        unsigned size() const noexcept { return static_cast<unsigned>(workers.size() + 1); }
+
+        /**
+         * Call `f(i)` for every `i` in `0 ... tasks - 1`, spread over the pool. Returns when all calls are done.
+         * Calls from multiple threads are handled one after the other.
+         */
+        template <typename F>
+        void run(std::size_t tasks, const F& f) {
+            if (workers.empty() || tasks < 2) {
+                for (std::size_t i = 0; i < tasks; ++i) {
+                    f(i);
+                }
+                return;
+            }
+            std::lock_guard<std::mutex> serial { running };
+            const job j { [](const void* ctx, std::size_t i) { (*static_cast<const F*>(ctx))(i); }, &f, tasks };
+            {
+                std::lock_guard<std::mutex> lock { mutex };
+                current = j;
+                next.store(0, std::memory_order_relaxed);
+                joined = 0;
+                ++generation;
+            }
+            wake.notify_all();
+            drain(j);
+
+            // Every worker takes part in every generation, so none can pick up `current` after returning
+            std::unique_lock<std::mutex> lock { mutex };
+            done.wait(lock, [this] { return joined == workers.size() && active == 0; });
+        }
+
+    private:
+        /** The work of one `run`. */
+        struct job {
+            void (*call)(const void*, std::size_t) = nullptr;
+            const void* ctx = nullptr;
+            std::size_t total = 0;
+        };
+
+        void drain(const job& j) {
+            for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < j.total; ) {
+                j.call(j.ctx, i);
+            }
+        }
+
+        void work() {
+            std::size_t seen = 0;
+            std::unique_lock<std::mutex> lock { mutex };
+            for (;;) {
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                // Taken together with the generation it belongs to
+                seen = generation;
+                const job j = current;
+                ++joined;
+                ++active;
+                lock.unlock();
+                drain(j);
+                lock.lock();
+                if (--active == 0 && joined == workers.size()) {
+                    done.notify_all();
+                }
+            }
+        }
+
+        std::vector<std::thread> workers;
+        std::mutex running;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        job current;
+        std::atomic<std::size_t> next { 0 };
+        std::size_t generation = 0;
+        std::size_t joined = 0;
+        unsigned active = 0;
+        bool stopping = false;
+    };
+
+    /** Is `E` usable as the executor argument of the parallel functions? */
+    template <typename E>
+    constexpr bool is_executor_v = std::is_same_v<std::decay_t<E>, thread_pool>
+#if defined(__cpp_lib_execution) && __has_include(<execution>)
+                                   || std::is_execution_policy_v<std::decay_t<E>>
+#endif
+                                   ;
+
+    namespace detail {
+        constexpr std::size_t chunk_bytes = std::size_t(1) << 18;
+
+        /** Chunk `k` covers `begin(k) ... end(k) - 1`, all but the first start on a cache line. */
+        struct chunking {
+            std::size_t n;
+            std::size_t head; // Elements before the first cache line boundary
+            std::size_t size;
+
+            std::size_t count() const noexcept {
+                return n == 0 ? 0 : (n <= head + size ? 1 : 1 + (n - head - 1) / size);
+            }
+            std::size_t begin(std::size_t k) const noexcept { return k == 0 ? 0 : std::min(n, head + k * size); }
+            std::size_t end(std::size_t k) const noexcept { return std::min(n, head + (k + 1) * size); }
+        };
+
+        /** Chunks aligned to the cache lines of `out`, which may be `nullptr` for reductions. */
+        template <typename T>
+        chunking chunks_for(const T* out, std::size_t n) noexcept {
+            const std::size_t size = std::max<std::size_t>(1, chunk_bytes / sizeof(T));
+            const auto addr = reinterpret_cast<std::uintptr_t>(out);
+            const std::size_t head = addr % sizeof(T) == 0 ? (cache_line - addr % cache_line) % cache_line / sizeof(T) : 0;
+            return { n, head, size };
+        }
+
+        /** Call `f(k)` for `k` in `0 ... chunks - 1`, using `exec`. */
+        template <typename Exec, typename F>
+        void for_chunks(Exec&& exec, std::size_t chunks, const F& f) {
+            if constexpr (std::is_same_v<std::decay_t<Exec>, thread_pool>) {
+                exec.run(chunks, f);
+            } else {
+                std::vector<std::size_t> index(chunks);
+                std::iota(index.begin(), index.end(), std::size_t(0));
+                std::for_each(std::forward<Exec>(exec), index.begin(), index.end(), [&f](std::size_t k) { f(k); });
+            }
+        }
+
+        /** Call `f(begin, count)` for each chunk of `n` elements, as seen from `out`. */
+        template <typename Exec, typename T, typename F>
+        void for_each_chunk(Exec&& exec, const T* out, std::size_t n, const F& f) {
+            const auto c = chunks_for(out, n);
+            if (c.count() < 2) {
+                f(std::size_t(0), n);
+            } else {
+                for_chunks(std::forward<Exec>(exec), c.count(), [&c, &f](std::size_t k) { f(c.begin(k), c.end(k) - c.begin(k)); });
+            }
+        }
+
+        /** Type per step chunk summaries are computed in. */
+        template <typename VT>
+        using summary_t = std::conditional_t<is_integral_v<VT>, widest_t, long double>;
+
+        /** Saturating after every element turns any starting value `s` into `clamp(s + sum, lo, hi)`. */
+        template <typename W>
+        struct step_summary {
+            W sum = 0;
+            W lo  = 0;
+            W hi  = 0;
+
+            constexpr W operator()(const W& s) const noexcept {
+                W r;
+                if constexpr (std::is_same_v<W, widest_t>) {
+                    r = wide_add(s, sum);
+                } else {
+                    r = s + sum;
+                }
+                return r < lo ? lo : (r > hi ? hi : r);
+            }
+        };
+
+        /** Summary of per step saturation to `MIN` ... `MAX` over `term(0) ... term(n - 1)`, for `n > 0`. */
+        template <typename VT, limit_t<VT> MIN, limit_t<VT> MAX, typename F>
+        step_summary<summary_t<VT>> summarize(std::size_t n, const F& term) noexcept {
+            using W = summary_t<VT>;
+            // After the first element any start value is within range, from there on the limits move like any
+            // other value
+            VT lo = static_cast<VT>(MIN);
+            VT hi = static_cast<VT>(MAX);
+            for (std::size_t i = 1; i < n; ++i) {
+                const VT t = term(i);
+                lo = saturating::add<VT, MIN, MAX>(lo, t);
+                hi = saturating::add<VT, MIN, MAX>(hi, t);
+            }
+            W sum = 0;
+            if constexpr (is_integral_v<VT>) {
+                sum = wide_sum<VT>(n, term);
+            } else {
+                for (std::size_t i = 0; i < n; ++i) {
+                    sum += static_cast<W>(term(i));
+                }
+            }
+            return { sum, static_cast<W>(lo), static_cast<W>(hi) };
+        }
+
+        /** Run `partial(begin, count)` for the chunks of `n` reduction elements of size `bytes`, in parallel. */
+        template <typename R, typename Exec, typename F>
+        std::vector<R> partials(Exec&& exec, std::size_t n, std::size_t bytes, const F& partial) {
+            const chunking c { n, 0, std::max<std::size_t>(1, chunk_bytes / bytes) };
+            std::vector<R> out(c.count());
+            for_chunks(std::forward<Exec>(exec), c.count(), [&](std::size_t k) { out[k] = partial(c.begin(k), c.end(k) - c.begin(k)); });
+            return out;
+        }
+    } // namespace detail
+
+    /** Parallel version of the bulk `add`. */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename Exec,
+              typename A,
+              typename B>
+    inline std::enable_if_t<is_executor_v<Exec>>
+    add(Exec&& exec, const A* a, const B* b, T* out, std::size_t n) {
+        detail::for_each_chunk(std::forward<Exec>(exec), out, n, [=](std::size_t i, std::size_t len) {
+            saturating::add<T, MIN, MAX>(a + i, b + i, out + i, len);
+        });
+    }
+
+    /** Parallel version of the bulk `subtract`. */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename Exec,
+              typename A,
+              typename B>
+    inline std::enable_if_t<is_executor_v<Exec>>
+    subtract(Exec&& exec, const A* a, const B* b, T* out, std::size_t n) {
+        detail::for_each_chunk(std::forward<Exec>(exec), out, n, [=](std::size_t i, std::size_t len) {
+            saturating::subtract<T, MIN, MAX>(a + i, b + i, out + i, len);
+        });
+    }
+
+    /** Parallel version of the bulk `multiply`. */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename Exec,
+              typename A,
+              typename B>
+    inline std::enable_if_t<is_executor_v<Exec>>
+    multiply(Exec&& exec, const A* a, const B* b, T* out, std::size_t n) {
+        detail::for_each_chunk(std::forward<Exec>(exec), out, n, [=](std::size_t i, std::size_t len) {
+            saturating::multiply<T, MIN, MAX>(a + i, b + i, out + i, len);
+        });
+    }
+
+    /** Parallel version of the bulk `divide`. */
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename Exec,
+              typename A,
+              typename B>
+    inline std::enable_if_t<is_executor_v<Exec>>
+    divide(Exec&& exec, const A* a, const B* b, T* out, std::size_t n) {
+        detail::for_each_chunk(std::forward<Exec>(exec), out, n, [=](std::size_t i, std::size_t len) {
+            saturating::divide<T, MIN, MAX>(a + i, b + i, out + i, len);
+        });
+    }
+
+    /** Parallel version of the bulk `divide` by a precomputed divisor. */
+    template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename Exec>
+    inline std::enable_if_t<is_executor_v<Exec>>
+    divide(Exec&& exec, const T* a, const divider<T, MIN, MAX>& d, T* out, std::size_t n) {
+        detail::for_each_chunk(std::forward<Exec>(exec), out, n, [=, &d](std::size_t i, std::size_t len) {
+            saturating::divide(a + i, d, out + i, len);
+        });
+    }
+
+    /** Parallel version of `scale_buffer`. */
+    template <typename Dst, typename Exec, typename Src>
+    inline std::enable_if_t<is_executor_v<Exec>>
+    scale_buffer(Exec&& exec, const Src* in, Dst* out, std::size_t n) {
+        detail::for_each_chunk(std::forward<Exec>(exec), out, n, [=](std::size_t i, std::size_t len) {
+            saturating::scale_buffer<Dst>(in + i, out + i, len);
+        });
+    }
+
+    /** Parallel version of `accumulate`. */
+    template <typename T, typename Exec, typename V>
+    inline std::enable_if_t<is_executor_v<Exec>, T>
+    accumulate(Exec&& exec, const V* x, std::size_t n, const T& init = T{}, reduction mode = reduction::automatic) {
+        using R = range_of<T>;
+        using VT = typename R::value_type;
+        constexpr auto MIN = R::min_val;
+        constexpr auto MAX = R::max_val;
+
+        if constexpr (detail::integral_v<T, V>) {
+            if (mode == reduction::once || (mode == reduction::automatic && detail::once_is_per_step<V, VT, MIN, MAX>(detail::value_of(init)))) {
+                const auto parts = detail::partials<detail::widest_t>(std::forward<Exec>(exec), n, sizeof(V), [x](std::size_t i, std::size_t len) {
+                    return detail::wide_sum<typename range_of<V>::value_type>(len, [x0 = x + i](std::size_t j) { return detail::value_of(x0[j]); });
+                });
+                auto total = static_cast<detail::widest_t>(detail::value_of(init));
+                for (const auto& p : parts) {
+                    total = detail::wide_add(total, p);
+                }
+                return static_cast<T>(detail::from_wide<VT, MIN, MAX>(total));
+            }
+        }
+        using W = detail::summary_t<VT>;
+        const auto parts = detail::partials<detail::step_summary<W>>(std::forward<Exec>(exec), n, sizeof(V), [x](std::size_t i, std::size_t len) {
+            return detail::summarize<VT, MIN, MAX>(len, [x0 = x + i](std::size_t j) { return static_cast<VT>(detail::value_of(x0[j])); });
+        });
+        auto s = static_cast<W>(detail::value_of(init));
+        for (const auto& p : parts) {
+            s = p(s);
+        }
+        return static_cast<T>(static_cast<VT>(s));
+    }
+
+    /** Parallel version of `dot`. */
+    template <typename T, typename Exec, typename A, typename B>
+    inline std::enable_if_t<is_executor_v<Exec>, T>
+    dot(Exec&& exec, const A* a, const B* b, std::size_t n, const T& init = T{}, reduction mode = reduction::automatic) {
+        using R = range_of<T>;
+        using VT = typename R::value_type;
+        constexpr auto MIN = R::min_val;
+        constexpr auto MAX = R::max_val;
+        constexpr std::size_t bytes = sizeof(A) > sizeof(B) ? sizeof(A) : sizeof(B);
+
+        if constexpr (detail::integral_v<T, A, B>) {
+            constexpr int sign = detail::sign_of_v<A> * detail::sign_of_v<B>;
+            const VT& s0 = detail::value_of(init);
+            const bool same = (sign > 0 && !(MIN > 0) && !is_negative(s0)) ||
+                              (sign < 0 && !is_negative(MAX) && !(s0 > 0));
+            if (mode == reduction::once || (mode == reduction::automatic && same)) {
+                using P = decltype(detail::product(detail::value_of(a[0]), detail::value_of(b[0])));
+                const auto parts = detail::partials<detail::widest_t>(std::forward<Exec>(exec), n, bytes, [a, b](std::size_t i, std::size_t len) {
+                    return detail::wide_sum<P>(len, [a0 = a + i, b0 = b + i](std::size_t j) {
+                        return detail::product(detail::value_of(a0[j]), detail::value_of(b0[j]));
+                    });
+                });
+                auto total = static_cast<detail::widest_t>(s0);
+                for (const auto& p : parts) {
+                    total = detail::wide_add(total, p);
+                }
+                return static_cast<T>(detail::from_wide<VT, MIN, MAX>(total));
+            }
+        }
+        using W = detail::summary_t<VT>;
+        const auto parts = detail::partials<detail::step_summary<W>>(std::forward<Exec>(exec), n, bytes, [a, b](std::size_t i, std::size_t len) {
+            return detail::summarize<VT, MIN, MAX>(len, [a0 = a + i, b0 = b + i](std::size_t j) {
+                return saturating::multiply<VT, MIN, MAX>(detail::value_of(a0[j]), detail::value_of(b0[j]));
+            });
+        });
+        auto s = static_cast<W>(detail::value_of(init));
+        for (const auto& p : parts) {
+            s = p(s);
+        }
+        return static_cast<T>(static_cast<VT>(s));
+    }
+
+    /**
+     * Parallel version of `inclusive_scan`. The chunks are summarized first, then scanned from the combined
+     * results of the chunks before them, which reads the input twice. Chunks are split by index, like those of
+     * the other reductions, so floating point results don't depend on the alignment of `out`.
+     */
+    template <typename T, typename Exec, typename V>
+    inline std::enable_if_t<is_executor_v<Exec>>
+    inclusive_scan(Exec&& exec, const V* x, T* out, std::size_t n, const T& init = T{}, reduction mode = reduction::automatic) {
+        using R = range_of<T>;
+        using VT = typename R::value_type;
+        constexpr auto MIN = R::min_val;
+        constexpr auto MAX = R::max_val;
+
+        const detail::chunking c { n, 0, std::max<std::size_t>(1, detail::chunk_bytes / sizeof(T)) };
+        if (c.count() < 2) {
+            saturating::inclusive_scan(x, out, n, init, mode);
+            return;
+        }
+        const auto summarize_all = [&](const auto& summary) {
+            using S = std::decay_t<decltype(summary(std::size_t(0), std::size_t(1)))>;
+            std::vector<S> parts(c.count() - 1);
+            detail::for_chunks(exec, parts.size(), [&](std::size_t k) { parts[k] = summary(c.begin(k), c.end(k) - c.begin(k)); });
+            return parts;
+        };
+
+        if constexpr (detail::integral_v<T, V>) {
+            if (mode == reduction::once || (mode == reduction::automatic && detail::once_is_per_step<V, VT, MIN, MAX>(detail::value_of(init)))) {
+                const auto parts = summarize_all([x](std::size_t i, std::size_t len) {
+                    return detail::wide_sum<typename range_of<V>::value_type>(len, [x0 = x + i](std::size_t j) { return detail::value_of(x0[j]); });
+                });
+                std::vector<detail::widest_t> start(c.count());
+                start[0] = static_cast<detail::widest_t>(detail::value_of(init));
+                for (std::size_t k = 1; k < start.size(); ++k) {
+                    start[k] = detail::wide_add(start[k - 1], parts[k - 1]);
+                }
+                detail::for_chunks(std::forward<Exec>(exec), c.count(), [&](std::size_t k) {
+                    detail::widest_t s = start[k];
+                    for (std::size_t i = c.begin(k); i < c.end(k); ++i) {
+                        s = detail::wide_add(s, static_cast<detail::widest_t>(detail::value_of(x[i])));
+                        out[i] = static_cast<T>(detail::from_wide<VT, MIN, MAX>(s));
+                    }
+                });
+                return;
+            }
+        }
+        using W = detail::summary_t<VT>;
+        const auto parts = summarize_all([x](std::size_t i, std::size_t len) {
+            return detail::summarize<VT, MIN, MAX>(len, [x0 = x + i](std::size_t j) { return static_cast<VT>(detail::value_of(x0[j])); });
+        });
+        std::vector<VT> start(c.count());
+        start[0] = detail::value_of(init);
+        for (std::size_t k = 1; k < start.size(); ++k) {
+            start[k] = static_cast<VT>(parts[k - 1](static_cast<W>(start[k - 1])));
+        }
+        detail::for_chunks(std::forward<Exec>(exec), c.count(), [&](std::size_t k) {
+            saturating::inclusive_scan(x + c.begin(k), out + c.begin(k), c.end(k) - c.begin(k), static_cast<T>(start[k]), reduction::per_step);
+        });
+    }
+
+#ifdef __cpp_lib_span
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename Exec,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              std::size_t EO>
+    inline std::enable_if_t<is_executor_v<Exec> && !std::is_const_v<T>>
+    add(Exec&& exec, std::span<A, EA> a, std::span<B, EB> b, std::span<T, EO> out) {
+        add<T, MIN, MAX>(std::forward<Exec>(exec), a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename Exec,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              std::size_t EO>
+    inline std::enable_if_t<is_executor_v<Exec> && !std::is_const_v<T>>
+    subtract(Exec&& exec, std::span<A, EA> a, std::span<B, EB> b, std::span<T, EO> out) {
+        subtract<T, MIN, MAX>(std::forward<Exec>(exec), a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename Exec,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              std::size_t EO>
+    inline std::enable_if_t<is_executor_v<Exec> && !std::is_const_v<T>>
+    multiply(Exec&& exec, std::span<A, EA> a, std::span<B, EB> b, std::span<T, EO> out) {
+        multiply<T, MIN, MAX>(std::forward<Exec>(exec), a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T,
+              limit_t<T> MIN = default_min_v<T>,
+              limit_t<T> MAX = default_max_v<T>,
+              typename Exec,
+              typename A, std::size_t EA,
+              typename B, std::size_t EB,
+              std::size_t EO>
+    inline std::enable_if_t<is_executor_v<Exec> && !std::is_const_v<T>>
+    divide(Exec&& exec, std::span<A, EA> a, std::span<B, EB> b, std::span<T, EO> out) {
+        divide<T, MIN, MAX>(std::forward<Exec>(exec), a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T, limit_t<T> MIN, limit_t<T> MAX,
+              typename Exec,
+              typename A, std::size_t EA,
+              std::size_t EO>
+    inline std::enable_if_t<is_executor_v<Exec> && !std::is_const_v<T> && std::is_same_v<std::remove_const_t<A>, T>>
+    divide(Exec&& exec, std::span<A, EA> a, const divider<T, MIN, MAX>& d, std::span<T, EO> out) {
+        divide(std::forward<Exec>(exec), static_cast<const T*>(a.data()), d, out.data(), std::min(a.size(), out.size()));
+    }
+
+    template <typename Dst, typename Exec, typename Src, std::size_t ES, std::size_t ED>
+    inline std::enable_if_t<is_executor_v<Exec> && !std::is_const_v<Dst>>
+    scale_buffer(Exec&& exec, std::span<Src, ES> in, std::span<Dst, ED> out) {
+        scale_buffer<Dst>(std::forward<Exec>(exec), static_cast<const std::remove_const_t<Src>*>(in.data()), out.data(), std::min(in.size(), out.size()));
+    }
+
+    template <typename T, typename Exec, typename V, std::size_t E>
+    inline std::enable_if_t<is_executor_v<Exec>, T>
+    accumulate(Exec&& exec, std::span<V, E> x, const T& init = T{}, reduction mode = reduction::automatic) {
+        return saturating::accumulate<T>(std::forward<Exec>(exec), static_cast<const std::remove_const_t<V>*>(x.data()), x.size(), init, mode);
+    }
+
+    template <typename T, typename Exec, typename A, typename B, std::size_t EA, std::size_t EB>
+    inline std::enable_if_t<is_executor_v<Exec>, T>
+    dot(Exec&& exec, std::span<A, EA> a, std::span<B, EB> b, const T& init = T{}, reduction mode = reduction::automatic) {
+        return saturating::dot<T>(std::forward<Exec>(exec), static_cast<const std::remove_const_t<A>*>(a.data()),
+                                  static_cast<const std::remove_const_t<B>*>(b.data()), std::min(a.size(), b.size()), init, mode);
+    }
+
+    template <typename T, typename Exec, typename V, std::size_t EX, std::size_t EO>
+    inline std::enable_if_t<is_executor_v<Exec> && !std::is_const_v<T>>
+    inclusive_scan(Exec&& exec, std::span<V, EX> x, std::span<T, EO> out, const T& init = T{}, reduction mode = reduction::automatic) {
+        saturating::inclusive_scan(std::forward<Exec>(exec), static_cast<const std::remove_const_t<V>*>(x.data()), out.data(),
+                                   std::min(x.size(), out.size()), init, mode);
+    }
+#endif // __cpp_lib_span
+} // namespace saturating
@@ -0,0 +1,219 @@
+/**@file
+ * @brief Saturating pixel format conversion.
+ *
+ * `saturating::convert` maps one or more source planes onto destination planes of another element type in a
+ * single pass: scale from the source range to the destination range (like `scale_from`), then an optional
+ * gain and offset in destination units, saturated once. A `plane` describes strided rows of samples, so a
+ * plane can be a channel of an interleaved image just as well:
+ *
+ *     using unit_t = saturating::type<float, 0, 1>;
+ *     const auto rgba = saturating::interleaved<4>(pixels, width, height);     // uint8_t RGBA8
+ *     saturating::convert(rgba, std::array{ r, g, b, a });                     // uint8_t => unit_t planes
+ *
+ * Frames are processed in tiles of rows sized to fit L2, with all planes of a tile converted before moving on,
+ * so deinterleaving or interleaving reads and writes the memory once. Large contiguous destinations are written
+ * with non-temporal stores, which keeps the frame from evicting the rest of the cache.
+ *
+ * Without gain and offset integral conversions are exact (see `scale.hpp`), otherwise the map is computed in
+ * floating point and rounded to integers like the functions do.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "./utilities.hpp"
+#include "./scale.hpp"
+#include "./types.hpp"
+#include "./simd.hpp"
+
+namespace saturating {
+    /**
+     * `height` rows of `width` samples: sample `x` of row `y` is `data[y * stride + x * step]`, in elements.
+     */
+    template <typename T>
+    struct plane {
+        T*             data   = nullptr;
+        std::size_t    width  = 0;
+        std::size_t    height = 0;
+        std::ptrdiff_t stride = 0;
+        std::ptrdiff_t step   = 1;
+
+        /** Row `y`. */
+        constexpr T* row(std::size_t y) const noexcept { return data + static_cast<std::ptrdiff_t>(y) * stride; }
+
+        /** Sample `x` of row `y`. */
+        constexpr T& operator()(std::size_t x, std::size_t y) const noexcept { return row(y)[static_cast<std::ptrdiff_t>(x) * step]; }
+
+        /** Are the samples of a row adjacent? */
+        constexpr bool contiguous() const noexcept { return step == 1; }
+
+        /** Implicit conversion to a read only plane. */
+        template <typename U = T, std::enable_if_t<!std::is_const_v<U>, int> = 0>
+        constexpr operator plane<const U>() const noexcept { return { data, width, height, stride, step }; }
+    };
+
+    /** Plane of `width` by `height` adjacent samples, rows padded to `stride` (defaults to `width`). */
+    template <typename T>
+    constexpr plane<T> planar(T* data, std::size_t width, std::size_t height, std::size_t stride = 0) noexcept {
+        return { data, width, height, static_cast<std::ptrdiff_t>(stride ? stride : width), 1 };
+    }
+
+    /**
+     * The `N` channel planes of an interleaved image (RGBA8 is `interleaved<4>(uint8_t*, ...)`).
+     * @param  stride Elements per row, defaults to `width * N`
+     */
+    template <std::size_t N, typename T>
+    constexpr std::array<plane<T>, N> interleaved(T* data, std::size_t width, std::size_t height, std::size_t stride = 0) noexcept {
+        std::array<plane<T>, N> out {};
+        for (std::size_t c = 0; c < N; ++c) {
+            out[c] = { data + c, width, height, static_cast<std::ptrdiff_t>(stride ? stride : width * N), static_cast<std::ptrdiff_t>(N) };
+        }
+        return out;
+    }
+
+    /** Settings of `convert`. */
+    struct conversion {
+        /** Applied after scaling to the destination range: `out = scaled * gain + offset`. */
+        double gain   = 1;
+        double offset = 0;
+
+        /** Rows of a tile fit this many bytes, the size of L2 on most cores. */
+        std::size_t tile_bytes = 256 * 1024;
+
+        /** Contiguous destinations of at least this many bytes use non-temporal stores. */
+        std::size_t stream_bytes = 4 * 1024 * 1024;
+    };
+
+    namespace detail {
+        /** Per sample map from `Src` to `Dst`: exact `scale` or a floating point affine function. */
+        template <typename Dst, typename Src>
+        class converter {
+            using S  = range_of<Src>;
+            using D  = range_of<Dst>;
+            using SV = typename S::value_type;
+            using DV = typename D::value_type;
+            // Single precision holds every 16 bit integer exactly
+            using F  = std::conditional_t<(sizeof(SV) <= 2 || std::is_same_v<SV, float>) && (sizeof(DV) <= 2 || std::is_same_v<DV, float>), float, double>;
+
+        public:
+            explicit converter(const conversion& c) noexcept
+                : exact{ c.gain == 1 && c.offset == 0 } {
+                const double k = (static_cast<double>(D::max_val) - static_cast<double>(D::min_val)) /
+                                 (static_cast<double>(S::max_val) - static_cast<double>(S::min_val));
+                m = static_cast<F>(k * c.gain);
+                b = static_cast<F>((static_cast<double>(D::min_val) - static_cast<double>(S::min_val) * k) * c.gain + c.offset);
+            }
+
+            bool is_exact() const noexcept { return exact; }
+
+            /** Exact `scale_from`. */
+            static Dst scale(const Src& v) noexcept {
+                return static_cast<Dst>(saturating::scale<DV, D::min_val, D::max_val, SV, S::min_val, S::max_val>(detail::value_of(v)));
+            }
+
+            /** With gain and offset, saturated once. */
+            Dst affine(const Src& v) const noexcept {
+                const F x = static_cast<F>(saturating::clamp(S::min_val, detail::value_of(v), S::max_val));
+                return static_cast<Dst>(type<DV, D::min_val, D::max_val>::clamp(x * m + b));
+            }
+
+        private:
+            bool exact;
+            F m {}, b {};
+        };
+
+        /** Store `f(x)` for `n` samples through `out`, with non-temporal stores when `stream` is set (x86). */
+        template <typename T, typename Fn>
+        inline void store_row(const plane<T>& out, T* row, std::size_t n, bool stream, const Fn& f) noexcept {
+            std::size_t x = 0;
+#ifdef SATURATING_SIMD_X86
+            constexpr std::size_t lanes = 16 / sizeof(T);
+            if constexpr (16 % sizeof(T) == 0 && std::is_trivially_copyable_v<T>) {
+                if (stream) {
+                    for (; x < n && reinterpret_cast<std::uintptr_t>(row + x) % 16 != 0; ++x) row[x] = f(x);
+                    for (; x + lanes <= n; x += lanes) {
+                        alignas(16) T chunk[lanes];
+                        for (std::size_t i = 0; i < lanes; ++i) chunk[i] = f(x + i);
+                        __m128i v;
+                        std::memcpy(&v, static_cast<const void*>(chunk), sizeof(v));
+                        _mm_stream_si128(reinterpret_cast<__m128i*>(row + x), v);
+                    }
+                }
+            }
+#else
+            (void)stream;
+#endif
+            if (out.contiguous()) {
+                for (; x < n; ++x) row[x] = f(x);
+            } else {
+                for (; x < n; ++x) row[static_cast<std::ptrdiff_t>(x) * out.step] = f(x);
+            }
+        }
+
+        template <typename Dst, typename Src, std::size_t N, typename Get>
+        inline void convert_tiles(const std::array<plane<const Src>, N>& in, const std::array<plane<Dst>, N>& out,
+                                  const conversion& c, const Get& get) noexcept {
+            const std::size_t width  = out[0].width;
+            const std::size_t height = out[0].height;
+            const std::size_t row_bytes = width * N * (sizeof(Src) + sizeof(Dst));
+            const std::size_t rows = row_bytes ? std::max<std::size_t>(1, c.tile_bytes / row_bytes) : height;
+            const bool stream = out[0].contiguous() && width * height * N * sizeof(Dst) >= c.stream_bytes;
+
+            for (std::size_t y0 = 0; y0 < height; y0 += rows) {
+                const std::size_t y1 = std::min(height, y0 + rows);
+                for (std::size_t p = 0; p < N; ++p) {
+                    const plane<const Src>& src = in[p];
+                    const plane<Dst>& dst = out[p];
+                    for (std::size_t y = y0; y < y1; ++y) {
+                        const Src* s = src.row(y);
+                        store_row(dst, dst.row(y), width, stream && dst.contiguous(),
+                                  [&](std::size_t x) { return get(s[static_cast<std::ptrdiff_t>(x) * src.step]); });
+                    }
+                }
+            }
+#ifdef SATURATING_SIMD_X86
+            if (stream) _mm_sfence();
+#endif
+        }
+    } // namespace detail
+
+    /**
+     * Convert `N` planes in one pass: `out[p](x, y) = scale(in[p](x, y)) * gain + offset`, saturated to the
+     * range of `Dst`. All planes have the size of `out[0]`, which they may not overlap.
+     * @param  in  Source planes, of a saturating type or plain arithmetic type (using its full range)
+     * @param  out Destination planes
+     * @param  c   Gain, offset and the tiling and streaming thresholds
+     */
+    template <typename Dst, typename Src, std::size_t N>
+    inline void convert(const std::array<plane<const Src>, N>& in, const std::array<plane<Dst>, N>& out, const conversion& c = {}) noexcept {
+        static_assert(N > 0, "Nothing to convert");
+        const detail::converter<Dst, Src> map { c };
+        if (map.is_exact()) {
+            detail::convert_tiles(in, out, c, [](const Src& v) { return detail::converter<Dst, Src>::scale(v); });
+        } else {
+            detail::convert_tiles(in, out, c, [&map](const Src& v) { return map.affine(v); });
+        }
+    }
+
+    /** `convert` with writable source planes. */
+    template <typename Dst, typename Src, std::size_t N>
+    inline std::enable_if_t<!std::is_const_v<Src>> convert(const std::array<plane<Src>, N>& in, const std::array<plane<Dst>, N>& out, const conversion& c = {}) noexcept {
+        std::array<plane<const Src>, N> src {};
+        for (std::size_t p = 0; p < N; ++p) src[p] = in[p];
+        convert(src, out, c);
+    }
+
+    /** Convert a single plane, see the `N` plane `convert`. */
+    template <typename Dst, typename Src>
+    inline void convert(const plane<Src>& in, const plane<Dst>& out, const conversion& c = {}) noexcept {
+        convert(std::array<plane<const Src>, 1>{ in }, std::array<plane<Dst>, 1>{ out }, c);
+    }
+} // namespace saturating
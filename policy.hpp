@@ -0,0 +1,56 @@
+/**@file
+ * @brief What a `saturating::type` does when a value saturates.
+ *
+ * The fourth template parameter of `saturating::type<T, MIN, MAX, P>` picks one of these policies:
+ * - `policy::saturate` (the default) clamps silently. It adds nothing to the generated code.
+ * - `policy::trap` stops the program (`__builtin_trap`) at the first saturation.
+ * - `policy::debug_trap` is `trap` without `NDEBUG` and `saturate` with it, so release builds of the same code
+ *   are exactly as fast as with plain saturating types.
+ * - `policy::callback<F>` calls `void F(stats::op, stats::direction)` for every saturation and clamps, for logging
+ *   or counting clipping in load tests without stopping them. It needs `SATURATING_CALLBACKS` defined (before
+ *   including any of the saturating headers, for every translation unit): the operators are declared `pure`
+ *   otherwise, and the compiler would be free to drop or merge calls of a hook with side effects.
+ *
+ * Checked policies (`trap`, `callback`) detect saturation by working out the exact result of every operation
+ * next to the saturated one, which costs about as much again. A saturation during constant evaluation doesn't
+ * compile with them, which turns `constexpr` values that would clip into compile time errors.
+ *
+ * Policies only apply to operations of the type itself (operators, `add` and friends, `from`, `clamp`); the free
+ * functions and bulk kernels always saturate silently.
+ */
+
+#pragma once
+
+#include "./stats.hpp"
+
+namespace saturating::policy {
+    /** Clamp to `MIN` ... `MAX` silently. */
+    struct saturate {
+        static constexpr bool checked = false;
+    };
+
+    /** Stop the program at the first saturation. */
+    struct trap {
+        static constexpr bool checked = true;
+
+        [[noreturn]] static void saturated(stats::op, stats::direction) noexcept { __builtin_trap(); }
+    };
+
+    /** `trap` in debug builds, `saturate` with `NDEBUG` defined. */
+#ifdef NDEBUG
+    using debug_trap = saturate;
+#else
+    using debug_trap = trap;
+#endif
+
+    /** Call `F` for every saturation, then clamp. Needs `SATURATING_CALLBACKS`. */
+    template <void (*F)(stats::op, stats::direction)>
+    struct callback {
+#if !defined(SATURATING_CALLBACKS) && !defined(SATURATING_STATS)
+        static_assert(F == nullptr, "policy::callback needs SATURATING_CALLBACKS defined before including saturating headers");
+#endif
+        static constexpr bool checked = true;
+
+        static void saturated(stats::op o, stats::direction d) noexcept { F(o, d); }
+    };
+} // namespace saturating::policy
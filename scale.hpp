@@ -0,0 +1,110 @@
+/**@file
+ * @brief Linear scaling between saturating ranges.
+ *
+ * `saturating::scale` maps `IN_MIN ... IN_MAX` onto `MIN ... MAX`: `IN_MIN` becomes `MIN`, `IN_MAX` becomes
+ * `MAX` and everything in between is rounded to the nearest value (halves away from zero). Input outside of
+ * the input range is clamped first, so the result can never overflow.
+ *
+ * For integral ranges the ratio is reduced and its divisor turned into a multiplier and shift at compile time,
+ * leaving a multiply, a multiply high and a few selects per value (which vectorizes well).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+#include "./divider.hpp"
+
+namespace saturating {
+    namespace detail {
+        template <typename TR>
+        constexpr TR gcd(TR a, TR b) noexcept {
+            while (b != 0) {
+                const TR t = a % b;
+                a = b;
+                b = t;
+            }
+            return a;
+        }
+
+        /** Smallest unsigned type of at least 32 bits that holds `v`, or `TX` itself. */
+        template <typename TX, TX v>
+        using uint_for_t = std::conditional_t<(v <= std::numeric_limits<uint32_t>::max()), uint32_t,
+                           std::conditional_t<(v <= std::numeric_limits<uint64_t>::max()), uint64_t,
+                                              TX>>;
+
+        /** Compile time constants for scaling one integral range onto another. */
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename U, limit_t<U> IN_MIN, limit_t<U> IN_MAX>
+        struct integral_scaler {
+            // Unsigned type holding both range widths
+            using TR = unsigned_t<fit_all_t<unsigned_t<limit_t<T>>, unsigned_t<limit_t<U>>>>;
+
+            using TUU = unsigned_t<limit_t<U>>;
+            using TUT = unsigned_t<limit_t<T>>;
+
+            static constexpr TR in_width  = static_cast<TUU>(static_cast<TUU>(IN_MAX) - static_cast<TUU>(IN_MIN));
+            static constexpr TR out_width = static_cast<TUT>(static_cast<TUT>(MAX) - static_cast<TUT>(MIN));
+            static constexpr TR common    = in_width == 0 || out_width == 0 ? TR(1) : gcd(in_width, out_width);
+
+            // Reduced ratio: out = MIN + round(x * num / den), for x = val - IN_MIN in 0 ... in_width
+            static constexpr TR num = out_width / common;
+            static constexpr TR den = in_width / common;
+
+            // Type for `x * num`, which is at most `in_width * num` (only 128 bit ranges can exceed `TX`)
+            using TX = unsigned_t<next_up_t<TR>>;
+            static constexpr TX max_product = static_cast<TX>(static_cast<TX>(in_width) * static_cast<TX>(num));
+            using TP = uint_for_t<TX, max_product>;
+
+            static constexpr invariant_divisor<TP> divisor { den == 0 ? TP(1) : static_cast<TP>(den) };
+        };
+    } // namespace detail
+
+    /**
+     * Scale `val` from range `IN_MIN ... IN_MAX` to `MIN ... MAX`.
+     * @param  val Input value
+     * @return     Scaled value of type `T`
+     */
+    template <typename T,
+              limit_t<T> MIN,
+              limit_t<T> MAX,
+              typename U,
+              limit_t<U> IN_MIN,
+              limit_t<U> IN_MAX>
+    constexpr base_t<T> __attribute__((pure))
+    scale(const U& val) noexcept {
+        using R = base_t<T>;
+        if constexpr (is_integral_v<R> && is_integral_v<U>) {
+            using S  = detail::integral_scaler<R, MIN, MAX, base_t<U>, IN_MIN, IN_MAX>;
+            using TP = typename S::TP;
+            if constexpr (S::in_width == 0) {
+                return MIN;
+            } else {
+                // Unsigned offset into the input range, after clamping to it
+                using TUU = typename S::TUU;
+                using TUT = typename S::TUT;
+                const TUU x = static_cast<TUU>(static_cast<TUU>(clamp(IN_MIN, val, IN_MAX)) - static_cast<TUU>(IN_MIN));
+                TP q = static_cast<TP>(static_cast<TP>(x) * static_cast<TP>(S::num));
+                if constexpr (S::den != 1) {
+                    q = S::divisor.rounded(q);
+                }
+                return static_cast<R>(static_cast<TUT>(static_cast<TUT>(MIN) + static_cast<TUT>(q)));
+            }
+        } else {
+            using TF = std::conditional_t<std::is_same_v<R, long double> || std::is_same_v<base_t<U>, long double>, long double, double>;
+            const TF x = static_cast<TF>(clamp(IN_MIN, val, IN_MAX)) - static_cast<TF>(IN_MIN);
+            const TF r = static_cast<TF>(MIN) + x * (static_cast<TF>(MAX) - static_cast<TF>(MIN)) /
+                                                    (static_cast<TF>(IN_MAX) - static_cast<TF>(IN_MIN));
+            if constexpr (is_integral_v<R>) {
+                return static_cast<R>(clamp(MIN, round<R>(r), MAX));
+            } else {
+                return static_cast<R>(r);
+            }
+        }
+    }
+} // namespace saturating
@@ -0,0 +1,177 @@
+/**@file
+ * @brief Sharded saturating counter, for many writers and few readers.
+ *
+ * `saturating::sharded_counter<S, N>` spreads updates over `N` cache line sized shards. A thread claims a shard
+ * of its own on first use (released again when it exits), so updates are a plain load and store to a cache line
+ * no other core writes to. Threads beyond the first `N` share one extra shard, updated with a compare-exchange.
+ *
+ * Each shard holds the exact, signed net sum of the updates made to it as `int64_t`, so one thread may add
+ * what another one subtracts from an unsigned counter. Reads add up all shards exactly and saturate the total
+ * to `MIN` ... `MAX` once. As the order of updates from different threads is unknown, the counter saturates
+ * the sum of all updates rather than after each of them. `saturated()` is sticky: once a read found the total
+ * outside of the limits, or a shard ran out of the range of `int64_t` (and saturated there), it stays set, so
+ * a reader can tell a total of exactly `MAX` from one that overflowed.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+
+namespace saturating {
+    namespace detail {
+        /**
+         * Shard slots `0 ... N - 1`, one per live thread. A slot is handed over with release / acquire ordering,
+         * so the next owner of a slot sees everything the previous one stored.
+         */
+        template <std::size_t N>
+        class thread_slots {
+            static inline std::atomic<bool> used[N] {};
+
+            struct claim {
+                std::size_t slot = N;
+
+                claim() noexcept {
+                    for (std::size_t i = 0; i < N; ++i) {
+                        if (!used[i].load(std::memory_order_relaxed) && !used[i].exchange(true, std::memory_order_acquire)) {
+                            slot = i;
+                            break;
+                        }
+                    }
+                }
+                ~claim() {
+                    if (slot < N) used[slot].store(false, std::memory_order_release);
+                }
+            };
+
+        public:
+            /** Slot of the calling thread, `N` if all are taken. */
+            static std::size_t get() noexcept {
+                thread_local const claim c;
+                return c.slot;
+            }
+        };
+    } // namespace detail
+
+    /**
+     * Saturating counter of many shards, merged on read.
+     * @tparam S `saturating::type` or integral type of the total
+     * @tparam N Number of shards, threads beyond this many share one
+     */
+    template <typename S, std::size_t N = 64>
+    class sharded_counter {
+        using T = typename range_of<S>::value_type;
+        static constexpr T MIN = range_of<S>::min_val;
+        static constexpr T MAX = range_of<S>::max_val;
+
+        static_assert(is_integral_v<T> && sizeof(T) < sizeof(detail::widest_t), "Shards are totalled exactly in `widest_t`");
+
+        /** Net sum of the updates to a shard, wide enough for the differences of any `T` up to 32 bits. */
+        using D = int64_t;
+
+        struct alignas(detail::cache_line) shard {
+            std::atomic<D> value { 0 };
+        };
+
+    public:
+        using value_type = S;
+
+        constexpr sharded_counter() noexcept = default;
+        sharded_counter(const sharded_counter&) = delete;
+        sharded_counter& operator=(const sharded_counter&) = delete;
+
+        /**
+         * Add `delta` to the shard of the calling thread.
+         * @param  delta Integer, may be negative
+         */
+        template <typename U>
+        std::enable_if_t<is_integral_v<typename range_of<U>::value_type>> add(const U& delta) noexcept { update<false>(delta); }
+
+        /**
+         * Subtract `delta` from the shard of the calling thread.
+         * @param  delta Integer, may be negative
+         */
+        template <typename U>
+        std::enable_if_t<is_integral_v<typename range_of<U>::value_type>> subtract(const U& delta) noexcept { update<true>(delta); }
+
+        sharded_counter& operator++() noexcept { add(1); return *this; }
+        sharded_counter& operator--() noexcept { add(-1); return *this; }
+
+        template <typename U>
+        sharded_counter& operator+=(const U& delta) noexcept { add(delta); return *this; }
+        template <typename U>
+        sharded_counter& operator-=(const U& delta) noexcept { subtract(delta); return *this; }
+
+        /** Sum of all updates so far, saturated to `MIN` ... `MAX`. */
+        S load() const noexcept {
+            // Exact, `N + 1` values of `D` can't overflow `widest_t`
+            detail::widest_t sum = shared.value.load(std::memory_order_relaxed);
+            for (const auto& s : shards) sum += s.value.load(std::memory_order_relaxed);
+            if (sum < static_cast<detail::widest_t>(MIN) || sum > static_cast<detail::widest_t>(MAX)) mark();
+            return static_cast<T>(sum < static_cast<detail::widest_t>(MIN) ? MIN : (sum > static_cast<detail::widest_t>(MAX) ? MAX : sum));
+        }
+        operator S() const noexcept { return load(); }
+
+        /** Has the total ever been outside of `MIN` ... `MAX` (or a shard out of the range of `int64_t`)? */
+        bool saturated() const noexcept {
+            (void)load();
+            return flag.value.load(std::memory_order_relaxed);
+        }
+
+        /** Back to zero, not saturated. Only while no thread updates the counter. */
+        void reset() noexcept {
+            for (auto& s : shards) s.value.store(0, std::memory_order_relaxed);
+            shared.value.store(0, std::memory_order_relaxed);
+            flag.value.store(false, std::memory_order_relaxed);
+        }
+
+    private:
+        template <bool Subtract, typename U>
+        void update(const U& delta) noexcept {
+            // Exact unless the shard leaves the range of `D`, where it saturates
+            const auto step = [&delta](D& r) {
+                const auto d = detail::value_of(delta);
+                const bool overflow = Subtract ? __builtin_sub_overflow(r, d, &r) : __builtin_add_overflow(r, d, &r);
+                if (overflow) {
+                    r = is_negative(d) != Subtract ? std::numeric_limits<D>::lowest() : std::numeric_limits<D>::max();
+                }
+                return overflow;
+            };
+            const std::size_t slot = detail::thread_slots<N>::get();
+            if (slot < N) {
+                // The only writer of this shard
+                std::atomic<D>& v = shards[slot].value;
+                D r = v.load(std::memory_order_relaxed);
+                if (step(r)) mark();
+                v.store(r, std::memory_order_relaxed);
+            } else {
+                D cur = shared.value.load(std::memory_order_relaxed);
+                D r;
+                bool overflow;
+                do {
+                    r = cur;
+                    overflow = step(r);
+                } while (!shared.value.compare_exchange_weak(cur, r, std::memory_order_relaxed));
+                if (overflow) mark();
+            }
+        }
+
+        void mark() const noexcept {
+            if (!flag.value.load(std::memory_order_relaxed)) flag.value.store(true, std::memory_order_relaxed);
+        }
+
+        struct alignas(detail::cache_line) sticky {
+            mutable std::atomic<bool> value { false };
+        };
+
+        shard shards[N] {};
+        shard shared {};
+        sticky flag {};
+    };
+} // namespace saturating
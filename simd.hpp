@@ -0,0 +1,518 @@
+/**@file
+ * @brief Thin per instruction set wrappers used by the bulk kernels.
+ *
+ * Each instruction set is a tag struct exposing the same small set of static functions, templated on the
+ * element type: `load`, `store`, `set1`, `adds`, `subs`, `min` and `max`. The bulk kernels are written once
+ * against this interface. Only the 8 and 16 bit fixed width integers are natively supported (`native_v<ISA, T>`),
+ * other types are handled by the (auto vectorizable) generic loops in `bulk.hpp`. The Q15 rounding multiply
+ * high `mulhrs` is available where `mulhrs_v<ISA>` (SSE2 needs SSSE3 enabled at compile time).
+ *
+ * For narrowing conversions `pack<D>` saturates two registers of signed elements twice as wide as `D` into one
+ * register of `D` (`packsswb`, `packusdw`, `vqmovn`, ... in element order), and `load_round` loads `float`s
+ * rounded to nearest even into 32 bit lanes (`pack_v<ISA, D, S>`).
+ *
+ * The x86 members carry a `target` attribute, so any of them can be instantiated regardless of the compiler
+ * flags, as long as the CPU actually supports the instruction set when called. `dispatch` builds on that to
+ * pick the instruction set at run time when `SATURATING_DISPATCH` is defined (for all translation units).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SATURATING_SIMD_X86 1
+#define SATURATING_TARGET(isa) __attribute__((target(isa)))
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SATURATING_SIMD_NEON 1
+#define SATURATING_TARGET(isa)
+#else
+#define SATURATING_TARGET(isa)
+#endif
+
+/** Glue between the instruction set wrappers and their callers, which must end up in the caller's target. */
+#define SATURATING_INLINE __attribute__((always_inline)) inline
+
+namespace saturating::simd {
+    /** Elements `pack<D>` narrows from: signed and twice as wide as `D`. */
+    template <typename D>
+    using pack_src_t = std::conditional_t<sizeof(D) == 1, int16_t, int32_t>;
+
+    /** No vector unit: `bytes == 0` makes the bulk kernels use their scalar loops only. */
+    struct none {
+        static constexpr const char* name = "none";
+        static constexpr std::size_t bytes = 0;
+        template <typename T> struct reg_type { using type = T; };
+    };
+
+#ifdef SATURATING_SIMD_X86
+    /** x86-64 baseline, the 8 and 16 bit `min`/`max` variants only introduced by SSE4.1 are emulated. */
+    struct sse2 {
+        static constexpr const char* name = "sse2";
+        static constexpr std::size_t bytes = 16;
+        template <typename T> struct reg_type { using type = __m128i; };
+
+        template <typename T> SATURATING_TARGET("sse2") static inline __m128i
+        load(const T* p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+
+        template <typename T> SATURATING_TARGET("sse2") static inline void
+        store(T* p, __m128i v) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+        template <typename T> SATURATING_TARGET("sse2") static inline __m128i
+        set1(T v) noexcept {
+            if constexpr (sizeof(T) == 1) return _mm_set1_epi8(static_cast<char>(v));
+            else                          return _mm_set1_epi16(static_cast<short>(v));
+        }
+
+        template <typename T> SATURATING_TARGET("sse2") static inline __m128i
+        adds(__m128i a, __m128i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm_adds_epi8(a, b)  : _mm_adds_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm_adds_epi16(a, b) : _mm_adds_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("sse2") static inline __m128i
+        subs(__m128i a, __m128i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm_subs_epi8(a, b)  : _mm_subs_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm_subs_epi16(a, b) : _mm_subs_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("sse2") static inline __m128i
+        min(__m128i a, __m128i b) noexcept {
+            if constexpr (sizeof(T) == 1) {
+                if constexpr (is_signed_v<T>) {
+                    const __m128i gt = _mm_cmpgt_epi8(a, b);
+                    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+                } else {
+                    return _mm_min_epu8(a, b);
+                }
+            } else {
+                if constexpr (is_signed_v<T>) {
+                    return _mm_min_epi16(a, b);
+                } else {
+                    return _mm_subs_epu16(a, _mm_subs_epu16(a, b));
+                }
+            }
+        }
+
+        template <typename T> SATURATING_TARGET("sse2") static inline __m128i
+        max(__m128i a, __m128i b) noexcept {
+            if constexpr (sizeof(T) == 1) {
+                if constexpr (is_signed_v<T>) {
+                    const __m128i gt = _mm_cmpgt_epi8(a, b);
+                    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+                } else {
+                    return _mm_max_epu8(a, b);
+                }
+            } else {
+                if constexpr (is_signed_v<T>) {
+                    return _mm_max_epi16(a, b);
+                } else {
+                    return _mm_adds_epu16(b, _mm_subs_epu16(a, b));
+                }
+            }
+        }
+
+        /** `(a * b + 2^14) >> 15`, only `-1 * -1` overflows `pmulhrsw` (to 0x8000) and is flipped to 0x7fff. */
+        template <typename T> SATURATING_TARGET("ssse3") static inline __m128i
+        mulhrs(__m128i a, __m128i b) noexcept {
+            const __m128i r = _mm_mulhrs_epi16(a, b);
+            return _mm_xor_si128(r, _mm_cmpeq_epi16(r, _mm_set1_epi16(std::numeric_limits<int16_t>::lowest())));
+        }
+
+        /** Saturate the signed elements of `a`, then `b`, to `D`. `packusdw` is emulated, it needs SSE4.1. */
+        template <typename D> SATURATING_TARGET("sse2") static inline __m128i
+        pack(__m128i a, __m128i b) noexcept {
+            if constexpr (sizeof(D) == 1) {
+                return is_signed_v<D> ? _mm_packs_epi16(a, b) : _mm_packus_epi16(a, b);
+            } else if constexpr (is_signed_v<D>) {
+                return _mm_packs_epi32(a, b);
+            } else {
+                // Drop negative values, then shift to the signed range and back
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i offset = _mm_set1_epi32(32768);
+                a = _mm_sub_epi32(_mm_and_si128(a, _mm_cmpgt_epi32(a, zero)), offset);
+                b = _mm_sub_epi32(_mm_and_si128(b, _mm_cmpgt_epi32(b, zero)), offset);
+                return _mm_xor_si128(_mm_packs_epi32(a, b), _mm_set1_epi16(std::numeric_limits<int16_t>::lowest()));
+            }
+        }
+
+        /** `float`s rounded to nearest even (the default rounding mode), clamped to +-2^16 and NaN taken as 0. */
+        SATURATING_TARGET("sse2") static inline __m128i
+        load_round(const float* p) noexcept {
+            const __m128 lim = _mm_set1_ps(65536.0f);
+            __m128 v = _mm_loadu_ps(p);
+            v = _mm_and_ps(v, _mm_cmpord_ps(v, v));
+            return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(v, _mm_sub_ps(_mm_setzero_ps(), lim)), lim));
+        }
+    };
+
+    /** SSE4.1 adds the signed 8 and unsigned 16 bit `min`/`max` SSE2 lacks, the rest is inherited. */
+    struct sse41 : sse2 {
+        static constexpr const char* name = "sse4.1";
+
+        template <typename T> SATURATING_TARGET("sse4.1") static inline __m128i
+        min(__m128i a, __m128i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm_min_epi8(a, b)  : _mm_min_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm_min_epi16(a, b) : _mm_min_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("sse4.1") static inline __m128i
+        max(__m128i a, __m128i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm_max_epi8(a, b)  : _mm_max_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm_max_epi16(a, b) : _mm_max_epu16(a, b);
+        }
+
+        template <typename D> SATURATING_TARGET("sse4.1") static inline __m128i
+        pack(__m128i a, __m128i b) noexcept {
+            if constexpr (std::is_same_v<D, uint16_t>) return _mm_packus_epi32(a, b);
+            else                                       return sse2::pack<D>(a, b);
+        }
+    };
+
+    struct avx2 {
+        static constexpr const char* name = "avx2";
+        static constexpr std::size_t bytes = 32;
+        template <typename T> struct reg_type { using type = __m256i; };
+
+        template <typename T> SATURATING_TARGET("avx2") static inline __m256i
+        load(const T* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+        template <typename T> SATURATING_TARGET("avx2") static inline void
+        store(T* p, __m256i v) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+
+        template <typename T> SATURATING_TARGET("avx2") static inline __m256i
+        set1(T v) noexcept {
+            if constexpr (sizeof(T) == 1) return _mm256_set1_epi8(static_cast<char>(v));
+            else                          return _mm256_set1_epi16(static_cast<short>(v));
+        }
+
+        template <typename T> SATURATING_TARGET("avx2") static inline __m256i
+        adds(__m256i a, __m256i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm256_adds_epi8(a, b)  : _mm256_adds_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm256_adds_epi16(a, b) : _mm256_adds_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("avx2") static inline __m256i
+        subs(__m256i a, __m256i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm256_subs_epi8(a, b)  : _mm256_subs_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm256_subs_epi16(a, b) : _mm256_subs_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("avx2") static inline __m256i
+        min(__m256i a, __m256i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm256_min_epi8(a, b)  : _mm256_min_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("avx2") static inline __m256i
+        max(__m256i a, __m256i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm256_max_epi8(a, b)  : _mm256_max_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("avx2") static inline __m256i
+        mulhrs(__m256i a, __m256i b) noexcept {
+            const __m256i r = _mm256_mulhrs_epi16(a, b);
+            return _mm256_xor_si256(r, _mm256_cmpeq_epi16(r, _mm256_set1_epi16(std::numeric_limits<int16_t>::lowest())));
+        }
+
+        template <typename D> SATURATING_TARGET("avx2") static inline __m256i
+        pack(__m256i a, __m256i b) noexcept {
+            __m256i r;
+            if constexpr (sizeof(D) == 1) r = is_signed_v<D> ? _mm256_packs_epi16(a, b) : _mm256_packus_epi16(a, b);
+            else                          r = is_signed_v<D> ? _mm256_packs_epi32(a, b) : _mm256_packus_epi32(a, b);
+            // The packs work per 128 bit lane, leaving the 64 bit quarters in the order a0 b0 a1 b1
+            return _mm256_permute4x64_epi64(r, 0xd8);
+        }
+
+        SATURATING_TARGET("avx2") static inline __m256i
+        load_round(const float* p) noexcept {
+            const __m256 lim = _mm256_set1_ps(65536.0f);
+            __m256 v = _mm256_loadu_ps(p);
+            v = _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+            return _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(v, _mm256_sub_ps(_mm256_setzero_ps(), lim)), lim));
+        }
+    };
+
+    // The AVX-512 intrinsics pass `_mm512_undefined_*()` as the unused source of unmasked operations, which GCC 12
+    // reports as maybe uninitialized wherever they are inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    struct avx512 {
+        static constexpr const char* name = "avx512bw";
+        static constexpr std::size_t bytes = 64;
+        template <typename T> struct reg_type { using type = __m512i; };
+
+        template <typename T> SATURATING_TARGET("avx512bw") static inline __m512i
+        load(const T* p) noexcept { return _mm512_loadu_si512(reinterpret_cast<const void*>(p)); }
+
+        template <typename T> SATURATING_TARGET("avx512bw") static inline void
+        store(T* p, __m512i v) noexcept { _mm512_storeu_si512(reinterpret_cast<void*>(p), v); }
+
+        template <typename T> SATURATING_TARGET("avx512bw") static inline __m512i
+        set1(T v) noexcept {
+            if constexpr (sizeof(T) == 1) return _mm512_set1_epi8(static_cast<char>(v));
+            else                          return _mm512_set1_epi16(static_cast<short>(v));
+        }
+
+        template <typename T> SATURATING_TARGET("avx512bw") static inline __m512i
+        adds(__m512i a, __m512i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm512_adds_epi8(a, b)  : _mm512_adds_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm512_adds_epi16(a, b) : _mm512_adds_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("avx512bw") static inline __m512i
+        subs(__m512i a, __m512i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm512_subs_epi8(a, b)  : _mm512_subs_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm512_subs_epi16(a, b) : _mm512_subs_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("avx512bw") static inline __m512i
+        min(__m512i a, __m512i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm512_min_epi8(a, b)  : _mm512_min_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm512_min_epi16(a, b) : _mm512_min_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("avx512bw") static inline __m512i
+        max(__m512i a, __m512i b) noexcept {
+            if constexpr (sizeof(T) == 1) return is_signed_v<T> ? _mm512_max_epi8(a, b)  : _mm512_max_epu8(a, b);
+            else                          return is_signed_v<T> ? _mm512_max_epi16(a, b) : _mm512_max_epu16(a, b);
+        }
+
+        template <typename T> SATURATING_TARGET("avx512bw") static inline __m512i
+        mulhrs(__m512i a, __m512i b) noexcept {
+            const __m512i r = _mm512_mulhrs_epi16(a, b);
+            const __mmask32 m = _mm512_cmpeq_epi16_mask(r, _mm512_set1_epi16(std::numeric_limits<int16_t>::lowest()));
+            return _mm512_mask_blend_epi16(m, r, _mm512_set1_epi16(std::numeric_limits<int16_t>::max()));
+        }
+
+        template <typename D> SATURATING_TARGET("avx512bw") static inline __m512i
+        pack(__m512i a, __m512i b) noexcept {
+            __m512i r;
+            if constexpr (sizeof(D) == 1) r = is_signed_v<D> ? _mm512_packs_epi16(a, b) : _mm512_packus_epi16(a, b);
+            else                          r = is_signed_v<D> ? _mm512_packs_epi32(a, b) : _mm512_packus_epi32(a, b);
+            // Per 128 bit lane as well: a0 b0 a1 b1 a2 b2 a3 b3
+            return _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7), r);
+        }
+
+        SATURATING_TARGET("avx512bw") static inline __m512i
+        load_round(const float* p) noexcept {
+            const __m512 lim = _mm512_set1_ps(65536.0f);
+            __m512 v = _mm512_loadu_ps(p);
+            v = _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(v, v, _CMP_ORD_Q), v);
+            return _mm512_cvtps_epi32(_mm512_min_ps(_mm512_max_ps(v, _mm512_sub_ps(_mm512_setzero_ps(), lim)), lim));
+        }
+    };
+#pragma GCC diagnostic pop
+#endif // SATURATING_SIMD_X86
+
+#ifdef SATURATING_SIMD_NEON
+    struct neon {
+        static constexpr const char* name = "neon";
+        static constexpr std::size_t bytes = 16;
+        template <typename T> struct reg_type;
+
+        template <typename T> static inline typename reg_type<T>::type
+        load(const T* p) noexcept {
+            if constexpr (std::is_same_v<T, int8_t>)        return vld1q_s8(p);
+            else if constexpr (std::is_same_v<T, uint8_t>)  return vld1q_u8(p);
+            else if constexpr (std::is_same_v<T, int16_t>)  return vld1q_s16(p);
+            else if constexpr (std::is_same_v<T, uint16_t>) return vld1q_u16(p);
+            else                                            return vld1q_s32(p);
+        }
+
+        template <typename T> static inline void
+        store(T* p, typename reg_type<T>::type v) noexcept {
+            if constexpr (std::is_same_v<T, int8_t>)        vst1q_s8(p, v);
+            else if constexpr (std::is_same_v<T, uint8_t>)  vst1q_u8(p, v);
+            else if constexpr (std::is_same_v<T, int16_t>)  vst1q_s16(p, v);
+            else                                            vst1q_u16(p, v);
+        }
+
+        template <typename T> static inline typename reg_type<T>::type
+        set1(T v) noexcept {
+            if constexpr (std::is_same_v<T, int8_t>)        return vdupq_n_s8(v);
+            else if constexpr (std::is_same_v<T, uint8_t>)  return vdupq_n_u8(v);
+            else if constexpr (std::is_same_v<T, int16_t>)  return vdupq_n_s16(v);
+            else                                            return vdupq_n_u16(v);
+        }
+
+        template <typename T> static inline typename reg_type<T>::type
+        adds(typename reg_type<T>::type a, typename reg_type<T>::type b) noexcept {
+            if constexpr (std::is_same_v<T, int8_t>)        return vqaddq_s8(a, b);
+            else if constexpr (std::is_same_v<T, uint8_t>)  return vqaddq_u8(a, b);
+            else if constexpr (std::is_same_v<T, int16_t>)  return vqaddq_s16(a, b);
+            else                                            return vqaddq_u16(a, b);
+        }
+
+        template <typename T> static inline typename reg_type<T>::type
+        subs(typename reg_type<T>::type a, typename reg_type<T>::type b) noexcept {
+            if constexpr (std::is_same_v<T, int8_t>)        return vqsubq_s8(a, b);
+            else if constexpr (std::is_same_v<T, uint8_t>)  return vqsubq_u8(a, b);
+            else if constexpr (std::is_same_v<T, int16_t>)  return vqsubq_s16(a, b);
+            else                                            return vqsubq_u16(a, b);
+        }
+
+        template <typename T> static inline typename reg_type<T>::type
+        min(typename reg_type<T>::type a, typename reg_type<T>::type b) noexcept {
+            if constexpr (std::is_same_v<T, int8_t>)        return vminq_s8(a, b);
+            else if constexpr (std::is_same_v<T, uint8_t>)  return vminq_u8(a, b);
+            else if constexpr (std::is_same_v<T, int16_t>)  return vminq_s16(a, b);
+            else                                            return vminq_u16(a, b);
+        }
+
+        template <typename T> static inline typename reg_type<T>::type
+        max(typename reg_type<T>::type a, typename reg_type<T>::type b) noexcept {
+            if constexpr (std::is_same_v<T, int8_t>)        return vmaxq_s8(a, b);
+            else if constexpr (std::is_same_v<T, uint8_t>)  return vmaxq_u8(a, b);
+            else if constexpr (std::is_same_v<T, int16_t>)  return vmaxq_s16(a, b);
+            else                                            return vmaxq_u16(a, b);
+        }
+
+        /** `vqrdmulh` already saturates `-1 * -1`. */
+        template <typename T> static inline int16x8_t
+        mulhrs(int16x8_t a, int16x8_t b) noexcept { return vqrdmulhq_s16(a, b); }
+
+        template <typename D> static inline typename reg_type<D>::type
+        pack(typename reg_type<pack_src_t<D>>::type a, typename reg_type<pack_src_t<D>>::type b) noexcept {
+            if constexpr (std::is_same_v<D, int8_t>)        return vcombine_s8(vqmovn_s16(a), vqmovn_s16(b));
+            else if constexpr (std::is_same_v<D, uint8_t>)  return vcombine_u8(vqmovun_s16(a), vqmovun_s16(b));
+            else if constexpr (std::is_same_v<D, int16_t>)  return vcombine_s16(vqmovn_s32(a), vqmovn_s32(b));
+            else                                            return vcombine_u16(vqmovun_s32(a), vqmovun_s32(b));
+        }
+
+        /** `vcvtn` rounds to nearest even and takes NaN as 0 by itself. */
+        static inline int32x4_t
+        load_round(const float* p) noexcept {
+            const float32x4_t v = vmaxq_f32(vld1q_f32(p), vdupq_n_f32(-65536.0f));
+            return vcvtnq_s32_f32(vminq_f32(v, vdupq_n_f32(65536.0f)));
+        }
+    };
+    template <> struct neon::reg_type<int8_t>   { using type = int8x16_t; };
+    template <> struct neon::reg_type<uint8_t>  { using type = uint8x16_t; };
+    template <> struct neon::reg_type<int16_t>  { using type = int16x8_t; };
+    template <> struct neon::reg_type<uint16_t> { using type = uint16x8_t; };
+    template <> struct neon::reg_type<int32_t>  { using type = int32x4_t; };
+#endif // SATURATING_SIMD_NEON
+
+    /** Best instruction set enabled at compile time. */
+#if defined(SATURATING_SIMD_X86) && defined(__AVX512BW__)
+    using native = avx512;
+#elif defined(SATURATING_SIMD_X86) && defined(__AVX2__)
+    using native = avx2;
+#elif defined(SATURATING_SIMD_X86) && defined(__SSE4_1__)
+    using native = sse41;
+#elif defined(SATURATING_SIMD_X86) && defined(__SSE2__)
+    using native = sse2;
+#elif defined(SATURATING_SIMD_NEON)
+    using native = neon;
+#else
+    using native = none;
+#endif
+
+    template <typename ISA, typename T>
+    using reg_t = typename ISA::template reg_type<T>::type;
+
+    /** Number of `T` elements in one `ISA` register. */
+    template <typename ISA, typename T>
+    constexpr std::size_t lanes_v = ISA::bytes / sizeof(T);
+
+    /** Does `ISA` provide the Q15 rounding multiply high `mulhrs`? */
+    template <typename ISA>
+    constexpr bool mulhrs_v = ISA::bytes != 0
+#if defined(SATURATING_SIMD_X86) && !defined(__SSSE3__)
+                              && !std::is_same_v<ISA, sse2>
+#endif
+                              ;
+
+    /** Does `ISA` provide native saturating arithmetic for element type `T`? */
+    template <typename ISA, typename T>
+    constexpr bool native_v = ISA::bytes != 0 &&
+                              (std::is_same_v<T, int8_t>  || std::is_same_v<T, uint8_t> ||
+                               std::is_same_v<T, int16_t> || std::is_same_v<T, uint16_t>);
+
+    /** Can `ISA` narrow `S` (`int16_t`, `int32_t` or `float`) to `D` with `pack` and `load_round`? */
+    template <typename ISA, typename D, typename S>
+    constexpr bool pack_v = native_v<ISA, D> && sizeof(D) < sizeof(S) &&
+                            (std::is_same_v<S, int16_t> || std::is_same_v<S, int32_t> || std::is_same_v<S, float>);
+
+    /** Instruction sets kernels can be dispatched to at run time, ordered. */
+    enum class level { baseline, sse41, avx2, avx512 };
+
+    /** Level of `native`, what the compiler may use anyway. */
+#if defined(SATURATING_SIMD_X86) && defined(__AVX512BW__)
+    constexpr level native_level = level::avx512;
+#elif defined(SATURATING_SIMD_X86) && defined(__AVX2__)
+    constexpr level native_level = level::avx2;
+#elif defined(SATURATING_SIMD_X86) && defined(__SSE4_1__)
+    constexpr level native_level = level::sse41;
+#else
+    constexpr level native_level = level::baseline;
+#endif
+
+    /** Best level the running CPU supports, or `native_level` where there is nothing to detect. */
+    inline level cpu_level() noexcept {
+#ifdef SATURATING_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512bw")) return level::avx512;
+        if (__builtin_cpu_supports("avx2"))     return level::avx2;
+        if (__builtin_cpu_supports("sse4.1"))   return level::sse41;
+        return level::baseline;
+#else
+        return native_level;
+#endif
+    }
+
+    /**
+     * Kernel set `K` (a struct with `template <typename ISA> static R run(Args...)`) called with the best
+     * instruction set available. With `SATURATING_DISPATCH` defined on x86 that is chosen at run time: `call`
+     * goes through a function pointer, cached per kernel set, which starts out at a resolver replacing it on
+     * the first call. Otherwise `call` inlines `K::run<native>`.
+     */
+    template <typename K, typename Signature>
+    struct dispatch;
+
+    template <typename K, typename R, typename... Args>
+    struct dispatch<K, R(Args...)> {
+        using function = R (*)(Args...) noexcept;
+
+        static SATURATING_INLINE R call(Args... args) noexcept {
+#if defined(SATURATING_DISPATCH) && defined(SATURATING_SIMD_X86)
+            return kernel.load(std::memory_order_relaxed)(args...);
+#else
+            return K::template run<native>(args...);
+#endif
+        }
+
+#if defined(SATURATING_DISPATCH) && defined(SATURATING_SIMD_X86)
+        /** The kernel for level `l`, never below `native_level`. */
+        static function select(level l) noexcept {
+            if (l <= native_level)   return &run_native;
+            if (l == level::avx512)  return &run_avx512;
+            if (l == level::avx2)    return &run_avx2;
+            return &run_sse41;
+        }
+
+    private:
+        static R resolve(Args... args) noexcept {
+            const function f = select(cpu_level());
+            kernel.store(f, std::memory_order_relaxed);
+            return f(args...);
+        }
+
+        static R run_native(Args... args) noexcept { return K::template run<native>(args...); }
+        SATURATING_TARGET("sse4.1")   static R run_sse41(Args... args) noexcept { return K::template run<sse41>(args...); }
+        SATURATING_TARGET("avx2")     static R run_avx2(Args... args) noexcept { return K::template run<avx2>(args...); }
+        SATURATING_TARGET("avx512bw") static R run_avx512(Args... args) noexcept { return K::template run<avx512>(args...); }
+
+        static inline std::atomic<function> kernel{ &resolve };
+#endif
+    };
+} // namespace saturating::simd
@@ -0,0 +1,152 @@
+/**@file
+ * @brief Optional counters for how often values actually saturate.
+ *
+ * Define `SATURATING_STATS` (before including any of the saturating headers, for every translation unit) to
+ * count each saturation of the scalar `add`, `subtract`, `multiply` and `divide` functions, the operators of
+ * `saturating::type` using them and `saturating::type::clamp` / `from`, split by direction. The counters are
+ * relaxed atomics that are only touched when a value saturates, `stats::snapshot()` and `stats::reset()`
+ * export them. Constant evaluation is never counted, the bulk kernels are not instrumented.
+ *
+ * Without `SATURATING_STATS` all of this compiles to nothing.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "./utilities.hpp"
+
+/**
+ * Functions that may count saturations aren't free of side effects with `SATURATING_STATS`, so they can't be
+ * declared `pure` then. The same goes for `SATURATING_CALLBACKS`, for the hooks of `policy::callback`.
+ * `SATURATING_CONST` is `pure` as well: the arguments are passed by reference, and a `const` function may not
+ * read them, which GCC exploits by dropping the stores to temporary arguments.
+ */
+#if defined(SATURATING_STATS) || defined(SATURATING_CALLBACKS)
+#define SATURATING_CONST
+#define SATURATING_PURE
+#else
+#define SATURATING_CONST __attribute__((pure))
+#define SATURATING_PURE  __attribute__((pure))
+#endif
+
+namespace saturating {
+    namespace stats {
+        /** Is saturation counting compiled in? */
+#ifdef SATURATING_STATS
+        constexpr bool enabled = true;
+#else
+        constexpr bool enabled = false;
+#endif
+
+        enum class op : unsigned { add, subtract, multiply, divide, clamp, fma, lerp, abs_diff, pow, sqrt, shift_left };
+        enum class direction : unsigned { low, high };
+
+        constexpr std::size_t op_count = 11;
+
+        /** Saturation counts per operation and direction. */
+        struct counts {
+            std::uint64_t value[op_count][2] = {};
+
+            constexpr std::uint64_t operator()(op o, direction d) const noexcept {
+                return value[static_cast<unsigned>(o)][static_cast<unsigned>(d)];
+            }
+
+            /** Both directions of `o`. */
+            constexpr std::uint64_t operator()(op o) const noexcept {
+                return (*this)(o, direction::low) + (*this)(o, direction::high);
+            }
+
+            /** All operations and directions. */
+            constexpr std::uint64_t total() const noexcept {
+                std::uint64_t sum = 0;
+                for (const auto& v : value) sum += v[0] + v[1];
+                return sum;
+            }
+        };
+
+#ifdef SATURATING_STATS
+        namespace detail {
+            inline std::atomic<std::uint64_t> counters[op_count][2] {};
+        } // namespace detail
+#endif
+
+        /** Count one saturation (no-op without `SATURATING_STATS`). */
+        inline void record(op o, direction d) noexcept {
+#ifdef SATURATING_STATS
+            detail::counters[static_cast<unsigned>(o)][static_cast<unsigned>(d)].fetch_add(1, std::memory_order_relaxed);
+#else
+            (void)o;
+            (void)d;
+#endif
+        }
+
+        /** Current counts, all zero without `SATURATING_STATS`. */
+        inline counts snapshot() noexcept {
+            counts out;
+#ifdef SATURATING_STATS
+            for (std::size_t o = 0; o < op_count; ++o) {
+                for (std::size_t d = 0; d < 2; ++d) {
+                    out.value[o][d] = detail::counters[o][d].load(std::memory_order_relaxed);
+                }
+            }
+#endif
+            return out;
+        }
+
+        /** Set all counters to zero. */
+        inline void reset() noexcept {
+#ifdef SATURATING_STATS
+            for (auto& o : detail::counters) {
+                for (auto& d : o) {
+                    d.store(0, std::memory_order_relaxed);
+                }
+            }
+#endif
+        }
+    } // namespace stats
+
+    namespace detail {
+        /** `clamp`, comparing same type arguments directly (to the standard traits `__int128` isn't always integral). */
+        template <typename L, typename V, typename H>
+        constexpr auto clamp_same(const L& lo, const V& v, const H& hi) noexcept {
+            if constexpr (std::is_same_v<L, V> && std::is_same_v<V, H>) {
+                return v < lo ? lo : (hi < v ? hi : v);
+            } else {
+                return clamp(lo, v, hi);
+            }
+        }
+
+        /** `clamp(lo, v, hi)`, counting `v` being out of range as a saturation of `O`. */
+        template <stats::op O, typename L, typename V, typename H>
+        constexpr auto saturate(const L& lo, const V& v, const H& hi) noexcept {
+            const auto r = clamp_same(lo, v, hi);
+#ifdef SATURATING_STATS
+            if (!__builtin_is_constant_evaluated()) {
+                if (r < v) {
+                    stats::record(O, stats::direction::high);
+                } else if (v < r) {
+                    stats::record(O, stats::direction::low);
+                }
+            }
+#endif
+            return r;
+        }
+
+        /** Returns `overflow`, counting it as a saturation of `O` towards the upper limit if `high`. */
+        template <stats::op O>
+        constexpr bool overflowed(bool overflow, bool high) noexcept {
+#ifdef SATURATING_STATS
+            if (overflow && !__builtin_is_constant_evaluated()) {
+                stats::record(O, high ? stats::direction::high : stats::direction::low);
+            }
+#else
+            (void)high;
+#endif
+            return overflow;
+        }
+    } // namespace detail
+} // namespace saturating
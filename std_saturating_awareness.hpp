@@ -8,45 +8,60 @@
 
 #include "./forward_decl.hpp"
 
+/**
+ * `std::numeric_limits` for the saturating types, the one standard trait a library may specialize. The type
+ * categories (`std::is_integral` and friends) must not be; see `saturating::is_integral_v` and `saturating::traits`
+ * in `utilities.hpp` instead.
+ *
+ * The limits are those of the range, `MIN` ... `MAX`, the representation (digits, radix, exponents) that of `T`.
+ * Values never wrap (`is_modulo`) or trap, and as out of range results are clamped there's no infinity either.
+ */
 namespace std {
-    // Extend the standard type traits to handle the new sat types.
-    template <typename T, T _min, T _max>
-    class decay<saturating::type<T, _min, _max>> {
-    public:
-        using type = typename decay<T>::type;
-    };
-
-    template <typename T, T _min, T _max>
-    struct is_unsigned<saturating::type<T, _min, _max>> {
-        static constexpr decltype(auto) value = is_unsigned_v<T>;
-    };
+    template <typename T, auto MIN, auto MAX, typename P>
+    class numeric_limits<saturating::type<T, MIN, MAX, P>> {
+        using S = saturating::type<T, MIN, MAX, P>;
+        using B = numeric_limits<T>;
 
-    template <typename T, T _min, T _max>
-    struct is_signed<saturating::type<T, _min, _max>> {
-        static constexpr decltype(auto) value = is_signed_v<T>;
-    };
-
-    template <typename T, T _min, T _max>
-    struct is_integral<saturating::type<T, _min, _max>> {
-        static constexpr decltype(auto) value = is_integral_v<T>;
-    };
-
-    template <typename T, T _min, T _max>
-    struct is_floating_point<saturating::type<T, _min, _max>> {
-        static constexpr decltype(auto) value = is_floating_point_v<T>;
-    };
-
-    template <typename T, T _min, T _max>
-    struct is_arithmetic<saturating::type<T, _min, _max>> {
-        static constexpr decltype(auto) value = is_arithmetic_v<T>;
-    };
-
-    template <typename T, T _min, T _max>
-    class numeric_limits<saturating::type<T, _min, _max>> {
-        // TODO: implement the rest of: http://en.cppreference.com/w/cpp/types/numeric_limits
     public:
-        static constexpr std::decay_t<T> min()    noexcept { return _min; }
-        static constexpr std::decay_t<T> lowest() noexcept { return _min; }
-        static constexpr std::decay_t<T> max()    noexcept { return _max; }
+        static constexpr bool is_specialized    = true;
+        static constexpr bool is_signed         = B::is_signed;
+        static constexpr bool is_integer        = B::is_integer;
+        static constexpr bool is_exact          = B::is_exact;
+        static constexpr bool has_infinity      = false;
+        static constexpr bool has_quiet_NaN     = B::has_quiet_NaN;
+        static constexpr bool has_signaling_NaN = B::has_signaling_NaN;
+        static constexpr float_denorm_style has_denorm = B::has_denorm;
+        static constexpr bool has_denorm_loss   = B::has_denorm_loss;
+        static constexpr float_round_style round_style = B::round_style;
+        static constexpr bool is_iec559         = false;
+        static constexpr bool is_bounded        = true;
+        static constexpr bool is_modulo         = false;
+        static constexpr int  digits            = B::digits;
+        static constexpr int  digits10          = B::digits10;
+        static constexpr int  max_digits10      = B::max_digits10;
+        static constexpr int  radix             = B::radix;
+        static constexpr int  min_exponent      = B::min_exponent;
+        static constexpr int  min_exponent10    = B::min_exponent10;
+        static constexpr int  max_exponent      = B::max_exponent;
+        static constexpr int  max_exponent10    = B::max_exponent10;
+        static constexpr bool traps             = false;
+        static constexpr bool tinyness_before   = B::tinyness_before;
+
+        /** `MIN` for integral types, like `T` the smallest positive normal value for floating point types. */
+        static constexpr S min() noexcept {
+            if constexpr (is_integral_v<T>) {
+                return { static_cast<T>(MIN) };
+            } else {
+                return { B::min() };
+            }
+        }
+        static constexpr S lowest()        noexcept { return { static_cast<T>(MIN) }; }
+        static constexpr S max()           noexcept { return { static_cast<T>(MAX) }; }
+        static constexpr S epsilon()       noexcept { return { B::epsilon() }; }
+        static constexpr S round_error()   noexcept { return { B::round_error() }; }
+        static constexpr S infinity()      noexcept { return {}; }
+        static constexpr S quiet_NaN()     noexcept { return { B::quiet_NaN() }; }
+        static constexpr S signaling_NaN() noexcept { return { B::signaling_NaN() }; }
+        static constexpr S denorm_min()    noexcept { return { B::denorm_min() }; }
     };
 } // namespace std
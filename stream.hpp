@@ -0,0 +1,267 @@
+/**@file
+ * @brief Saturating operations over a stream of samples that arrives in chunks.
+ *
+ * Audio, sensor and network data rarely arrives as one buffer. A `saturating::stream_processor` takes chunks of
+ * any size and keeps the state that crosses their boundaries, so processing a stream in chunks produces exactly
+ * the results of processing it in one go:
+ * - `stream::running_sum`: saturated running total of all samples so far, per step like a loop over saturating
+ *   types.
+ * - `stream::delta`: difference of every sample with the one before it (the last one of the previous chunk).
+ * - `stream::moving_sum<N>`: sum of the last `N` samples, computed exactly and saturated once.
+ *
+ * Chunks are used in place, nothing is copied into aligned staging buffers. Where `delta` can use the native
+ * saturating instructions (see `bulk.hpp`), each chunk is split in a head up to the first register aligned
+ * output element, a run of whole aligned registers and a tail. Only the run is passed to the vector kernels,
+ * the head and tail go through the scalar `saturating::subtract`, which keeps the time per chunk steady no matter
+ * where a chunk starts or ends.
+ *
+ * The result type `T` can be a plain arithmetic type or a `saturating::type`, its limits are respected either way.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if __has_include(<span>) && __cplusplus > 201703L
+#include <span>
+#endif
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+#include "./simd.hpp"
+#include "./bulk.hpp"
+#include "./algorithms.hpp"
+
+namespace saturating {
+    /** Operations of a `stream_processor`. */
+    namespace stream {
+        /** `out[i]` is the saturated running total of all samples up to and including `x[i]`. */
+        struct running_sum {};
+
+        /** `out[i]` is `x[i]` minus the sample before it, the first sample of the stream is taken as is. */
+        struct delta {};
+
+        /** `out[i]` is the sum of the last `N` samples (fewer at the start of the stream), saturated once. */
+        template <std::size_t N>
+        struct moving_sum {
+            static_assert(N > 0, "A moving sum needs a window of at least one sample");
+        };
+    } // namespace stream
+
+    namespace detail {
+        /** Alignment of the register runs: the widest register the bulk kernels may use. */
+#if defined(SATURATING_DISPATCH) && defined(SATURATING_SIMD_X86)
+        constexpr std::size_t stream_align = simd::avx512::bytes;
+#else
+        constexpr std::size_t stream_align = simd::native::bytes;
+#endif
+
+        /** Split of `n` elements in a scalar head, a run of whole aligned registers and a scalar tail. */
+        struct aligned_run {
+            std::size_t head;
+            std::size_t run;
+        };
+
+        /** Split `n` elements starting at `p`, so that the run starts at an address aligned to `stream_align`. */
+        template <typename T>
+        inline aligned_run aligned_run_of(const T* p, std::size_t n) noexcept {
+            constexpr std::size_t lanes = stream_align / sizeof(T);
+            const auto addr = reinterpret_cast<std::uintptr_t>(p);
+            if (addr % sizeof(T) != 0) return { n, 0 };
+            const std::size_t head = std::min(n, (stream_align - addr % stream_align) % stream_align / sizeof(T));
+            return { head, (n - head) / lanes * lanes };
+        }
+
+        /** `p` as a pointer to the base type, saturating types have its layout. */
+        template <typename V>
+        inline const base_t<V>* base_ptr(const V* p) noexcept {
+            return reinterpret_cast<const base_t<V>*>(p);
+        }
+        template <typename V>
+        inline base_t<V>* base_ptr(V* p) noexcept {
+            return reinterpret_cast<base_t<V>*>(p);
+        }
+    } // namespace detail
+
+    /**
+     * Stateful operation `Op` over a stream of samples, processed in chunks of any size.
+     * @tparam Op Operation, see `saturating::stream`
+     * @tparam T  Result type, plain or saturating, determines the limits
+     * @tparam A  Sample type, plain or saturating
+     */
+    template <typename Op, typename T, typename A = T>
+    class stream_processor;
+
+    template <typename T, typename A>
+    class stream_processor<stream::running_sum, T, A> {
+    public:
+        using value_type = T;
+
+        /** Start the running total at `init`. */
+        constexpr explicit stream_processor(const T& init = T{}) noexcept : sum{ init } {}
+
+        /**
+         * Store the running total after each of the `n` samples in `x` in `out`.
+         * @param  x   Samples
+         * @param  out Output buffer, may be equal to `x` if of the same type
+         * @param  n   Number of samples
+         */
+        void operator()(const A* x, T* out, std::size_t n) noexcept {
+            if (n == 0) return;
+            // `automatic` only sums once where that equals saturating per step, so chunks can't change results
+            inclusive_scan(x, out, n, sum);
+            sum = out[n - 1];
+        }
+
+        /**
+         * Add `n` samples to the running total, without storing the intermediate totals.
+         * @return The running total
+         */
+        T add(const A* x, std::size_t n) noexcept {
+            sum = accumulate(x, n, sum);
+            return sum;
+        }
+
+        /** The running total. */
+        constexpr const T& total() const noexcept { return sum; }
+
+        /** Start over at `init`. */
+        constexpr void reset(const T& init = T{}) noexcept { sum = init; }
+
+#ifdef __cpp_lib_span
+        template <std::size_t EX, std::size_t EO>
+        void operator()(std::span<const A, EX> x, std::span<T, EO> out) noexcept {
+            (*this)(x.data(), out.data(), std::min(x.size(), out.size()));
+        }
+
+        template <std::size_t E>
+        T add(std::span<const A, E> x) noexcept { return add(x.data(), x.size()); }
+#endif
+
+    private:
+        T sum;
+    };
+
+    template <typename T, typename A>
+    class stream_processor<stream::delta, T, A> {
+        using R = range_of<T>;
+        using VT = typename R::value_type;
+        using XT = typename range_of<A>::value_type;
+
+    public:
+        using value_type = T;
+
+        /** Take `prev` as the sample before the first one. */
+        constexpr explicit stream_processor(const A& prev = A{}) noexcept : last{ prev } {}
+
+        /**
+         * Store the difference of each of the `n` samples in `x` with the sample before it in `out`.
+         * @param  x   Samples
+         * @param  out Output buffer, must not overlap `x`
+         * @param  n   Number of samples
+         */
+        void operator()(const A* x, T* out, std::size_t n) noexcept {
+            if (n == 0) return;
+            out[0] = diff(x[0], last);
+            last = x[n - 1];
+
+            const XT* xr = detail::base_ptr(x);
+            VT* outr = detail::base_ptr(out);
+            std::size_t i = 1;
+            if constexpr (std::is_same_v<XT, VT> && simd::native_v<simd::native, VT>) {
+                const auto s = detail::aligned_run_of(out + i, n - i);
+                for (const std::size_t end = i + s.head; i < end; ++i) {
+                    out[i] = diff(x[i], x[i - 1]);
+                }
+                saturating::subtract<VT, R::min_val, R::max_val>(xr + i, xr + i - 1, outr + i, s.run);
+                i += s.run;
+                for (; i < n; ++i) {
+                    out[i] = diff(x[i], x[i - 1]);
+                }
+            } else {
+                // No native instructions, the bulk loop is as fast on any alignment
+                saturating::subtract<VT, R::min_val, R::max_val>(xr + i, xr + i - 1, outr + i, n - i);
+            }
+        }
+
+        /** The last sample seen. */
+        constexpr const A& previous() const noexcept { return last; }
+
+        /** Start over, taking `prev` as the sample before the next one. */
+        constexpr void reset(const A& prev = A{}) noexcept { last = prev; }
+
+#ifdef __cpp_lib_span
+        template <std::size_t EX, std::size_t EO>
+        void operator()(std::span<const A, EX> x, std::span<T, EO> out) noexcept {
+            (*this)(x.data(), out.data(), std::min(x.size(), out.size()));
+        }
+#endif
+
+    private:
+        static T diff(const A& a, const A& b) noexcept {
+            return static_cast<T>(saturating::subtract<VT, R::min_val, R::max_val>(detail::value_of(a), detail::value_of(b)));
+        }
+
+        A last;
+    };
+
+    template <std::size_t N, typename T, typename A>
+    class stream_processor<stream::moving_sum<N>, T, A> {
+        using R = range_of<T>;
+        using VT = typename R::value_type;
+        using XT = typename range_of<A>::value_type;
+
+        static_assert(detail::integral_v<T, A>, "Moving sums are exact, which requires integral types");
+        static_assert(sizeof(XT) < sizeof(detail::widest_t), "Samples must be narrower than `detail::widest_t`");
+
+    public:
+        using value_type = T;
+
+        /** Window size. */
+        static constexpr std::size_t window = N;
+
+        /**
+         * Store the sum of the last `N` samples, up to and including each of the `n` samples in `x`, in `out`.
+         * @param  x   Samples
+         * @param  out Output buffer, may be equal to `x` if of the same type
+         * @param  n   Number of samples
+         */
+        void operator()(const A* x, T* out, std::size_t n) noexcept {
+            // The window sum is exact, so it can be updated with the sample leaving the window
+            for (std::size_t i = 0; i < n; ++i) {
+                const XT v = detail::value_of(x[i]);
+                sum += static_cast<detail::widest_t>(v) - static_cast<detail::widest_t>(history[pos]);
+                history[pos] = v;
+                pos = pos + 1 == N ? 0 : pos + 1;
+                out[i] = static_cast<T>(detail::from_wide<VT, R::min_val, R::max_val>(sum));
+            }
+        }
+
+        /** Sum of the last `N` samples, saturated. */
+        constexpr T total() const noexcept { return static_cast<T>(detail::from_wide<VT, R::min_val, R::max_val>(sum)); }
+
+        /** Start over with an empty window. */
+        constexpr void reset() noexcept {
+            history = {};
+            pos = 0;
+            sum = 0;
+        }
+
+#ifdef __cpp_lib_span
+        template <std::size_t EX, std::size_t EO>
+        void operator()(std::span<const A, EX> x, std::span<T, EO> out) noexcept {
+            (*this)(x.data(), out.data(), std::min(x.size(), out.size()));
+        }
+#endif
+
+    private:
+        std::array<XT, N> history {};
+        std::size_t pos = 0;
+        detail::widest_t sum = 0;
+    };
+} // namespace saturating
@@ -0,0 +1,189 @@
+/**@file
+ * @brief Lookup tables for saturating operations on 8 bit operands.
+ *
+ * With 8 bit operands every result of an operation fits in a table: 65536 entries for a binary operation like
+ * `multiply` or `divide`, 256 for a conversion like `scale_from`. `saturating::table` and `saturating::unary_table`
+ * are filled at compile time (`constexpr`) by calling any scalar function on every operand value, so their results
+ * are exactly those of that function. A lookup is then a single load, which beats computing the result for the
+ * slower operations when the table stays in cache, i.e. when lookups come in bursts. `bench/saturating.cpp`
+ * compares both, which one wins depends on the target.
+ *
+ * Entries are indexed by the raw bytes of the operands, values of a custom range type outside of its limits
+ * can't occur and their entries are never used.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if __has_include(<span>) && __cplusplus > 201703L
+#include <span>
+#endif
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+
+namespace saturating {
+    namespace detail {
+        /** Raw byte of 8 bit `v`, which may be a saturating type. */
+        template <typename V>
+        constexpr std::size_t byte_of(const V& v) noexcept {
+            return static_cast<std::uint8_t>(value_of(v));
+        }
+
+        /** The operand value with raw byte `i`. */
+        template <typename V>
+        constexpr V from_byte(std::size_t i) noexcept {
+            return V(static_cast<base_t<V>>(static_cast<std::uint8_t>(i)));
+        }
+
+        /** Is `V` (saturating or plain) an 8 bit integer? */
+        template <typename V>
+        constexpr bool byte_v = is_integral_v<V> && sizeof(base_t<V>) == 1;
+    } // namespace detail
+
+    /**
+     * Results of a binary operation for every pair of 8 bit operands.
+     * @tparam T Result type, saturating or plain
+     * @tparam A Left hand side operand, 8 bit saturating or plain integer
+     * @tparam B Right hand side operand, 8 bit saturating or plain integer
+     */
+    template <typename T, typename A = T, typename B = A>
+    class table {
+        static_assert(detail::byte_v<A> && detail::byte_v<B>, "Tables hold the results for 8 bit operands");
+
+    public:
+        using value_type = T;
+
+        /** Number of entries. */
+        static constexpr std::size_t size = 256 * 256;
+
+        /**
+         * Fill the table with `op(a, b)` for every `a` and `b`.
+         * @param  op Function of an `A` and a `B`, returning a value convertible to `T`
+         */
+        template <typename F>
+        constexpr explicit table(F op) noexcept {
+            for (std::size_t a = 0; a < 256; ++a) {
+                for (std::size_t b = 0; b < 256; ++b) {
+                    entries[a * 256 + b] = static_cast<base_t<T>>(op(detail::from_byte<A>(a), detail::from_byte<B>(b)));
+                }
+            }
+        }
+
+        /** The result for `a` and `b`. */
+        constexpr T operator()(const A& a, const B& b) const noexcept {
+            return T(entries[detail::byte_of(a) * 256 + detail::byte_of(b)]);
+        }
+
+        /** The entries, indexed by `byte of a * 256 + byte of b`. */
+        constexpr const base_t<T>* data() const noexcept { return entries.data(); }
+
+    private:
+        std::array<base_t<T>, size> entries {};
+    };
+
+    /**
+     * Results of a unary operation, such as a conversion, for every 8 bit operand.
+     * @tparam T Result type, saturating or plain
+     * @tparam A Operand, 8 bit saturating or plain integer
+     */
+    template <typename T, typename A>
+    class unary_table {
+        static_assert(detail::byte_v<A>, "Tables hold the results for 8 bit operands");
+
+    public:
+        using value_type = T;
+
+        /** Number of entries. */
+        static constexpr std::size_t size = 256;
+
+        /**
+         * Fill the table with `op(a)` for every `a`.
+         * @param  op Function of an `A`, returning a value convertible to `T`
+         */
+        template <typename F>
+        constexpr explicit unary_table(F op) noexcept {
+            for (std::size_t a = 0; a < 256; ++a) {
+                entries[a] = static_cast<base_t<T>>(op(detail::from_byte<A>(a)));
+            }
+        }
+
+        /** The result for `a`. */
+        constexpr T operator()(const A& a) const noexcept { return T(entries[detail::byte_of(a)]); }
+
+        /** The entries, indexed by the byte of the operand. */
+        constexpr const base_t<T>* data() const noexcept { return entries.data(); }
+
+    private:
+        std::array<base_t<T>, size> entries {};
+    };
+
+    /**
+     * Look up `t(a[i], b[i])` for `n` elements, storing the results in `out`.
+     * @param  t   Table
+     * @param  a   Left hand side values, 8 bit
+     * @param  b   Right hand side values, 8 bit
+     * @param  out Output buffer, may be equal to `a` or `b` if of the same type
+     * @param  n   Number of elements
+     */
+    template <typename T, typename A, typename B, typename VA, typename VB>
+    inline std::enable_if_t<detail::byte_v<VA> && detail::byte_v<VB>>
+    apply(const table<T, A, B>& t, const VA* a, const VB* b, T* out, std::size_t n) noexcept {
+        const base_t<T>* e = t.data();
+        // Independent loads, the indices don't depend on earlier results
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = T(e[detail::byte_of(a[i]) * 256 + detail::byte_of(b[i])]);
+        }
+    }
+
+    /**
+     * Look up `t(a[i])` for `n` elements, storing the results in `out`.
+     * @param  t   Table
+     * @param  a   Operands, 8 bit
+     * @param  out Output buffer, may be equal to `a` if of the same type
+     * @param  n   Number of elements
+     */
+    template <typename T, typename A, typename VA>
+    inline std::enable_if_t<detail::byte_v<VA>>
+    apply(const unary_table<T, A>& t, const VA* a, T* out, std::size_t n) noexcept {
+        const base_t<T>* e = t.data();
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = T(e[detail::byte_of(a[i])]);
+        }
+    }
+
+    /** Table of `saturating::multiply` to the limits of `T`. */
+    template <typename T, typename A = T, typename B = A>
+    inline const table<T, A, B> multiply_table { [](const A& a, const B& b) {
+        return saturating::multiply<base_t<T>, range_of<T>::min_val, range_of<T>::max_val>(a, b);
+    } };
+
+    /** Table of `saturating::divide` to the limits of `T`. */
+    template <typename T, typename A = T, typename B = A>
+    inline const table<T, A, B> divide_table { [](const A& a, const B& b) {
+        return saturating::divide<base_t<T>, range_of<T>::min_val, range_of<T>::max_val>(a, b);
+    } };
+
+    /** Table of `T::scale_from`, for saturating types `T` and `A`. */
+    template <typename T, typename A>
+    inline const unary_table<T, A> scale_table { [](const A& a) { return T::scale_from(a); } };
+
+#ifdef __cpp_lib_span
+    template <typename T, typename A, typename B, typename VA, std::size_t EA, typename VB, std::size_t EB, std::size_t EO>
+    inline std::enable_if_t<detail::byte_v<VA> && detail::byte_v<VB>>
+    apply(const table<T, A, B>& t, std::span<VA, EA> a, std::span<VB, EB> b, std::span<T, EO> out) noexcept {
+        apply(t, a.data(), b.data(), out.data(), std::min({ a.size(), b.size(), out.size() }));
+    }
+
+    template <typename T, typename A, typename VA, std::size_t EA, std::size_t EO>
+    inline std::enable_if_t<detail::byte_v<VA>>
+    apply(const unary_table<T, A>& t, std::span<VA, EA> a, std::span<T, EO> out) noexcept {
+        apply(t, a.data(), out.data(), std::min(a.size(), out.size()));
+    }
+#endif
+} // namespace saturating
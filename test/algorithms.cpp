@@ -0,0 +1,210 @@
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <limits>
+#include <vector>
+#include "../algorithms.hpp"
+#include "../types.hpp"
+
+using saturating::reduction;
+
+using custom_t = saturating::type<int16_t, -1000, 1000>;
+using positive_t = saturating::type<uint8_t, 10, 200>;
+using band_t = saturating::type<int32_t, 100, 200>;
+using band64_t = saturating::type<int64_t, 100, 200>;
+using below_t = saturating::type<int16_t, -200, -100>;
+using negative_t = saturating::type<int8_t, -128, 0>;
+
+/** The loop the reductions replace. */
+template <typename T, typename V>
+T reference_sum(const std::vector<V>& x, T s) {
+    using R = saturating::range_of<T>;
+    for (const auto& v : x) {
+        s = saturating::add<typename R::value_type, R::min_val, R::max_val>(s, v);
+    }
+    return s;
+}
+
+template <typename T, typename A, typename B>
+T reference_dot(const std::vector<A>& a, const std::vector<B>& b, T s) {
+    using R = saturating::range_of<T>;
+    using VT = typename R::value_type;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        s = saturating::add<VT, R::min_val, R::max_val>(s, saturating::multiply<VT, R::min_val, R::max_val>(a[i], b[i]));
+    }
+    return s;
+}
+
+/** Exact sum, clamped once. */
+template <typename T, typename V>
+T reference_once(const std::vector<V>& x, T s) {
+    using R = saturating::range_of<T>;
+    __int128 total = static_cast<typename R::value_type>(s);
+    for (const auto& v : x) total += static_cast<typename saturating::range_of<V>::value_type>(v);
+    return static_cast<T>(static_cast<typename R::value_type>(
+        total < R::min_val ? R::min_val : (total > R::max_val ? R::max_val : total)));
+}
+
+template <typename T, typename V>
+void test_sum(const std::vector<V>& x, const T& init = T{}) {
+    const T r1 = reference_sum(x, init);
+    const T r2 = saturating::accumulate(x.data(), x.size(), init);
+    const T r3 = saturating::accumulate(x.data(), x.size(), init, reduction::per_step);
+    if (r1 != r2 || r1 != r3) {
+        std::cout << "Error summing " << x.size() << " values. Per step result: " << +r1
+                  << ", accumulate: " << +r2 << ", per_step: " << +r3 << std::endl;
+        assert(r1 == r2);
+        assert(r1 == r3);
+    }
+
+    if constexpr (std::is_integral_v<typename saturating::range_of<V>::value_type>) {
+        const T o1 = reference_once(x, init);
+        const T o2 = saturating::accumulate(x.data(), x.size(), init, reduction::once);
+        if (o1 != o2) {
+            std::cout << "Error summing " << x.size() << " values once. Exact result: " << +o1
+                      << ", accumulate: " << +o2 << std::endl;
+            assert(o1 == o2);
+        }
+    }
+
+    using R = saturating::range_of<T>;
+    for (const reduction mode : { reduction::automatic, reduction::per_step, reduction::once }) {
+        const bool once = mode == reduction::once;
+        if (once && !std::is_integral_v<typename saturating::range_of<V>::value_type>) continue;
+        std::vector<T> out(x.size());
+        saturating::inclusive_scan(x.data(), out.data(), x.size(), init, mode);
+        T s = init;
+        __int128 exact = static_cast<typename R::value_type>(init);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            s = saturating::add<typename R::value_type, R::min_val, R::max_val>(s, x[i]);
+            if constexpr (std::is_integral_v<typename saturating::range_of<V>::value_type>) {
+                exact += static_cast<typename saturating::range_of<V>::value_type>(x[i]);
+            }
+            const T e = once ? static_cast<T>(static_cast<typename R::value_type>(
+                                   exact < R::min_val ? R::min_val : (exact > R::max_val ? R::max_val : exact)))
+                             : s;
+            if (e != out[i]) {
+                std::cout << "Error scanning element " << i << (once ? " once" : "") << ". Expected: " << +e
+                          << ", inclusive_scan: " << +out[i] << std::endl;
+                assert(e == out[i]);
+            }
+        }
+    }
+}
+
+template <typename T, typename A, typename B>
+void test_dot(const std::vector<A>& a, const std::vector<B>& b, const T& init = T{}) {
+    const T r1 = reference_dot(a, b, init);
+    const T r2 = saturating::dot(a.data(), b.data(), a.size(), init);
+    if (r1 != r2) {
+        std::cout << "Error in dot product of " << a.size() << " values. Per step result: " << +r1
+                  << ", dot: " << +r2 << std::endl;
+        assert(r1 == r2);
+    }
+}
+
+template <typename T, typename G>
+std::vector<T> random_values(G& gen, std::size_t n, long long lo, long long hi) {
+    std::uniform_int_distribution<long long> dis(lo, hi);
+    std::vector<T> out(n);
+    for (auto& v : out) v = static_cast<T>(dis(gen));
+    return out;
+}
+
+template <typename T, typename G>
+std::vector<T> random_values(G& gen, std::size_t n) {
+    return random_values<T>(gen, n, std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+}
+
+int main() {
+    std::mt19937_64 gen(42);
+
+    for (std::size_t n : { 0, 1, 7, 64, 1000, 100'003 }) {
+        const auto u8  = random_values<uint8_t>(gen, n);
+        const auto s8  = random_values<int8_t>(gen, n);
+        const auto u16 = random_values<uint16_t>(gen, n);
+        const auto s16 = random_values<int16_t>(gen, n);
+        const auto u32 = random_values<uint32_t>(gen, n);
+        const auto s32 = random_values<int32_t>(gen, n);
+        const auto u64 = random_values<uint64_t>(gen, n);
+        const auto s64 = random_values<int64_t>(gen, n);
+        const auto small = random_values<int32_t>(gen, n, -100, 100);
+
+        test_sum<uint32_t>(u8);
+        test_sum<uint16_t>(u8);
+        test_sum<uint8_t>(u8, 200);
+        test_sum<int8_t>(s8);
+        test_sum<int16_t>(s8, -5);
+        test_sum<uint16_t>(u16);
+        test_sum<int16_t>(s16);
+        test_sum<int32_t>(s16);
+        test_sum<uint32_t>(u32);
+        test_sum<int32_t>(s32);
+        test_sum<int64_t>(s32);
+        test_sum<uint64_t>(u64);
+        test_sum<int64_t>(s64);
+        test_sum<int32_t>(small);
+        test_sum<custom_t>(small, custom_t{ 999 });
+        test_sum<positive_t>(u8, positive_t{ 10 });
+        test_sum<uint_sat32_t>(std::vector<uint_sat8_t>(u8.begin(), u8.end()));
+
+        // Ranges excluding 0, starting from the default 0 outside of them
+        const auto neg = random_values<negative_t>(gen, n, -128, 0);
+        const auto u8_small = random_values<uint8_t>(gen, n, 0, 3);
+        test_sum<band_t>(u8);
+        test_sum<band_t>(u8_small);
+        test_sum<band_t>(u8_small, band_t{ 150 });
+        test_sum<band_t>(u8_small, band_t{ 250 });
+        test_sum<band64_t>(u16);
+        test_sum<band64_t>(u8_small);
+        test_sum<below_t>(neg);
+        test_sum<below_t>(neg, below_t{ -150 });
+        test_sum<below_t>(neg, below_t{ -300 });
+        test_sum<band_t>(small);
+
+        test_dot<uint32_t>(u8, u8);
+        test_dot<uint16_t>(u8, u8);
+        test_dot<int32_t>(s8, s8);
+        test_dot<int32_t>(s8, u8);
+        test_dot<int64_t>(s16, s16);
+        test_dot<uint64_t>(u32, u32);
+        test_dot<int64_t>(s32, s32);
+        test_dot<uint64_t>(u64, u64);
+        test_dot<int64_t>(s64, u64);
+        test_dot<int32_t>(small, small, -1000);
+        test_dot<custom_t>(small, small);
+        test_dot<positive_t>(u8, u8, positive_t{ 10 });
+
+        std::vector<double> d(small.begin(), small.end());
+        for (auto& v : d) v /= 1000.0;
+        test_sum<double>(d);
+        test_dot<float>(d, d);
+    }
+
+    // Long enough for multiple lane blocks of 16 bit products
+    const std::vector<uint8_t> full(1 << 18, 255);
+    assert(saturating::accumulate<uint64_t>(full.data(), full.size()) == 255u * full.size());
+    assert(saturating::dot<uint64_t>(full.data(), full.data(), full.size()) == 255u * 255u * full.size());
+    const std::vector<int16_t> low(1 << 18, std::numeric_limits<int16_t>::lowest());
+    assert(saturating::accumulate<int64_t>(low.data(), low.size()) == -32768ll * (1 << 18));
+    assert(saturating::dot<int64_t>(low.data(), low.data(), low.size()) == 32768ll * 32768ll * (1 << 18));
+
+    // Per step the default 0 is clamped together with the first element, summed once it is part of the total
+    const uint8_t fives[3] { 5, 5, 5 };
+    band_t scan_out[3];
+    saturating::inclusive_scan(fives, scan_out, 3);
+    assert(scan_out[0] == 100 && scan_out[1] == 105 && scan_out[2] == 110);
+    saturating::inclusive_scan(fives, scan_out, 3, band_t{}, reduction::once);
+    assert(scan_out[0] == 100 && scan_out[1] == 100 && scan_out[2] == 100);
+    assert(saturating::accumulate<band_t>(fives, 3) == 110);
+    assert(saturating::accumulate<band_t>(fives, 3, band_t{}, reduction::once) == 100);
+
+#ifdef __cpp_lib_span
+    const std::span<const uint8_t> sp { full };
+    assert(saturating::accumulate<uint32_t>(sp) == 255u * full.size());
+    assert(saturating::dot<uint8_t>(sp, sp) == 255);
+    std::vector<uint16_t> scan(full.size());
+    saturating::inclusive_scan(sp, std::span<uint16_t>{ scan });
+    assert(scan[0] == 255 && scan[256] == 65535 && scan.back() == 65535);
+#endif
+}
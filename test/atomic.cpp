@@ -0,0 +1,93 @@
+#include <iostream>
+#include <cassert>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../atomic.hpp"
+#include "../types.hpp"
+
+using budget_t = saturating::type<uint32_t, 0, 1000000>;
+using level_t  = saturating::type<int16_t, -1000, 1000>;
+
+static_assert(sizeof(saturating::atomic<uint_sat32_t>) == saturating::detail::cache_line);
+static_assert(alignof(saturating::atomic<uint_sat64_t>) == saturating::detail::cache_line);
+static_assert(saturating::atomic<uint_sat32_t>::is_always_lock_free);
+
+/** Run `f(thread index)` on `n` threads. */
+template <typename F>
+void run(unsigned n, const F& f) {
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < n; ++t) threads.emplace_back(f, t);
+    for (auto& t : threads) t.join();
+}
+
+/** Single threaded, against the scalar functions. */
+template <typename S, bool Lazy, typename G>
+void test_sequential(G& gen) {
+    using R = saturating::range_of<S>;
+    using T = typename R::value_type;
+    saturating::atomic<S, Lazy> a { S{ static_cast<T>(R::min_val / 2 + R::max_val / 2) } };
+    T e = a.load();
+    for (int i = 0; i < 100000; ++i) {
+        const auto d = static_cast<int64_t>(gen()) >> (gen() % 64);
+        const T prev = i % 2 ? a.fetch_add(d, std::memory_order_relaxed) : a.fetch_sub(-d, std::memory_order_relaxed);
+        assert(prev == e);
+        e = saturating::add<T, R::min_val, R::max_val>(e, d);
+        if (a.load() != e) {
+            std::cout << "Error in atomic of " << +prev << " + " << d << ". Expected: " << +e << ", result: " << +static_cast<T>(a.load()) << std::endl;
+            assert(a.load() == e);
+        }
+    }
+}
+
+int main() {
+    std::mt19937_64 gen(19);
+    test_sequential<uint_sat8_t, true>(gen);
+    test_sequential<int_sat16_t, true>(gen);
+    test_sequential<level_t, true>(gen);
+    test_sequential<level_t, false>(gen);
+    test_sequential<budget_t, true>(gen);
+    test_sequential<int_sat64_t, true>(gen);
+    test_sequential<uint_sat64_t, true>(gen);
+
+    // Exact limits, operators return the new value like `std::atomic`
+    saturating::atomic<uint_sat8_t> small { uint_sat8_t{ 254 } };
+    assert(++small == 255 && ++small == 255 && small++ == 255);
+    assert((small -= 300) == 0 && --small == 0);
+    assert((small += -1) == 0 && (small += 7) == 7);
+    uint_sat8_t expected { 3 };
+    assert(!small.compare_exchange_strong(expected, uint_sat8_t{ 9 }) && expected == 7);
+    assert(small.compare_exchange_strong(expected, uint_sat8_t{ 9 }) && small.load() == 9);
+    assert(small.exchange(uint_sat8_t{ 1 }) == 9 && small.load(std::memory_order_acquire) == 1);
+
+    // Threads pushing into both bounds, the lock free path
+    const unsigned threads = 8;
+    saturating::atomic<budget_t> budget;
+    run(threads, [&](unsigned) { for (int i = 0; i < 200000; ++i) budget.fetch_add(1, std::memory_order_relaxed); });
+    assert(budget.load() == 1000000u);
+    run(threads, [&](unsigned) { for (int i = 0; i < 100000; ++i) budget.fetch_sub(1, std::memory_order_relaxed); });
+    assert(budget.load() == 200000u);
+    run(threads, [&](unsigned) { for (int i = 0; i < 100000; ++i) --budget; });
+    assert(budget.load() == 0u);
+
+    // Exact paths: full range counters and both directions at once
+    saturating::atomic<uint_sat16_t> full;
+    run(threads, [&](unsigned) { for (int i = 0; i < 20000; ++i) full++; });
+    assert(full.load() == 65535);
+    saturating::atomic<level_t, false> level;
+    std::vector<long> moved(threads);
+    run(threads, [&](unsigned t) {
+        std::mt19937 g(t);
+        for (int i = 0; i < 100000; ++i) {
+            const int d = static_cast<int>(g() % 41) - 20;
+            const int16_t prev = level.fetch_add(d, std::memory_order_relaxed);
+            assert(prev >= -1000 && prev <= 1000);
+            moved[t] += saturating::add<int16_t, -1000, 1000>(prev, d) - prev;
+        }
+    });
+    // Each update moved the value by exactly the amount it saw, so the moves add up to the final value
+    long total = 0;
+    for (long m : moved) total += m;
+    assert(level.load() == total);
+}
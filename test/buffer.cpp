@@ -0,0 +1,81 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+#include <vector>
+#include "../buffer.hpp"
+#include "../bulk.hpp"
+#include "../types.hpp"
+
+using level_t = saturating::type<int8_t, 16, 32>;
+
+/** Counts the allocations passed on to the default resource. */
+class counting_resource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        ++allocations;
+        return std::pmr::get_default_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        std::pmr::get_default_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+int main() {
+    std::mt19937 gen(42);
+
+    // Aligned storage padded to whole cache lines of valid values
+    saturating::buffer<int_sat16_t> a(1000), b(1000), out(1000);
+    static_assert(decltype(a)::granule == 32);
+    assert(reinterpret_cast<std::uintptr_t>(a.data()) % 64 == 0);
+    assert(a.size() == 1000 && a.padded_size() == 1024 && a.capacity() == 1024);
+    assert(a[999] == 0 && a.data()[1023] == 0);
+
+    saturating::buffer<level_t> l(3);
+    assert(l.padded_size() == 64);
+    for (std::size_t i = 0; i < l.padded_size(); ++i) assert(l.data()[i] == 16);
+
+    // Bulk functions over the padded size equal the scalar template for the elements
+    std::uniform_int_distribution<int> dis(-32768, 32767);
+    for (auto& v : a) v = static_cast<int16_t>(dis(gen));
+    for (auto& v : b) v = static_cast<int16_t>(dis(gen));
+    saturating::add(a.data(), b.data(), out.data(), out.padded_size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        if (out[i] != saturating::add<int16_t>(a[i], b[i])) {
+            std::cout << "Error at " << i << ": " << out[i] << std::endl;
+            assert(out[i] == saturating::add<int16_t>(a[i], b[i]));
+        }
+    }
+    assert(out.data()[1023] == 0);
+
+    // Reuse per frame without allocating, growth keeps the elements
+    counting_resource counter;
+    saturating::buffer<uint_sat8_t> f(&counter);
+    f.reset(100);
+    assert(counter.allocations == 1 && f.capacity() == 128);
+    f[99] = 7;
+    for (std::size_t frame = 0; frame < 10; ++frame) {
+        f.reset();
+        f.reset(100 - frame);
+    }
+    assert(counter.allocations == 1 && f.size() == 91 && f.data()[95] == 0);
+    f[10] = 3;
+    f.reset(1000);
+    assert(counter.allocations == 2 && f[10] == 3 && f[999] == 0);
+
+    // Buffers carved from an arena
+    std::pmr::monotonic_buffer_resource arena(1 << 16);
+    {
+        saturating::buffer<int_sat32_t> x(100, &arena), y(100, &arena);
+        assert(x.resource() == &arena);
+        assert(reinterpret_cast<std::uintptr_t>(y.data()) % 64 == 0);
+        saturating::buffer<int_sat32_t> z(std::move(x));
+        assert(z.size() == 100 && x.data() == nullptr);
+    }
+    arena.release();
+}
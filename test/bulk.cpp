@@ -0,0 +1,104 @@
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <limits>
+#include <vector>
+#include "../bulk.hpp"
+#include "../types.hpp"
+
+template <typename T, saturating::limit_t<T> MIN, saturating::limit_t<T> MAX, typename A, typename B>
+void test_bulk_impl(const std::vector<A>& a, const std::vector<B>& b) {
+    // Odd length to exercise the scalar tail after the vector loop
+    const std::size_t n = a.size() - 3;
+    std::vector<T> sum(n), diff(n);
+
+    saturating::add<T, MIN, MAX>(a.data(), b.data(), sum.data(), n);
+    saturating::subtract<T, MIN, MAX>(a.data(), b.data(), diff.data(), n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto r1 = saturating::add<T, MIN, MAX>(a[i], b[i]);
+        const auto r2 = saturating::subtract<T, MIN, MAX>(a[i], b[i]);
+        if (r1 != sum[i] || r2 != diff[i]) {
+            std::cout << "Error calculating " << +a[i] << " +/- " << +b[i]
+                      << " (" << +MIN << "..." << +MAX << ")"
+                      << ". Scalar: " << +r1 << ", " << +r2
+                      << ", bulk: " << +sum[i] << ", " << +diff[i] << std::endl;
+            assert(r1 == sum[i]);
+            assert(r2 == diff[i]);
+        }
+    }
+
+    if constexpr (std::is_same_v<A, T>) {
+        std::vector<T> inplace(a.begin(), a.begin() + n);
+        saturating::add_to<T, MIN, MAX>(inplace.data(), b.data(), n);
+        assert(inplace == sum);
+
+        inplace.assign(a.begin(), a.begin() + n);
+        saturating::subtract_from<T, MIN, MAX>(inplace.data(), b.data(), n);
+        assert(inplace == diff);
+    }
+
+#ifdef __cpp_lib_span
+    std::vector<T> sum_span(n);
+    saturating::add<T, MIN, MAX>(std::span(a), std::span(b), std::span(sum_span));
+    assert(sum_span == sum);
+#endif
+}
+
+template <typename T, typename A, typename B>
+void test_bulk(const std::vector<A>& a, const std::vector<B>& b) {
+    test_bulk_impl<T, saturating::default_min_v<T>, saturating::default_max_v<T>>(a, b);
+}
+
+/** Every combination of two 8 bit values. */
+template <typename T>
+void all_pairs(std::vector<T>& a, std::vector<T>& b) {
+    for (int i = std::numeric_limits<T>::lowest(); i <= std::numeric_limits<T>::max(); ++i) {
+        for (int j = std::numeric_limits<T>::lowest(); j <= std::numeric_limits<T>::max(); ++j) {
+            a.push_back(static_cast<T>(i));
+            b.push_back(static_cast<T>(j));
+        }
+    }
+}
+
+template <typename T, typename G>
+std::vector<T> random_values(G& gen, std::size_t n) {
+    std::uniform_int_distribution<long long> dis(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+    std::vector<T> out(n);
+    for (auto& v : out) v = static_cast<T>(dis(gen));
+    return out;
+}
+
+int main() {
+    std::vector<int8_t> s8a, s8b;
+    std::vector<uint8_t> u8a, u8b;
+    all_pairs(s8a, s8b);
+    all_pairs(u8a, u8b);
+
+    test_bulk<int8_t>(s8a, s8b);
+    test_bulk<uint8_t>(u8a, u8b);
+    test_bulk_impl<int8_t, -100, 100>(s8a, s8b);
+    test_bulk_impl<uint8_t, 16, 32>(u8a, u8b);
+    test_bulk<int16_t>(u8a, u8b);
+    test_bulk<int32_t>(s8a, u8b);
+
+    std::mt19937_64 gen(42);
+    const std::size_t samples = 1'000'003;
+    const auto s16a = random_values<int16_t>(gen, samples), s16b = random_values<int16_t>(gen, samples);
+    const auto u16a = random_values<uint16_t>(gen, samples), u16b = random_values<uint16_t>(gen, samples);
+    const auto s32a = random_values<int32_t>(gen, samples), s32b = random_values<int32_t>(gen, samples);
+    const auto u64a = random_values<uint64_t>(gen, samples), u64b = random_values<uint64_t>(gen, samples);
+
+    test_bulk<int16_t>(s16a, s16b);
+    test_bulk<uint16_t>(u16a, u16b);
+    test_bulk_impl<int16_t, -1000, 1000>(s16a, s16b);
+    test_bulk_impl<uint16_t, 1000, 50000>(u16a, u16b);
+    test_bulk<int8_t>(s16a, u16b);
+    test_bulk<int32_t>(s32a, s32b);
+    test_bulk<uint32_t>(s32a, s32b);
+    test_bulk<uint64_t>(u64a, u64b);
+
+    std::vector<double> da(s16a.begin(), s16a.end());
+    test_bulk<int16_t>(da, s16b);
+    test_bulk<float>(s16a, da);
+}
@@ -0,0 +1,74 @@
+#define SATURATING_DISPATCH
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <limits>
+#include <vector>
+#include "../bulk.hpp"
+
+using saturating::simd::level;
+
+/** The kernels of every level the CPU supports, against the scalar functions. */
+template <typename Op, typename T, saturating::limit_t<T> MIN, saturating::limit_t<T> MAX>
+void test_levels(const std::vector<T>& a, const std::vector<T>& b) {
+    using K = saturating::simd::dispatch<saturating::detail::binary_kernel<Op, T, MIN, MAX>, std::size_t(const T*, const T*, T*, std::size_t)>;
+    const std::size_t n = a.size();
+    for (int l = 0; l <= static_cast<int>(saturating::simd::cpu_level()); ++l) {
+        std::vector<T> out(n);
+        const std::size_t done = K::select(static_cast<level>(l))(a.data(), b.data(), out.data(), n);
+        assert(done <= n && n - done < 64);
+        for (std::size_t i = 0; i < done; ++i) {
+            const T e = Op::template scalar<T, MIN, MAX>(a[i], b[i]);
+            if (out[i] != e) {
+                std::cout << "Error at level " << l << " for " << +a[i] << ", " << +b[i] << " (" << +MIN << "..." << +MAX
+                          << "). Expected: " << +e << ", result: " << +out[i] << std::endl;
+                assert(out[i] == e);
+            }
+        }
+    }
+}
+
+template <typename T, typename G>
+void test_type(G& gen) {
+    std::uniform_int_distribution<long long> dis(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+    std::vector<T> a(70000), b(70000);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<T>(dis(gen));
+        b[i] = static_cast<T>(dis(gen));
+    }
+    constexpr T lo = std::numeric_limits<T>::lowest(), hi = std::numeric_limits<T>::max();
+    test_levels<saturating::detail::op_add, T, lo, hi>(a, b);
+    test_levels<saturating::detail::op_subtract, T, lo, hi>(a, b);
+    test_levels<saturating::detail::op_add, T, static_cast<T>(lo / 2 + 3), static_cast<T>(hi / 3)>(a, b);
+    test_levels<saturating::detail::op_subtract, T, static_cast<T>(lo / 2 + 3), static_cast<T>(hi / 3)>(a, b);
+}
+
+int main() {
+    std::mt19937_64 gen(13);
+    test_type<int8_t>(gen);
+    test_type<uint8_t>(gen);
+    test_type<int16_t>(gen);
+    test_type<uint16_t>(gen);
+
+    // Q15 products at every level, the baseline has no `pmulhrsw` and leaves everything to the scalar loop
+    using Q = saturating::simd::dispatch<saturating::detail::multiply_q15_kernel<-32768, 32767>,
+                                         std::size_t(const int16_t*, const int16_t*, int16_t*, std::size_t)>;
+    std::vector<int16_t> a(4099), b(4099), out(4099);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<int16_t>(gen());
+        b[i] = static_cast<int16_t>(gen());
+    }
+    a[0] = b[0] = -32768;
+    for (int l = 0; l <= static_cast<int>(saturating::simd::cpu_level()); ++l) {
+        const std::size_t done = Q::select(static_cast<level>(l))(a.data(), b.data(), out.data(), a.size());
+        for (std::size_t i = 0; i < done; ++i) {
+            assert(out[i] == (saturating::q15_t::from_raw(a[i]) * saturating::q15_t::from_raw(b[i])).raw());
+        }
+    }
+
+    // Call sites are unchanged, the first call resolves
+    std::vector<uint8_t> x(1000, 200), y(1000, 100), z(1000);
+    saturating::add(x.data(), y.data(), z.data(), x.size());
+    saturating::add(x.data(), y.data(), z.data(), x.size());
+    for (auto v : z) assert(v == 255);
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <limits>
+#include <vector>
+#include "../divider.hpp"
+#include "../bulk.hpp"
+#include "../types.hpp"
+
+template <typename T, saturating::limit_t<T> MIN, saturating::limit_t<T> MAX>
+void test_divider_impl(const T& divisor, const std::vector<T>& a) {
+    const saturating::divider<T, MIN, MAX> d { divisor };
+    std::vector<T> out(a.size());
+    saturating::divide(a.data(), d, out.data(), a.size());
+
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        const auto r1 = saturating::divide<T, MIN, MAX>(a[i], divisor);
+        const auto r2 = d(a[i]);
+        if (r1 != r2 || r1 != out[i]) {
+            std::cout << "Error calculating " << +a[i] << " / " << +divisor
+                      << " (" << +MIN << "..." << +MAX << ")"
+                      << ". Plain result: " << +r1
+                      << ", divider: " << +r2
+                      << ", bulk: " << +out[i] << std::endl;
+            assert(r1 == r2);
+            assert(r1 == out[i]);
+        }
+    }
+}
+
+template <typename T>
+void test_divider(const T& divisor, const std::vector<T>& a) {
+    test_divider_impl<T, saturating::default_min_v<T>, saturating::default_max_v<T>>(divisor, a);
+}
+
+template <typename T>
+std::vector<T> all_values() {
+    std::vector<T> out;
+    for (long i = std::numeric_limits<T>::lowest(); i <= std::numeric_limits<T>::max(); ++i) {
+        out.push_back(static_cast<T>(i));
+    }
+    return out;
+}
+
+template <typename T, typename G>
+std::vector<T> random_values(G& gen, std::size_t n) {
+    std::uniform_int_distribution<T> dis(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+    std::vector<T> out(n);
+    for (auto& v : out) v = dis(gen);
+    // Make sure the extremes are always covered
+    out[0] = std::numeric_limits<T>::lowest();
+    out[1] = std::numeric_limits<T>::max();
+    out[2] = 0;
+    return out;
+}
+
+int main() {
+    // Exhaustive for 8 and 16 bit
+    const auto s8 = all_values<int8_t>();
+    const auto u8 = all_values<uint8_t>();
+    for (const auto& d : s8) {
+        test_divider(d, s8);
+        test_divider_impl<int8_t, -100, 100>(d, s8);
+    }
+    for (const auto& d : u8) {
+        test_divider(d, u8);
+        test_divider_impl<uint8_t, 16, 32>(d, u8);
+    }
+
+    const auto s16 = all_values<int16_t>();
+    const auto u16 = all_values<uint16_t>();
+    for (const auto d : { 0, 1, -1, 2, -2, 3, 7, 10, 255, 256, 1000, -1000, 32767, -32768 }) {
+        test_divider<int16_t>(d, s16);
+    }
+    for (const auto d : { 0, 1, 2, 3, 7, 10, 255, 256, 1000, 32768, 65535 }) {
+        test_divider<uint16_t>(d, u16);
+    }
+
+    std::mt19937_64 gen(42);
+    const auto s32 = random_values<int32_t>(gen, 100'000);
+    const auto u32 = random_values<uint32_t>(gen, 100'000);
+    const auto s64 = random_values<int64_t>(gen, 100'000);
+    const auto u64 = random_values<uint64_t>(gen, 100'000);
+    for (std::size_t i = 0; i < 64; ++i) {
+        test_divider(s32[i], s32);
+        test_divider(u32[i], u32);
+        test_divider(s64[i], s64);
+        test_divider(u64[i], u64);
+    }
+    for (const auto d : { 0, 1, -1, 2, 3, 1000 }) {
+        test_divider<int32_t>(d, s32);
+        test_divider<int64_t>(d, s64);
+    }
+}
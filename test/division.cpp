@@ -1,6 +1,5 @@
 #include <iostream>
 #include <cassert>
-#include <chrono>
 #include <random>
 #include <limits>
 #include "../functions.hpp"
@@ -43,15 +42,42 @@ constexpr void test_divide(const A& a, const B& b) {
     (test_divide_impl<T, A, B>(a, b), ...);
 }
 
+// Divide by zero saturates, `lowest / -1` can't trap
+static_assert(saturating::divide<int32_t>(int32_t(5), int32_t(0)) == std::numeric_limits<int32_t>::max());
+static_assert(saturating::divide<int32_t>(int32_t(-5), int32_t(0)) == std::numeric_limits<int32_t>::lowest());
+static_assert(saturating::divide<uint8_t>(uint8_t(0), uint8_t(0)) == std::numeric_limits<uint8_t>::max());
+static_assert(saturating::divide<int8_t, -100, 100>(int8_t(3), int8_t(0)) == 100);
+static_assert(saturating::divide<int32_t>(std::numeric_limits<int32_t>::lowest(), int32_t(-1)) == std::numeric_limits<int32_t>::max());
+static_assert(saturating::divide<int64_t>(std::numeric_limits<int32_t>::lowest(), int32_t(-1)) == 2147483648);
+static_assert(saturating::divide<int64_t>(std::numeric_limits<int64_t>::lowest(), int64_t(-1)) == std::numeric_limits<int64_t>::max());
+static_assert(saturating::divide<int64_t>(std::numeric_limits<int64_t>::lowest(), int64_t(1)) == std::numeric_limits<int64_t>::lowest());
+// 64 bit operands, which divide in the 128 bit types (in strict modes as well)
+static_assert(saturating::divide<int64_t>(int64_t(100), int64_t(7)) == 14);
+static_assert(saturating::divide<int64_t>(int64_t(-101), int64_t(2)) == -51);
+static_assert(saturating::divide<int64_t>(std::numeric_limits<int64_t>::lowest(), int64_t(3)) == -3074457345618258603);
+static_assert(saturating::divide<uint64_t>(uint64_t(100), uint64_t(7)) == 14);
+static_assert(saturating::divide<uint64_t>(std::numeric_limits<uint64_t>::max(), uint64_t(2)) == uint64_t(1) << 63);
+// Rounding half away from zero
+static_assert(saturating::divide<int32_t>(int32_t(5), int32_t(2)) == 3);
+static_assert(saturating::divide<int32_t>(int32_t(-5), int32_t(2)) == -3);
+static_assert(saturating::divide<int32_t>(int32_t(7), int32_t(-3)) == -2);
+
 int main() {
     const unsigned samples = 1'000'000;
     // const unsigned limit = 100;
     const unsigned limit = std::numeric_limits<int>::max() / 2;
 
+    // The same at run time
+    volatile int64_t n64 = -101, d64 = 2;
+    volatile uint64_t un64 = std::numeric_limits<uint64_t>::max(), ud64 = 2;
+    assert(saturating::divide<int64_t>(n64, d64) == -51);
+    assert(saturating::divide<int64_t>(int64_t(100), d64) == 50);
+    assert(saturating::divide<uint64_t>(un64, ud64) == uint64_t(1) << 63);
+    assert(saturating::divide<int_sat64_t>(n64, int64_t(-1)) == 101);
+
     std::random_device rd;
     std::uniform_int_distribution<> dis(0, limit);
 
-    auto start = std::chrono::system_clock::now();
     for (unsigned i = 0; i <= samples; ++i) {
         test_divide<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(dis(rd), dis(rd));
         test_divide<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(dis(rd),  static_cast<int>(dis(rd)));
@@ -65,7 +91,4 @@ int main() {
         test_divide<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(dis(rd), 1/static_cast<double>(dis(rd)));
         test_divide<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(1/static_cast<double>(dis(rd)), dis(rd));
     }
-    auto end = std::chrono::system_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    std::cout << "Division took " << elapsed.count() << " ms" << std::endl;
 }
@@ -0,0 +1,444 @@
+#define SATURATING_DISPATCH
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <vector>
+#include "../parallel.hpp"
+#include "../bulk.hpp"
+#include "../divider.hpp"
+#include "../table.hpp"
+#include "../types.hpp"
+
+/*
+ * Every 8 and 16 bit operand pair of every operation, against exact integer results: the scalar functions, the
+ * bulk functions, the SIMD kernels at every level the CPU supports, `divider` and the 8 bit tables. Wider and
+ * floating point types are sampled. Work is spread over all cores, `exhaustive <stride>` only sweeps every
+ * `stride`-th left hand side for a quick run.
+ */
+
+using saturating::limit_t;
+using wide_t = saturating::detail::widest_t;
+
+namespace {
+    std::atomic<std::size_t> failures { 0 };
+    std::mutex report_mutex;
+
+    /** Record a mismatch, printing the first few. */
+    template <typename A, typename B, typename R>
+    void fail(const char* what, const char* type, const A& a, const B& b, const R& result, const R& expected) {
+        if (failures.fetch_add(1, std::memory_order_relaxed) < 20) {
+            std::lock_guard<std::mutex> lock { report_mutex };
+            std::cout << "Error in " << what << " (" << type << ") for " << +a << ", " << +b << ": " << +result
+                      << ", expected " << +expected << std::endl;
+        }
+    }
+
+    /** splitmix64, fast enough to not dominate the sampled sweeps and reproducible per task. */
+    struct splitmix64 {
+        std::uint64_t state;
+
+        std::uint64_t operator()() noexcept {
+            std::uint64_t z = (state += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return z ^ (z >> 31);
+        }
+    };
+
+    /** `r` clamped to `MIN` ... `MAX`. */
+    template <typename T, limit_t<T> MIN, limit_t<T> MAX>
+    constexpr T clamp_wide(wide_t r) noexcept {
+        return static_cast<T>(r < static_cast<wide_t>(MIN) ? static_cast<wide_t>(MIN) : (r > static_cast<wide_t>(MAX) ? static_cast<wide_t>(MAX) : r));
+    }
+
+    /*
+     * Operations: the scalar function, the bulk function, the dispatched kernel set (`void` if there is none) and
+     * the exact result in `W`, which only saturates beyond `W`.
+     */
+    struct add_op {
+        static constexpr const char* name = "add";
+        using kernel = saturating::detail::op_add;
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static T scalar(const A& a, const B& b) noexcept { return saturating::add<T, MIN, MAX>(a, b); }
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static void bulk(const A* a, const B* b, T* out, std::size_t n) noexcept { saturating::add<T, MIN, MAX>(a, b, out, n); }
+        template <typename W> static W exact(W a, W b) noexcept { return a + b; }
+    };
+
+    struct subtract_op {
+        static constexpr const char* name = "subtract";
+        using kernel = saturating::detail::op_subtract;
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static T scalar(const A& a, const B& b) noexcept { return saturating::subtract<T, MIN, MAX>(a, b); }
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static void bulk(const A* a, const B* b, T* out, std::size_t n) noexcept { saturating::subtract<T, MIN, MAX>(a, b, out, n); }
+        template <typename W> static W exact(W a, W b) noexcept { return a - b; }
+    };
+
+    struct multiply_op {
+        static constexpr const char* name = "multiply";
+        using kernel = void;
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static T scalar(const A& a, const B& b) noexcept { return saturating::multiply<T, MIN, MAX>(a, b); }
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static void bulk(const A* a, const B* b, T* out, std::size_t n) noexcept { saturating::multiply<T, MIN, MAX>(a, b, out, n); }
+        template <typename W>
+        static W exact(W a, W b) noexcept {
+            W r;
+            return __builtin_mul_overflow(a, b, &r) ? ((a < 0) != (b < 0) ? std::numeric_limits<W>::lowest() : std::numeric_limits<W>::max()) : r;
+        }
+    };
+
+    /** Rounds half away from zero, a zero divisor goes to the limit of the sign of `a` (`MAX` for 0). */
+    struct divide_op {
+        static constexpr const char* name = "divide";
+        using kernel = void;
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static T scalar(const A& a, const B& b) noexcept { return saturating::divide<T, MIN, MAX>(a, b); }
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static void bulk(const A* a, const B* b, T* out, std::size_t n) noexcept { saturating::divide<T, MIN, MAX>(a, b, out, n); }
+        template <typename W>
+        static W exact(W a, W b) noexcept {
+            if (b == 0) return a < 0 ? std::numeric_limits<W>::lowest() : std::numeric_limits<W>::max();
+            const W ua = a < 0 ? -a : a, ub = b < 0 ? -b : b;
+            const W q = ua / ub + (2 * (ua % ub) >= ub);
+            return (a < 0) != (b < 0) ? -q : q;
+        }
+    };
+
+    struct abs_diff_op {
+        static constexpr const char* name = "abs_diff";
+        using kernel = void;
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static T scalar(const A& a, const B& b) noexcept { return saturating::abs_diff<T, MIN, MAX>(a, b); }
+        template <typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+        static void bulk(const A* a, const B* b, T* out, std::size_t n) noexcept { saturating::abs_diff<T, MIN, MAX>(a, b, out, n); }
+        template <typename W> static W exact(W a, W b) noexcept { return a < b ? b - a : a - b; }
+    };
+
+    /** Call `f(level, kernel)` for dispatch `D` at every level the CPU supports. */
+    template <typename D, typename F>
+    void each_level(const F& f) {
+#if defined(SATURATING_SIMD_X86)
+        for (int l = 0; l <= static_cast<int>(saturating::simd::cpu_level()); ++l) {
+            f(l, D::select(static_cast<saturating::simd::level>(l)));
+        }
+#else
+        f(0, &D::call);
+#endif
+    }
+
+    /** Report every `r[i] != e[i]` of `n` results, which are all equal nearly always. */
+    template <typename A, typename B, typename T>
+    void compare(const char* what, const char* type, const A* a, const B* b, const T* r, const T* e, std::size_t n) {
+        if (std::memcmp(r, e, n * sizeof(T)) != 0) {
+            for (std::size_t i = 0; i < n; ++i) {
+                if (r[i] != e[i]) fail(what, type, a[i], b[i], r[i], e[i]);
+            }
+        }
+    }
+
+    /**
+     * `Op` for `n` pairs `a[i]`, `b[i]`: the scalar function against the exact result, the bulk function and
+     * kernels against the scalar function. `out` and `res` are scratch buffers of `n` elements. Results go to
+     * buffers before comparing, so the loops vectorize where the functions do.
+     */
+    template <typename Op, typename T, limit_t<T> MIN, limit_t<T> MAX, typename A, typename B>
+    void check_pairs(const A* a, const B* b, T* out, T* res, std::size_t n, const char* type) {
+        // Narrow operands don't need the slower wide divisions
+        constexpr std::size_t size = std::max({ sizeof(T), sizeof(A), sizeof(B) });
+        using W = std::conditional_t<(size <= 2), int, std::conditional_t<(size <= 4), long long, wide_t>>;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = Op::template scalar<T, MIN, MAX>(a[i], b[i]);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            res[i] = clamp_wide<T, MIN, MAX>(Op::exact(static_cast<W>(a[i]), static_cast<W>(b[i])));
+        }
+        compare(Op::name, type, a, b, out, res, n);
+
+        Op::template bulk<T, MIN, MAX>(a, b, res, n);
+        compare(Op::name, type, a, b, res, out, n);
+
+        if constexpr (!std::is_void_v<typename Op::kernel> && std::is_same_v<A, T> && std::is_same_v<B, T> &&
+                      saturating::simd::native_v<saturating::simd::native, T>) {
+            using K = saturating::detail::binary_kernel<typename Op::kernel, T, MIN, MAX>;
+            each_level<saturating::simd::dispatch<K, std::size_t(const T*, const T*, T*, std::size_t)>>([&](int, auto kernel) {
+                compare(Op::name, "kernel", a, b, res, out, kernel(a, b, res, n));
+            });
+        }
+    }
+
+    /** Every operation over `n` pairs, to the full range of `T` and to a custom one. */
+    template <typename T, typename A, typename B>
+    void check_all(const A* a, const B* b, T* out, T* res, std::size_t n, const char* type) {
+        constexpr T lo = std::numeric_limits<T>::lowest(), hi = std::numeric_limits<T>::max();
+        constexpr T cmin = static_cast<T>(lo / 2 + 3), cmax = static_cast<T>(hi / 3);
+        check_pairs<add_op, T, lo, hi>(a, b, out, res, n, type);
+        check_pairs<add_op, T, cmin, cmax>(a, b, out, res, n, type);
+        check_pairs<subtract_op, T, lo, hi>(a, b, out, res, n, type);
+        check_pairs<subtract_op, T, cmin, cmax>(a, b, out, res, n, type);
+        check_pairs<multiply_op, T, lo, hi>(a, b, out, res, n, type);
+        check_pairs<multiply_op, T, cmin, cmax>(a, b, out, res, n, type);
+        check_pairs<divide_op, T, lo, hi>(a, b, out, res, n, type);
+        check_pairs<divide_op, T, cmin, cmax>(a, b, out, res, n, type);
+        check_pairs<abs_diff_op, T, lo, hi>(a, b, out, res, n, type);
+        check_pairs<abs_diff_op, T, cmin, cmax>(a, b, out, res, n, type);
+    }
+
+    /** `divider` for `d` over `n` dividends against the scalar division. */
+    template <typename T, limit_t<T> MIN, limit_t<T> MAX>
+    void check_divider(const T* a, T d, T* out, std::size_t n, const char* type) {
+        saturating::divide(a, saturating::divider<T, MIN, MAX>(d), out, n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const T e = saturating::divide<T, MIN, MAX>(a[i], d);
+            if (out[i] != e) fail("divider", type, a[i], d, out[i], e);
+        }
+    }
+
+    /** Q15 products of `n` pairs at every level against the scalar `q15_t` product and the exact one. */
+    void check_q15(const int16_t* a, const int16_t* b, int16_t* out, std::size_t n) {
+        using saturating::q15_t;
+        using D = saturating::simd::dispatch<saturating::detail::multiply_q15_kernel<-32768, 32767>,
+                                             std::size_t(const int16_t*, const int16_t*, int16_t*, std::size_t)>;
+        each_level<D>([&](int, auto kernel) {
+            const std::size_t done = kernel(a, b, out, n);
+            for (std::size_t i = 0; i < done; ++i) {
+                const int16_t e = (q15_t::from_raw(a[i]) * q15_t::from_raw(b[i])).raw();
+                if (out[i] != e) fail("q15 multiply", "kernel", a[i], b[i], out[i], e);
+            }
+        });
+        for (std::size_t i = 0; i < n; ++i) {
+            const int16_t r = (q15_t::from_raw(a[i]) * q15_t::from_raw(b[i])).raw();
+            const int16_t e = clamp_wide<int16_t, -32768, 32767>((static_cast<wide_t>(a[i]) * b[i] + 16384) >> 15);
+            if (r != e) fail("q15 multiply", "scalar", a[i], b[i], r, e);
+        }
+    }
+
+    /** Every value of 8 or 16 bit `V`, in order. */
+    template <typename V>
+    std::vector<V> all_values() {
+        std::vector<V> v(std::size_t(1) << (8 * sizeof(V)));
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            v[i] = static_cast<V>(static_cast<long long>(std::numeric_limits<V>::lowest()) + static_cast<long long>(i));
+        }
+        return v;
+    }
+
+    /** Every pair of 8 or 16 bit `V`, one left hand side per task. */
+    template <typename V>
+    void sweep(saturating::thread_pool& pool, std::size_t stride, const char* type) {
+        const std::vector<V> b = all_values<V>();
+        const std::size_t n = b.size();
+        pool.run((n + stride - 1) / stride, [&](std::size_t task) {
+            const V x = b[task * stride];
+            std::vector<V> a(n, x), out(n), res(n);
+            check_all<V>(a.data(), b.data(), out.data(), res.data(), n, type);
+
+            constexpr V lo = std::numeric_limits<V>::lowest(), hi = std::numeric_limits<V>::max();
+            check_divider<V, lo, hi>(b.data(), x, out.data(), n, type);
+            check_divider<V, static_cast<V>(lo / 2 + 3), static_cast<V>(hi / 3)>(b.data(), x, out.data(), n, type);
+            if constexpr (std::is_same_v<V, int16_t>) {
+                check_q15(a.data(), b.data(), out.data(), n);
+            }
+            if constexpr (sizeof(V) == 1) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    const V m = saturating::multiply_table<V>(x, b[i]), d = saturating::divide_table<V>(x, b[i]);
+                    if (m != saturating::multiply<V>(x, b[i])) fail("multiply", "table", x, b[i], m, saturating::multiply<V>(x, b[i]));
+                    if (d != saturating::divide<V>(x, b[i])) fail("divide", "table", x, b[i], d, saturating::divide<V>(x, b[i]));
+                }
+            }
+        });
+    }
+
+    /** Every pair of mixed sign 8 bit operands, through the wide integer loops of the bulk functions. */
+    template <typename T>
+    void sweep_mixed(const char* type) {
+        const std::vector<int8_t> s = all_values<int8_t>();
+        const std::vector<uint8_t> u = all_values<uint8_t>();
+        std::vector<T> out(u.size()), res(u.size());
+        for (const int8_t x : s) {
+            const std::vector<int8_t> a(u.size(), x);
+            check_all<T>(a.data(), u.data(), out.data(), res.data(), u.size(), type);
+            check_all<T>(u.data(), a.data(), out.data(), res.data(), u.size(), type);
+        }
+    }
+
+    /** Limits, the custom limits and their neighbours, zero and one. */
+    template <typename V>
+    std::vector<V> edges() {
+        constexpr V lo = std::numeric_limits<V>::lowest(), hi = std::numeric_limits<V>::max();
+        constexpr V cmin = static_cast<V>(lo / 2 + 3), cmax = static_cast<V>(hi / 3);
+        return { lo, static_cast<V>(lo + 1), static_cast<V>(lo + 2), static_cast<V>(cmin - 1), cmin, static_cast<V>(cmin + 1),
+                 static_cast<V>(-1), 0, 1, 2, static_cast<V>(cmax - 1), cmax, static_cast<V>(cmax + 1), static_cast<V>(hi - 1), hi };
+    }
+
+    /** Raw bits, small values, values close to a limit or a power of two, and the edges, in equal parts. */
+    template <typename V>
+    V sample(splitmix64& gen, const std::vector<V>& edge) {
+        const std::uint64_t r = gen();
+        const V small = static_cast<V>(static_cast<std::int64_t>(r >> 54) - 512);
+        switch (r & 3) {
+            case 0:  return static_cast<V>(gen());
+            case 1:  return small;
+            case 2:  return static_cast<V>((r & 4 ? std::numeric_limits<V>::max() : std::numeric_limits<V>::lowest()) - small);
+            default: return r & 4 ? static_cast<V>(static_cast<V>(std::uint64_t(1) << ((r >> 3) % (8 * sizeof(V)))) + small)
+                                  : edge[(r >> 3) % edge.size()];
+        }
+    }
+
+    /** `tasks` times 65536 sampled pairs of a 32 or 64 bit `V`. */
+    template <typename V>
+    void sweep_sampled(saturating::thread_pool& pool, std::size_t tasks, const char* type) {
+        const std::vector<V> edge = edges<V>();
+        pool.run(tasks, [&](std::size_t task) {
+            splitmix64 gen { task * 0x100000001b3 + sizeof(V) * 2 + std::is_signed_v<V> };
+            std::vector<V> a(65536), b(65536), out(65536), res(65536);
+            for (auto& v : a) v = sample<V>(gen, edge);
+            for (auto& v : b) v = sample<V>(gen, edge);
+            check_all<V>(a.data(), b.data(), out.data(), res.data(), a.size(), type);
+
+            constexpr V lo = std::numeric_limits<V>::lowest(), hi = std::numeric_limits<V>::max();
+            check_divider<V, lo, hi>(a.data(), b[0], out.data(), a.size(), type);
+            check_divider<V, static_cast<V>(lo / 2 + 3), static_cast<V>(hi / 3)>(a.data(), b[1], out.data(), a.size(), type);
+        });
+    }
+
+    /**
+     * Sampled floating point pairs. The reference is the operation in `F` itself, clamped: comparing with `double`
+     * results mixes in the rounding of `F`. Pairs with a NaN result are skipped.
+     */
+    template <typename F>
+    void sweep_float(saturating::thread_pool& pool, std::size_t tasks, const char* type) {
+        constexpr int lo = -1000, hi = 1000;
+        const F edge[] { 0, -F(0), 1, -1, F(lo), F(hi), F(0.5), std::numeric_limits<F>::denorm_min(), std::numeric_limits<F>::min(),
+                         std::numeric_limits<F>::max(), std::numeric_limits<F>::lowest(), std::numeric_limits<F>::infinity(),
+                         -std::numeric_limits<F>::infinity() };
+        pool.run(tasks, [&](std::size_t task) {
+            splitmix64 gen { task + 0xf10a7 * sizeof(F) };
+            const auto value = [&]() -> F {
+                const std::uint64_t r = gen();
+                switch (r & 3) {
+                    case 0:  return edge[(r >> 2) % std::size(edge)];
+                    case 1:  return static_cast<F>(static_cast<double>(static_cast<std::int64_t>(r) >> 11) * 0x1p-41);
+                    default: return static_cast<F>(static_cast<double>(static_cast<std::int64_t>(r) >> 11) * 0x1p-52 * (2 * hi));
+                }
+            };
+            for (std::size_t i = 0; i < 65536; ++i) {
+                const F a = value(), b = value();
+                const auto check = [&](const char* name, F r, F exact) {
+                    if (std::isnan(exact)) return;
+                    const F e = exact < lo ? F(lo) : (exact > hi ? F(hi) : exact);
+                    if (!(r == e)) fail(name, type, a, b, r, e);
+                };
+                check("add", saturating::add<F, lo, hi>(a, b), a + b);
+                check("subtract", saturating::subtract<F, lo, hi>(a, b), a - b);
+                check("multiply", saturating::multiply<F, lo, hi>(a, b), a * b);
+                check("divide", saturating::divide<F, lo, hi>(a, b), a / b);
+            }
+        });
+    }
+
+    /** Narrow `n` values at every level and through `narrow`, against the scalar conversion and the exact value. */
+    template <typename D, limit_t<D> MIN, limit_t<D> MAX, typename S>
+    void check_narrow(const S* in, std::size_t n, const char* type) {
+        using R = saturating::rounding;
+        std::vector<D> ref(n), out(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ref[i] = saturating::detail::convert<D, MIN, MAX, R::even>(in[i]);
+            D e;
+            if constexpr (std::is_floating_point_v<S>) {
+                const long double r = std::nearbyint(static_cast<long double>(in[i]));
+                e = static_cast<D>(r < MIN ? MIN : (r > MAX ? MAX : r));
+            } else {
+                e = clamp_wide<D, MIN, MAX>(static_cast<wide_t>(in[i]));
+            }
+            if (ref[i] != e) fail("narrow", type, in[i], 0, ref[i], e);
+        }
+
+        using K = saturating::detail::narrow_kernel<D, MIN, MAX, S>;
+        if constexpr (saturating::simd::pack_v<saturating::simd::native, D, S>) {
+            each_level<saturating::simd::dispatch<K, std::size_t(const S*, D*, std::size_t)>>([&](int, auto kernel) {
+                const std::size_t done = kernel(in, out.data(), n);
+                for (std::size_t i = 0; i < done; ++i) {
+                    if (out[i] != ref[i]) fail("narrow", "kernel", in[i], 0, out[i], ref[i]);
+                }
+            });
+        }
+
+        std::vector<saturating::type<D, MIN, MAX>> typed(n);
+        saturating::narrow<saturating::type<D, MIN, MAX>, R::even>(in, typed.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (static_cast<D>(typed[i]) != ref[i]) fail("narrow", type, in[i], 0, static_cast<D>(typed[i]), ref[i]);
+        }
+    }
+
+    /** Narrowing to 8 and 16 bit types, full range and custom range. */
+    template <typename S>
+    void check_narrow_all(const S* in, std::size_t n, const char* type) {
+        if constexpr (sizeof(S) > 1 || std::is_floating_point_v<S>) {
+            check_narrow<int8_t, -128, 127>(in, n, type);
+            check_narrow<uint8_t, 0, 255>(in, n, type);
+            check_narrow<int8_t, -100, 50>(in, n, type);
+        }
+        if constexpr (sizeof(S) > 2 || std::is_floating_point_v<S>) {
+            check_narrow<int16_t, -32768, 32767>(in, n, type);
+            check_narrow<uint16_t, 0, 65535>(in, n, type);
+            check_narrow<uint16_t, 1000, 60000>(in, n, type);
+        }
+    }
+
+    /** `tasks` times 65536 sampled narrowing conversions from 32 bit integers and floats. */
+    void sweep_narrow(saturating::thread_pool& pool, std::size_t tasks) {
+        const std::vector<int32_t> edge = edges<int32_t>();
+        pool.run(tasks, [&](std::size_t task) {
+            splitmix64 gen { task ^ 0x6e61727277 };
+            std::vector<int32_t> i32(65536);
+            std::vector<float> f32(65536);
+            for (auto& v : i32) v = sample<int32_t>(gen, edge);
+            for (std::size_t i = 0; i < f32.size(); ++i) {
+                // Halves hit the ties, the scaled ones every magnitude
+                f32[i] = i % 2 ? static_cast<float>(static_cast<int32_t>(gen()) >> 14) * 0.5f
+                               : static_cast<float>(i32[i]) * (i % 4 ? 1.0f : 0x1p-16f);
+            }
+            f32[0] = std::numeric_limits<float>::infinity();
+            f32[1] = -std::numeric_limits<float>::infinity();
+            check_narrow_all(i32.data(), i32.size(), "int32_t");
+            check_narrow_all(f32.data(), f32.size(), "float");
+        });
+    }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::size_t stride = argc > 1 ? std::max(1ul, std::strtoul(argv[1], nullptr, 10)) : 1;
+    saturating::thread_pool pool;
+
+    sweep<int8_t>(pool, 1, "int8_t");
+    sweep<uint8_t>(pool, 1, "uint8_t");
+    sweep_mixed<int8_t>("int8_t, mixed");
+    sweep_mixed<uint8_t>("uint8_t, mixed");
+    sweep<int16_t>(pool, stride, "int16_t");
+    sweep<uint16_t>(pool, stride, "uint16_t");
+
+    const std::vector<int16_t> i16 = all_values<int16_t>();
+    check_narrow_all(i16.data(), i16.size(), "int16_t");
+    sweep_narrow(pool, 64);
+
+    sweep_sampled<int32_t>(pool, 64, "int32_t");
+    sweep_sampled<uint32_t>(pool, 64, "uint32_t");
+    sweep_sampled<int64_t>(pool, 64, "int64_t");
+    sweep_sampled<uint64_t>(pool, 64, "uint64_t");
+    sweep_float<float>(pool, 64, "float");
+    sweep_float<double>(pool, 64, "double");
+
+    if (failures != 0) {
+        std::cout << failures << " mismatches" << std::endl;
+    }
+    assert(failures == 0);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <cassert>
+#include <random>
+#include "../types.hpp"
+#include "../expression.hpp"
+
+using saturating::lazy;
+
+using gain_t = saturating::type<int16_t, -256, 256>;
+
+// Ranges follow the operand limits
+using sum_t = decltype(lazy(int8_t{}) + uint8_t{});
+static_assert(sum_t::exact && sum_t::lo == -128 && sum_t::hi == 382);
+using poly_t = decltype(lazy(int16_t{}) * gain_t{} - int_sat32_t{});
+static_assert(poly_t::exact && poly_t::lo == -32768LL * 256 - 2147483647 && poly_t::hi == 32768LL * 256 + 2147483648LL);
+static_assert(std::is_same_v<saturating::detail::evaluation_t<sum_t::lo, sum_t::hi>, int32_t>);
+static_assert(std::is_same_v<saturating::detail::evaluation_t<poly_t::lo, poly_t::hi>, int64_t>);
+using huge_t = decltype(lazy(int64_t{}) * int64_t{} * int64_t{});
+static_assert(!huge_t::exact);
+
+// Saturated once, intermediate results don't saturate
+static_assert((lazy(uint8_t{ 200 }) + uint8_t{ 100 } - uint8_t{ 100 }).to<uint8_t>() == 200);
+static_assert((lazy(uint8_t{ 200 }) + uint8_t{ 100 }).to<uint8_t>() == 255);
+static_assert((lazy(int8_t{ -100 }) * int8_t{ 100 }).to<int_sat16_t>() == -10000);
+static_assert((lazy(int64_t{ 1 } << 62) * int64_t{ 4 } * int64_t{ 4 } - (int64_t{ 1 } << 62)).to<int64_t>() == INT64_MAX);
+
+/** Exact reference for `a * b + c - d`, clamped to `T`. */
+template <typename T>
+__int128 reference(__int128 a, __int128 b, __int128 c, __int128 d) {
+    const __int128 r = a * b + c - d;
+    return r < saturating::range_of<T>::min_val ? saturating::range_of<T>::min_val
+         : r > saturating::range_of<T>::max_val ? saturating::range_of<T>::max_val
+         : r;
+}
+
+template <typename T, typename A, typename B, typename C, typename G>
+void test_random(G& gen) {
+    for (int i = 0; i < 100000; ++i) {
+        const auto a = static_cast<typename saturating::range_of<A>::value_type>(gen());
+        const auto b = static_cast<typename saturating::range_of<B>::value_type>(gen());
+        const auto c = static_cast<typename saturating::range_of<C>::value_type>(gen());
+        const auto d = static_cast<typename saturating::range_of<C>::value_type>(gen());
+        const A va = A::from(a);
+        const B vb = B::from(b);
+        const C vc = C::from(c), vd = C::from(d);
+        const T r = saturating::lazy(va) * vb + vc - vd;
+        const auto e = reference<T>(static_cast<typename A::value_type>(va), static_cast<typename B::value_type>(vb),
+                                    static_cast<typename C::value_type>(vc), static_cast<typename C::value_type>(vd));
+        if (static_cast<typename T::value_type>(r) != e) {
+            std::cout << "Error in lazy " << +va << " * " << +vb << " + " << +vc << " - " << +vd
+                      << ". Expected: " << static_cast<long long>(e) << ", result: " << +r << std::endl;
+            assert(static_cast<typename T::value_type>(r) == e);
+        }
+    }
+}
+
+int main() {
+    std::mt19937_64 gen(11);
+    test_random<int_sat16_t, int_sat16_t, gain_t, int_sat16_t>(gen);
+    test_random<uint_sat8_t, uint_sat8_t, uint_sat8_t, int_sat8_t>(gen);
+    test_random<gain_t, int_sat8_t, int_sat8_t, gain_t>(gen);
+    test_random<int_sat32_t, int_sat32_t, int_sat32_t, int_sat32_t>(gen);
+    test_random<uint_sat64_t, uint_sat32_t, uint_sat32_t, uint_sat64_t>(gen);
+    // Evaluated in the widest type
+    test_random<int_sat64_t, int_sat64_t, int_sat64_t, int_sat64_t>(gen);
+
+    // Plain values mix in on either side
+    volatile int16_t x = 30000, y = 20000;
+    int_sat16_t s = 10 + lazy(x) + y - x;
+    assert(s == 20010);
+    s = lazy(x) + y;
+    assert(s == 32767);
+    assert((lazy(s) - x * 2).to<int32_t>() == -27233);
+}
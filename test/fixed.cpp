@@ -0,0 +1,103 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../fixed.hpp"
+#include "../bulk.hpp"
+
+using saturating::q15_t;
+using saturating::q31_t;
+using unit8_t = saturating::fixed<uint8_t, 8>;
+using gain_t  = saturating::fixed<int16_t, 15, -16384, 16384>;
+
+static_assert(sizeof(q15_t) == 2 && sizeof(q31_t) == 4);
+static_assert((q15_t::from_raw(0x4000) * q15_t::from_raw(0x4000)).raw() == 0x2000);
+static_assert((q15_t::from_raw(-32768) * q15_t::from_raw(-32768)).raw() == 32767);
+static_assert((q15_t::from_raw(30000) + q15_t::from_raw(30000)).raw() == 32767);
+static_assert((-q15_t::from_raw(-32768)).raw() == 32767);
+static_assert(saturating::multiply_add(q15_t::from_raw(32000), q15_t::from_raw(0x4000), q15_t::from_raw(0x4000)).raw() == 32767);
+
+/** Exact `(a * b + 2^(F - 1)) >> F`, or with `acc << F` added, clamped to the limits of `X`. */
+template <typename X>
+long long reference(long long a, long long b, long long acc = 0) {
+    const __int128 s = static_cast<__int128>(acc) * (__int128{ 1 } << X::frac_bits) + static_cast<__int128>(a) * b;
+    const __int128 half = X::frac_bits ? __int128{ 1 } << (X::frac_bits - 1) : 0;
+    // Floor division, for negative numbers too
+    __int128 r = s + half;
+    r = r >= 0 ? r >> X::frac_bits : -((-r + (__int128{ 1 } << X::frac_bits) - 1) >> X::frac_bits);
+    return r < X::min_val ? X::min_val : (r > X::max_val ? X::max_val : static_cast<long long>(r));
+}
+
+template <typename X, typename G>
+void test_arithmetic(G& gen) {
+    using V = typename X::value_type;
+    std::uniform_int_distribution<long long> dis(std::numeric_limits<V>::lowest(), std::numeric_limits<V>::max());
+    const std::size_t n = 100003;
+    std::vector<X> a(n), b(n), out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = X::from_raw(dis(gen));
+        b[i] = X::from_raw(dis(gen));
+    }
+    // The corners
+    a[0] = X::from_raw(X::min_val); b[0] = X::from_raw(X::min_val);
+    a[1] = X::from_raw(X::max_val); b[1] = X::from_raw(X::min_val);
+    a[2] = X::from_raw(X::max_val); b[2] = X::from_raw(X::max_val);
+
+    saturating::multiply(a.data(), b.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const long long x = a[i].raw(), y = b[i].raw();
+        const long long e = reference<X>(x, y);
+        if ((a[i] * b[i]).raw() != e || out[i].raw() != e) {
+            std::cout << "Error multiplying raw " << x << " and " << y << ". Expected: " << e
+                      << ", scalar: " << +(a[i] * b[i]).raw() << ", bulk: " << +out[i].raw() << std::endl;
+            assert((a[i] * b[i]).raw() == e);
+            assert(out[i].raw() == e);
+        }
+        const long long acc = b[n - 1 - i].raw();
+        const long long m = reference<X>(x, y, acc);
+        if (saturating::multiply_add(b[n - 1 - i], a[i], b[i]).raw() != m) {
+            std::cout << "Error in multiply_add of raw " << acc << " + " << x << " * " << y << ". Expected: " << m
+                      << ", result: " << +saturating::multiply_add(b[n - 1 - i], a[i], b[i]).raw() << std::endl;
+            assert(saturating::multiply_add(b[n - 1 - i], a[i], b[i]).raw() == m);
+        }
+    }
+
+    saturating::add(a.data(), b.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i) assert(out[i] == a[i] + b[i]);
+    saturating::subtract(a.data(), b.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i) assert(out[i] == a[i] - b[i]);
+}
+
+int main() {
+    std::mt19937_64 gen(15);
+    test_arithmetic<q15_t>(gen);
+    test_arithmetic<q31_t>(gen);
+    test_arithmetic<gain_t>(gen);
+    test_arithmetic<unit8_t>(gen);
+    test_arithmetic<saturating::fixed<int8_t, 0>>(gen);
+    test_arithmetic<saturating::fixed<int32_t, 16>>(gen);
+
+    // Floating point conversions round to nearest and saturate
+    assert(q15_t::from(0.5).raw() == 16384);
+    assert(q15_t::from(-1.0).raw() == -32768);
+    assert(q15_t::from(1.0).raw() == 32767);
+    assert(q15_t::from(-1e30).raw() == -32768);
+    assert(q15_t::from(std::numeric_limits<double>::infinity()).raw() == 32767);
+    assert(q15_t::from(std::nan("")).raw() == 0);
+    assert(q15_t::from(0.1f).raw() == 3277);
+    assert(q31_t::from(-0.25).raw() == -(1 << 29));
+    assert(gain_t::from(0.9).raw() == 16384);
+    assert(unit8_t::from(0.5).raw() == 128);
+    assert(unit8_t::from(-0.5).raw() == 0);
+    assert(q15_t::from(0.75).to<double>() == 0.75);
+    assert(std::fabs(q31_t::from(0.3).to() - 0.3) < 1e-9);
+
+    q15_t x = q15_t::from(0.5);
+    x *= q15_t::from(0.5);
+    x += q15_t::from(0.125);
+    x -= q15_t::from(0.0625);
+    assert(x == q15_t::from(0.3125));
+    assert(x > q15_t{} && q15_t{} <= x && x != q15_t{});
+}
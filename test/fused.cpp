@@ -0,0 +1,119 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../functions.hpp"
+#include "../bulk.hpp"
+#include "../types.hpp"
+
+using wide_t = __int128;
+using small_t = saturating::type<int8_t, -10, 10>;
+
+static_assert(saturating::fma<int8_t>(int8_t{ 100 }, int8_t{ 2 }, int8_t{ -100 }) == 100);
+static_assert(saturating::fma<uint8_t>(uint8_t{ 200 }, uint8_t{ 2 }, -300) == 100);
+static_assert(saturating::fma<int16_t>(int8_t{ -128 }, int8_t{ -128 }, 0) == 16384);
+static_assert(saturating::abs_diff<uint8_t>(int8_t{ -128 }, int8_t{ 127 }) == 255);
+static_assert(saturating::abs_diff<int8_t>(uint8_t{ 0 }, uint8_t{ 255 }) == 127);
+static_assert(saturating::lerp<uint8_t>(uint8_t{ 10 }, uint8_t{ 250 }, 0.5) == 130);
+static_assert(saturating::lerp<int8_t>(int8_t{ -100 }, int8_t{ 100 }, 2.0) == 127);
+
+template <typename T>
+wide_t clamped(wide_t v) {
+    return static_cast<wide_t>(v < std::numeric_limits<T>::lowest() ? std::numeric_limits<T>::lowest()
+                                : (v > static_cast<wide_t>(std::numeric_limits<T>::max()) ? std::numeric_limits<T>::max() : v));
+}
+
+/** `fma`, `abs_diff` and `lerp` against exact references. */
+template <typename T, typename A, typename B, typename C>
+void check(const A& a, const B& b, const C& c, double t) {
+    // uint64_t products overflow `__int128`, any overflow is far outside of all result ranges
+    wide_t e1;
+    if (__builtin_mul_overflow(static_cast<wide_t>(a), static_cast<wide_t>(b), &e1) || __builtin_add_overflow(e1, static_cast<wide_t>(c), &e1)) {
+        e1 = (static_cast<wide_t>(a) < 0) != (static_cast<wide_t>(b) < 0) ? std::numeric_limits<long long>::lowest() : std::numeric_limits<wide_t>::max();
+    }
+    const wide_t d  = static_cast<wide_t>(a) - static_cast<wide_t>(b);
+    const T r1 = saturating::fma<T>(a, b, c);
+    const T r2 = saturating::abs_diff<T>(a, b);
+    const T r3 = saturating::lerp<T>(a, b, t);
+    const long double l = static_cast<long double>(a) + static_cast<long double>(t) * (static_cast<long double>(b) - static_cast<long double>(a));
+    const wide_t e3 = l >= static_cast<long double>(std::numeric_limits<T>::max()) ? static_cast<wide_t>(std::numeric_limits<T>::max())
+                    : l <= static_cast<long double>(std::numeric_limits<T>::lowest()) ? static_cast<wide_t>(std::numeric_limits<T>::lowest())
+                    : static_cast<wide_t>(std::round(l));
+    if (static_cast<wide_t>(r1) != clamped<T>(e1) || static_cast<wide_t>(r2) != clamped<T>(d < 0 ? -d : d) ||
+        (static_cast<wide_t>(r3) > e3 ? static_cast<wide_t>(r3) - e3 : e3 - static_cast<wide_t>(r3)) > (sizeof(A) > 4 ? 1024 : 0)) {
+        std::cout << "Error in fma / abs_diff / lerp of " << +a << ", " << +b << ", " << +c << ", " << t
+                  << ". Expected: " << static_cast<long double>(clamped<T>(e1)) << ", " << static_cast<long double>(clamped<T>(d < 0 ? -d : d))
+                  << ", " << static_cast<long double>(e3)
+                  << ", result: " << +r1 << ", " << +r2 << ", " << +r3 << std::endl;
+        assert(static_cast<wide_t>(r1) == clamped<T>(e1));
+        assert(static_cast<wide_t>(r2) == clamped<T>(d < 0 ? -d : d));
+        assert(false);
+    }
+}
+
+template <typename T, typename A, typename B, typename C, typename G>
+void test_random(G& gen) {
+    for (int i = 0; i < 200000; ++i) {
+        std::uniform_real_distribution<double> weight(-0.5, 1.5);
+        check<T>(static_cast<A>(gen()), static_cast<B>(gen()), static_cast<C>(gen()), i % 8 == 0 ? 1.0 : weight(gen));
+    }
+}
+
+int main() {
+    std::mt19937_64 gen(16);
+
+    // All 8 bit products, with a few addends
+    for (int a = -128; a < 128; ++a) {
+        for (int b = -128; b < 128; ++b) {
+            for (int c : { -128, -1, 0, 77, 127 }) {
+                check<int8_t>(static_cast<int8_t>(a), static_cast<int8_t>(b), static_cast<int8_t>(c), 0.25);
+                check<uint8_t>(static_cast<uint8_t>(a), static_cast<uint8_t>(b), static_cast<uint8_t>(c), 0.75);
+                check<int16_t>(static_cast<int8_t>(a), static_cast<uint8_t>(b), static_cast<int8_t>(c), 0.0);
+            }
+        }
+    }
+    test_random<int16_t, int16_t, int16_t, int16_t>(gen);
+    test_random<uint16_t, int16_t, uint16_t, int32_t>(gen);
+    test_random<int32_t, int32_t, int32_t, int32_t>(gen);
+    test_random<uint32_t, uint32_t, uint32_t, int64_t>(gen);
+    test_random<int64_t, int64_t, int64_t, int64_t>(gen);
+    test_random<int64_t, uint64_t, uint64_t, int64_t>(gen);
+    test_random<uint64_t, uint64_t, int64_t, uint64_t>(gen);
+
+    // Saturating types bring their limits, floating point operands round once
+    assert(saturating::fma<int8_t>(small_t{ 10 }, small_t{ 10 }, small_t{ -10 }) == 90);
+    assert((saturating::fma<int8_t, -50, 50>(2.5, 2.5, 0.24) == 6));
+    assert((saturating::fma<float, 0, 1>(0.5f, 0.5f, 0.5f) == 0.75f));
+    assert((saturating::abs_diff<double, 0, 10>(-5.0, 7.5) == 10.0));
+    assert(saturating::lerp<int16_t>(0, 1000, 0.3333f) == 333);
+
+    // Bulk and span versions
+    const std::size_t n = 1001;
+    std::vector<int16_t> a(n), b(n), c(n), out(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<int16_t>(gen());
+        b[i] = static_cast<int16_t>(gen());
+        c[i] = static_cast<int16_t>(gen());
+    }
+    saturating::fma(a.data(), b.data(), c.data(), out.data(), n);
+    for (std::size_t i = 0; i < n; ++i) assert(out[i] == saturating::fma<int16_t>(a[i], b[i], c[i]));
+    saturating::lerp(a.data(), b.data(), 0.625, out.data(), n);
+    for (std::size_t i = 0; i < n; ++i) assert(out[i] == saturating::lerp<int16_t>(a[i], b[i], 0.625));
+    std::vector<uint16_t> diff(n);
+    saturating::abs_diff(a.data(), b.data(), diff.data(), n);
+    for (std::size_t i = 0; i < n; ++i) assert(diff[i] == saturating::abs_diff<uint16_t>(a[i], b[i]));
+#ifdef __cpp_lib_span
+    std::vector<int16_t> spans(n);
+    saturating::fma(std::span(a), std::span(b), std::span(c), std::span(spans));
+    saturating::fma(a.data(), b.data(), c.data(), out.data(), n);
+    assert(spans == out);
+    saturating::lerp(std::span(a), std::span(b), 0.25f, std::span(spans));
+    saturating::lerp(a.data(), b.data(), 0.25f, out.data(), n);
+    assert(spans == out);
+    saturating::abs_diff(std::span(a), std::span(b), std::span(spans));
+    saturating::abs_diff(a.data(), b.data(), out.data(), n);
+    assert(spans == out);
+#endif
+}
@@ -0,0 +1,88 @@
+#include <execution>
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../histogram.hpp"
+#include "../types.hpp"
+
+using level_t = saturating::type<int8_t, 16, 32>;
+using wide_t  = saturating::type<int32_t, -5000, 5000>;
+
+template <typename H, typename U>
+void check(const H& h, const std::vector<U>& x) {
+    H ref;
+    for (const auto& v : x) ref.insert(v);
+    for (std::size_t b = 0; b < H::bins; ++b) {
+        if (h[b] != ref[b]) {
+            std::cout << "Error in histogram bin " << b << ": " << +h[b] << ", expected " << +ref[b] << std::endl;
+            assert(h[b] == ref[b]);
+        }
+    }
+}
+
+int main() {
+    std::mt19937 gen(42);
+
+    // Out of range samples land in the first or last bin
+    saturating::histogram<level_t> h;
+    static_assert(decltype(h)::bins == 17);
+    h.insert(0);
+    h.insert(-100);
+    h.insert(20);
+    h.insert(level_t(32));
+    h.insert(1000);
+    assert(h[0] == 2 && h.count(20) == 1 && h[16] == 2 && h.total() == 5);
+    assert(decltype(h)::value(4) == 20 && decltype(h)::bin(20) == 4);
+
+    // Bulk insertion matches the scalar loop, including runs of one value and the tail
+    std::vector<int> x(100003);
+    std::uniform_int_distribution<int> dis(-10, 60);
+    for (auto& v : x) v = dis(gen);
+    for (std::size_t i = 0; i < 5000; ++i) x[i] = 24;
+    saturating::histogram<level_t> b;
+    b.insert(x.data(), x.size());
+    check(b, x);
+
+    // Parallel insertion and merge, with more bins than one merge range
+    std::vector<int32_t> w(1 << 20);
+    std::uniform_int_distribution<int32_t> wdis(-6000, 6000);
+    for (auto& v : w) v = wdis(gen);
+    saturating::histogram<wide_t> p1, p2;
+    saturating::thread_pool pool(4);
+    p1.insert(pool, w.data(), w.size());
+    check(p1, w);
+    p2.insert(std::execution::par, w.data(), w.size());
+    check(p2, w);
+    p1.merge(p2);
+    assert(p1.total() == 2 * w.size());
+
+    // The widest histograms live on the heap, parallel insertion uses fewer private copies of them
+    using huge_t = saturating::type<int32_t, 0, (1 << 24) - 1>;
+    static_assert(saturating::histogram<huge_t>::bins == 1 << 24);
+    saturating::histogram<huge_t> huge;
+    huge.insert(-1);
+    huge.insert(1 << 30);
+    huge.insert(12345);
+    assert(huge[0] == 1 && huge[(1 << 24) - 1] == 1 && huge.count(12345) == 1 && huge.total() == 3);
+    using large_t = saturating::type<int32_t, 0, (1 << 20) - 1>;
+    std::vector<int32_t> l(1 << 22);
+    std::uniform_int_distribution<int32_t> ldis(-10, 1 << 20);
+    for (auto& v : l) v = ldis(gen);
+    saturating::histogram<large_t> lh;
+    lh.insert(pool, l.data(), l.size());
+    check(lh, l);
+    huge.insert(pool, l.data(), l.size());
+    assert(huge.total() == 3 + l.size());
+
+    // Bins saturate instead of wrapping
+    saturating::histogram<uint_sat8_t, uint_sat8_t> s;
+    std::vector<uint8_t> same(1000, 7);
+    s.insert(same.data(), same.size());
+    assert(s[7] == 255 && s[8] == 0 && s.total() == 255);
+    s.merge(s);
+    assert(s[7] == 255);
+    s.clear();
+    assert(s.total() == 0);
+}
@@ -0,0 +1,124 @@
+#include <iostream>
+#include <cassert>
+#include <limits>
+#include <random>
+#include "../functions.hpp"
+#include "../types.hpp"
+
+using wide_t = __int128;
+using small_t = saturating::type<int8_t, -3, 3>;
+using level_t = saturating::type<uint16_t, 16, 235>;
+
+constexpr int_sat8_t counted(int n) {
+    int_sat8_t c { 120 };
+    for (int i = 0; i < n; ++i) c++;
+    return c;
+}
+static_assert(counted(7) == 127);
+static_assert(counted(100) == 127);
+
+/** `++` and `--` walk the whole range and stop exactly at the limits. */
+template <typename S>
+void test_steps() {
+    using R = saturating::range_of<S>;
+    S s { R::min_val };
+    for (wide_t i = R::min_val; i < R::max_val; ++i) {
+        assert(static_cast<wide_t>(s) == i);
+        const S before = s++;
+        assert(static_cast<wide_t>(before) == i);
+    }
+    assert(s == R::max_val);
+    assert(++s == R::max_val);
+    assert(s++ == R::max_val && s == R::max_val);
+    for (wide_t i = R::max_val; i > R::min_val; --i) --s;
+    assert(s == R::min_val);
+    assert(--s == R::min_val);
+    assert(s-- == R::min_val && s == R::min_val);
+}
+
+/** `add_to` and `subtract_from` against the exact result, clamped. */
+template <typename T, saturating::limit_t<T> MIN, saturating::limit_t<T> MAX, typename U, typename G>
+void test_accumulate(G& gen) {
+    for (int i = 0; i < 200000; ++i) {
+        T out = static_cast<T>(gen());
+        if (out < MIN || out > MAX) out = static_cast<T>(MIN);
+        const U val = static_cast<U>(gen() >> (gen() % 64));
+        for (bool add : { true, false }) {
+            const wide_t e = add ? static_cast<wide_t>(out) + static_cast<wide_t>(val) : static_cast<wide_t>(out) - static_cast<wide_t>(val);
+            const wide_t c = e < MIN ? MIN : (e > MAX ? MAX : e);
+            T r = out;
+            const bool overflow = add ? saturating::add_to<T, MIN, MAX>(r, val) : saturating::subtract_from<T, MIN, MAX>(r, val);
+            if (static_cast<wide_t>(r) != c || overflow != (c != e)) {
+                std::cout << "Error in " << (add ? "add_to " : "subtract_from ") << +out << ", " << +val << " (" << +MIN << "..." << +MAX
+                          << "). Expected: " << static_cast<long double>(c) << ", result: " << +r << ", " << overflow << std::endl;
+                assert(false);
+            }
+        }
+    }
+}
+
+int main() {
+    std::mt19937_64 gen(18);
+
+    test_steps<int_sat8_t>();
+    test_steps<uint_sat8_t>();
+    test_steps<int_sat16_t>();
+    test_steps<small_t>();
+    test_steps<level_t>();
+
+    // Near the limits of the wide types
+    int_sat64_t big { std::numeric_limits<int64_t>::max() - 1 };
+    assert(++big == std::numeric_limits<int64_t>::max() && ++big == std::numeric_limits<int64_t>::max());
+    uint_sat64_t none { 1 };
+    assert(--none == 0u && --none == 0u);
+
+    test_accumulate<int8_t, -128, 127, int8_t>(gen);
+    test_accumulate<uint8_t, 0, 255, int>(gen);
+    test_accumulate<int16_t, -1000, 1000, int16_t>(gen);
+    test_accumulate<uint16_t, 16, 235, uint64_t>(gen);
+    test_accumulate<int32_t, -2147483647 - 1, 2147483647, int32_t>(gen);
+    test_accumulate<uint32_t, 0, 4294967295u, int64_t>(gen);
+    test_accumulate<int64_t, std::numeric_limits<int64_t>::lowest(), std::numeric_limits<int64_t>::max(), int64_t>(gen);
+    test_accumulate<int64_t, -5, 5, uint64_t>(gen);
+    test_accumulate<uint64_t, 0, std::numeric_limits<uint64_t>::max(), int64_t>(gen);
+
+    // Floating point values, rounded once
+    int x = 5;
+    assert(!(saturating::add_to<int, 0, 10>(x, 2.7)) && x == 8);
+    assert((saturating::add_to<int, 0, 10>(x, 2.7)) && x == 10);
+    double d = 0.5;
+    assert(saturating::add_to(d, 0.25f) == false && d == 0.75);
+    assert(saturating::subtract_from(d, 2) == true && d == -1.0);
+
+    // Members and compound operators
+    uint_sat8_t c { 250 };
+    c += 10;
+    assert(c == 255);
+    assert(c.subtract_from(300) && c == 0);
+    assert(!c.add_to(int_sat8_t{ 100 }) && c == 100);
+    c -= 1.4;
+    assert(c == 99);
+    level_t l { 200 };
+    assert(l.add_to(100) && l == 235);
+    l -= level_t{ 235 };
+    assert(l == 16);
+    l *= 100;
+    assert(l == 235);
+    l /= 0;
+    assert(l == 235);
+
+    // Compound operators round floating point operands like the binary ones
+    for (const double v : { -0.5, 0.5, -1.5, 2.5, 0.4, -0.6, 126.5, -300.25 }) {
+        for (const int start : { -128, -1, 0, 1, 127 }) {
+            int_sat8_t x { static_cast<int8_t>(start) }, y = x, z = x, w = x;
+            x += v;
+            y = y + v;
+            z -= v;
+            w = w - v;
+            assert(x == y && z == w);
+        }
+    }
+    int_sat8_t one { 1 };
+    one += -0.5;
+    assert(one == 0);
+}
@@ -1,7 +1,6 @@
 #include <iostream>
 #include <iomanip>
 #include <cassert>
-#include <chrono>
 #include <random>
 #include <limits>
 #include "../functions.hpp"
@@ -40,6 +39,16 @@ constexpr void test_multiply(const A& a, const B& b) {
 }
 
 
+// Native width overflow edges
+static_assert(saturating::multiply<int64_t>(std::numeric_limits<int64_t>::lowest(), int64_t(-1)) == std::numeric_limits<int64_t>::max());
+static_assert(saturating::multiply<int64_t>(std::numeric_limits<int64_t>::max(), int64_t(-2)) == std::numeric_limits<int64_t>::lowest());
+static_assert(saturating::multiply<int64_t>(int64_t(-3037000500), int64_t(-3037000500)) == std::numeric_limits<int64_t>::max());
+static_assert(saturating::multiply<uint64_t>(uint64_t(1) << 32, uint64_t(1) << 32) == std::numeric_limits<uint64_t>::max());
+static_assert(saturating::multiply<int32_t>(int32_t(-65536), int32_t(65536)) == std::numeric_limits<int32_t>::lowest());
+static_assert(saturating::multiply<int32_t>(int32_t(-46341), int32_t(46341)) == std::numeric_limits<int32_t>::lowest());
+static_assert(saturating::multiply<int32_t>(int32_t(-46340), int32_t(46340)) == -2147395600);
+static_assert(saturating::multiply<int8_t, -100, 100>(int8_t(-12), int8_t(12)) == -100);
+
 int main() {
     const unsigned samples = 1'000'000;
     // const unsigned limit = 100;
@@ -48,7 +57,6 @@ int main() {
     std::random_device rd;
     std::uniform_int_distribution<> dis(0, limit);
 
-    auto start = std::chrono::system_clock::now();
     for (unsigned i = 0; i <= samples; ++i) {
         test_multiply<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(dis(rd), dis(rd));
         test_multiply<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(dis(rd),  static_cast<int>(dis(rd)));
@@ -62,7 +70,4 @@ int main() {
         test_multiply<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(dis(rd), 1/static_cast<double>(dis(rd)));
         test_multiply<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(1/static_cast<double>(dis(rd)), dis(rd));
     }
-    auto end = std::chrono::system_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    std::cout << "Multiplication took " << elapsed.count() << " ms" << std::endl;
 }
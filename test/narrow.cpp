@@ -0,0 +1,98 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../bulk.hpp"
+#include "../types.hpp"
+
+using level_t = saturating::type<int8_t, 16, 32>;
+using volume_t = saturating::type<int16_t, -1000, 1000>;
+
+/** Compare `narrow` or `widen` over `x`, at an unaligned offset too, with `Dst::from()` per element. */
+template <typename Dst, saturating::rounding R = saturating::default_rounding, typename Src>
+void check(const std::vector<Src>& x, const char* name) {
+    using DT = typename saturating::range_of<Dst>::value_type;
+    using D = saturating::type<DT, saturating::range_of<Dst>::min_val, saturating::range_of<Dst>::max_val>;
+    std::vector<Dst> out(x.size());
+    for (std::size_t offset : { 0, 3 }) {
+        if constexpr (sizeof(DT) <= sizeof(typename saturating::range_of<Src>::value_type) || std::is_floating_point_v<Src>) {
+            saturating::narrow<Dst, R>(x.data() + offset, out.data(), x.size() - offset);
+        } else {
+            saturating::widen<Dst>(x.data() + offset, out.data(), x.size() - offset);
+        }
+        for (std::size_t i = 0; i + offset < x.size(); ++i) {
+            DT expected;
+            if constexpr (std::is_integral_v<Src> && std::is_integral_v<DT>) {
+                // Exact, `from()` mixes signedness in its compares
+                expected = static_cast<DT>(std::clamp<int64_t>(x[i + offset], saturating::range_of<Dst>::min_val, saturating::range_of<Dst>::max_val));
+            } else {
+                expected = D::template clamp<Src, R>(x[i + offset]);
+            }
+            const DT r = out[i];
+            if (r != expected && !(r != r && expected != expected)) {
+                std::cout << "Error in " << name << " at " << i + offset << ": " << +r << ", expected " << +expected << std::endl;
+                assert(r == expected);
+            }
+        }
+    }
+}
+
+int main() {
+    std::mt19937 gen(42);
+
+    // Every edge around the 8 and 16 bit limits, then random values of all magnitudes
+    std::vector<int32_t> s32;
+    for (int64_t e : { 0ll, 127ll, 128ll, 255ll, 256ll, 32767ll, 32768ll, 65535ll, 65536ll, 2147483647ll }) {
+        for (int64_t d = -2; d <= 2; ++d) {
+            s32.push_back(static_cast<int32_t>(std::clamp<int64_t>(e + d, INT32_MIN, INT32_MAX)));
+            s32.push_back(static_cast<int32_t>(std::clamp<int64_t>(-e + d - 1, INT32_MIN, INT32_MAX)));
+        }
+    }
+    std::uniform_int_distribution<int> shift(0, 31);
+    while (s32.size() < 10007) s32.push_back(static_cast<int32_t>(gen()) >> shift(gen));
+
+    std::vector<int16_t> s16(s32.size());
+    for (std::size_t i = 0; i < s32.size(); ++i) s16[i] = static_cast<int16_t>(s32[i] >> (i % 2 ? 0 : 16));
+    std::vector<int_sat32_t> sat32(s32.begin(), s32.end());
+
+    check<int16_t>(s32, "int32_t to int16_t");
+    check<uint16_t>(s32, "int32_t to uint16_t");
+    check<int8_t>(s32, "int32_t to int8_t");
+    check<uint8_t>(s32, "int32_t to uint8_t");
+    check<int_sat16_t>(sat32, "int_sat32_t to int_sat16_t");
+    check<uint_sat8_t>(sat32, "int_sat32_t to uint_sat8_t");
+    check<level_t>(sat32, "int_sat32_t to level_t");
+    check<volume_t>(s32, "int32_t to volume_t");
+    check<int8_t>(s16, "int16_t to int8_t");
+    check<uint_sat8_t>(s16, "int16_t to uint_sat8_t");
+    check<level_t>(s16, "int16_t to level_t");
+    check<int16_t>(std::vector<int64_t>(s32.begin(), s32.end()), "int64_t to int16_t");
+    check<uint8_t>(std::vector<uint16_t>(s16.begin(), s16.end()), "uint16_t to uint8_t");
+
+    // Floats, including ties, values beyond every limit and NaN
+    std::vector<float> f;
+    for (float v : { 0.5f, 1.5f, 2.5f, -0.5f, -1.5f, -2.5f, 127.5f, 128.5f, 255.5f, -128.5f, 32767.5f, -32768.5f,
+                     65535.5f, 1e10f, -1e10f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                     std::numeric_limits<float>::quiet_NaN() }) {
+        f.push_back(v);
+    }
+    std::uniform_real_distribution<float> fdis(-70000.0f, 70000.0f);
+    while (f.size() < 10007) f.push_back(fdis(gen) / static_cast<float>(1 << shift(gen) / 2));
+    check<int16_t, saturating::rounding::even>(f, "float to int16_t");
+    check<uint16_t, saturating::rounding::even>(f, "float to uint16_t");
+    check<int_sat8_t, saturating::rounding::even>(f, "float to int_sat8_t");
+    check<level_t, saturating::rounding::even>(f, "float to level_t");
+    check<int16_t, saturating::rounding::nearest>(f, "float to int16_t, nearest");
+    check<uint_sat8_t>(f, "float to uint_sat8_t");
+
+    // Widening only clamps where the range of the source crosses a limit
+    check<int_sat32_t>(s16, "int16_t to int_sat32_t");
+    check<volume_t>(std::vector<int8_t>(s16.begin(), s16.end()), "int8_t to volume_t");
+    check<saturating::type<int32_t, 0, 100000>>(s16, "int16_t to type<int32_t, 0, 100000>");
+    check<uint_sat32_t>(s16, "int16_t to uint_sat32_t");
+    check<float>(s16, "int16_t to float");
+    check<double>(f, "float to double");
+}
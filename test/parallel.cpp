@@ -0,0 +1,159 @@
+#include <execution>
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <limits>
+#include <vector>
+#include "../parallel.hpp"
+#include "../types.hpp"
+
+using saturating::reduction;
+
+using custom_t = saturating::type<int16_t, -1000, 1000>;
+using band_t = saturating::type<int32_t, 100, 200>;
+
+template <typename T, typename G>
+std::vector<T> random_values(G& gen, std::size_t n, long long lo, long long hi) {
+    std::uniform_int_distribution<long long> dis(lo, hi);
+    std::vector<T> out(n);
+    for (auto& v : out) v = static_cast<T>(dis(gen));
+    return out;
+}
+
+template <typename T, typename G>
+std::vector<T> random_values(G& gen, std::size_t n) {
+    return random_values<T>(gen, n, std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+}
+
+template <typename T, typename A, typename B, typename Exec>
+void test_elementwise(Exec&& exec, const std::vector<A>& a, const std::vector<B>& b) {
+    // Offset by one element, so the chunks don't start on the cache lines of the inputs
+    const std::size_t n = a.size() - 1;
+    std::vector<T> r1(n), r2(n + 1);
+    const auto check = [&](const char* op) {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (r1[i] != r2[i + 1]) {
+                std::cout << "Error in parallel " << op << " at element " << i << ": " << +a[i] << ", " << +b[i]
+                          << ". Single threaded result: " << +r1[i] << ", parallel: " << +r2[i + 1] << std::endl;
+                assert(r1[i] == r2[i + 1]);
+            }
+        }
+    };
+
+    saturating::add(a.data(), b.data(), r1.data(), n);
+    saturating::add(exec, a.data(), b.data(), r2.data() + 1, n);
+    check("add");
+    saturating::subtract(a.data(), b.data(), r1.data(), n);
+    saturating::subtract(exec, a.data(), b.data(), r2.data() + 1, n);
+    check("subtract");
+    saturating::multiply(a.data(), b.data(), r1.data(), n);
+    saturating::multiply(exec, a.data(), b.data(), r2.data() + 1, n);
+    check("multiply");
+    saturating::divide(a.data(), b.data(), r1.data(), n);
+    saturating::divide(exec, a.data(), b.data(), r2.data() + 1, n);
+    check("divide");
+    saturating::scale_buffer(a.data(), r1.data(), n);
+    saturating::scale_buffer(exec, a.data(), r2.data() + 1, n);
+    check("scale_buffer");
+}
+
+template <typename T, typename V, typename Exec>
+void test_reductions(Exec&& exec, const std::vector<V>& x, const T& init = T{}) {
+    for (const auto mode : { reduction::automatic, reduction::per_step, reduction::once }) {
+        const T r1 = saturating::accumulate(x.data(), x.size(), init, mode);
+        const T r2 = saturating::accumulate(exec, x.data(), x.size(), init, mode);
+        const T d1 = saturating::dot(x.data(), x.data(), x.size(), init, mode);
+        const T d2 = saturating::dot(exec, x.data(), x.data(), x.size(), init, mode);
+        if (r1 != r2 || d1 != d2) {
+            std::cout << "Error in parallel reduction of " << x.size() << " values, mode " << int(mode)
+                      << ". Single threaded sum: " << +r1 << ", parallel: " << +r2
+                      << ", single threaded dot product: " << +d1 << ", parallel: " << +d2 << std::endl;
+            assert(r1 == r2);
+            assert(d1 == d2);
+        }
+
+        std::vector<T> s1(x.size()), s2(x.size() + 1);
+        saturating::inclusive_scan(x.data(), s1.data(), x.size(), init, mode);
+        saturating::inclusive_scan(exec, x.data(), s2.data() + 1, x.size(), init, mode);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if (s1[i] != s2[i + 1]) {
+                std::cout << "Error in parallel scan at element " << i << ", mode " << int(mode)
+                          << ". Single threaded result: " << +s1[i] << ", parallel: " << +s2[i + 1] << std::endl;
+                assert(s1[i] == s2[i + 1]);
+            }
+        }
+    }
+}
+
+template <typename Exec>
+void test_all(Exec&& exec) {
+    std::mt19937_64 gen(42);
+    const std::size_t n = 1'000'003;
+
+    const auto u8a = random_values<uint8_t>(gen, n), u8b = random_values<uint8_t>(gen, n);
+    const auto s8a = random_values<int8_t>(gen, n), s8b = random_values<int8_t>(gen, n);
+    const auto s16a = random_values<int16_t>(gen, n), s16b = random_values<int16_t>(gen, n);
+    const auto u32a = random_values<uint32_t>(gen, n), u32b = random_values<uint32_t>(gen, n);
+    const auto small = random_values<int16_t>(gen, n, -3, 3);
+
+    test_elementwise<uint8_t>(exec, u8a, u8b);
+    test_elementwise<int8_t>(exec, s8a, s8b);
+    test_elementwise<int16_t>(exec, s16a, s16b);
+    test_elementwise<uint32_t>(exec, u32a, u32b);
+    test_elementwise<custom_t>(exec, s16a, s8b);
+
+    test_reductions<uint32_t>(exec, u8a);
+    test_reductions<int8_t>(exec, s8a);
+    test_reductions<int16_t>(exec, s8a, int16_t{ -5 });
+    test_reductions<int32_t>(exec, s16a);
+    test_reductions<uint64_t>(exec, u32a);
+    test_reductions<int16_t>(exec, small);
+    test_reductions<custom_t>(exec, small, custom_t{ 999 });
+
+    // A range excluding the default 0 of `init`
+    const auto bits = random_values<uint8_t>(gen, n, 0, 1);
+    test_reductions<band_t>(exec, bits);
+    test_reductions<band_t>(exec, small);
+
+    // Floating point results can round differently from the single threaded ones, but not between runs
+    std::vector<double> d(small.begin(), small.end());
+    for (auto& v : d) v /= 10000.0;
+    const double f1 = saturating::accumulate(exec, d.data(), d.size(), 0.0);
+    const double f2 = saturating::accumulate(exec, d.data(), d.size(), 0.0);
+    assert(f1 == f2);
+    assert(std::fabs(f1 - saturating::accumulate(d.data(), d.size(), 0.0)) < 1e-9);
+
+    // Nor with the alignment of the buffers, chunks of reductions and scans are split by index
+    std::vector<double> moved(d.size() + 8), scan0(d.size()), scan1(d.size() + 8);
+    saturating::inclusive_scan(exec, d.data(), scan0.data(), d.size(), 0.0);
+    for (std::size_t offset = 1; offset < 8; offset += 3) {
+        std::copy(d.begin(), d.end(), moved.begin() + offset);
+        assert(saturating::accumulate(exec, moved.data() + offset, d.size(), 0.0) == f1);
+        saturating::inclusive_scan(exec, d.data(), scan1.data() + offset, d.size(), 0.0);
+        assert(std::equal(scan0.begin(), scan0.end(), scan1.begin() + offset));
+    }
+
+#ifdef __cpp_lib_span
+    std::vector<uint8_t> out(n);
+    saturating::add(exec, std::span<const uint8_t>{ u8a }, std::span<const uint8_t>{ u8b }, std::span<uint8_t>{ out });
+    assert(out[7] == saturating::add<uint8_t>(u8a[7], u8b[7]));
+    assert(saturating::accumulate<uint32_t>(exec, std::span<const uint8_t>{ u8a }) == saturating::accumulate<uint32_t>(u8a.data(), n));
+#endif
+}
+
+int main() {
+    saturating::thread_pool pool { 4 };
+    test_all(pool);
+    test_all(std::execution::par_unseq);
+
+    saturating::thread_pool single { 1 };
+    test_all(single);
+
+    // Back to back runs with short lived tasks: late workers must not pick up the next (or a finished) run
+    for (int r = 0; r < 20000; ++r) {
+        std::vector<int> hits(2 + r % 7);
+        pool.run(hits.size(), [&](std::size_t i) { ++hits[i]; });
+        for (int h : hits) assert(h == 1);
+    }
+}
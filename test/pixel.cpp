@@ -0,0 +1,68 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../pixel.hpp"
+
+using unit_t  = saturating::type<float, 0, 1>;
+using ten_t   = saturating::type<uint16_t, 0, 1023>;
+
+int main() {
+    std::mt19937_64 gen(15);
+    // Odd sizes, with a tail after the streamed chunks
+    const std::size_t w = 333, h = 77;
+
+    // RGBA8 to planar floats and back is lossless
+    std::vector<uint8_t> rgba(w * h * 4), back(w * h * 4);
+    for (auto& v : rgba) v = static_cast<uint8_t>(gen());
+    rgba[0] = 0; rgba[1] = 255;
+    std::vector<unit_t> planes(w * h * 4);
+    std::array<saturating::plane<unit_t>, 4> rgb;
+    for (std::size_t c = 0; c < 4; ++c) rgb[c] = saturating::planar(planes.data() + c * w * h, w, h);
+
+    saturating::conversion streamed;
+    streamed.stream_bytes = 0;
+    streamed.tile_bytes = 4096;
+    for (const auto& settings : { saturating::conversion{}, streamed }) {
+        saturating::convert(saturating::interleaved<4>(rgba.data(), w, h), rgb, settings);
+        for (std::size_t c = 0; c < 4; ++c) {
+            for (std::size_t i = 0; i < w * h; ++i) {
+                assert(planes[c * w * h + i] == (saturating::scale<float, 0, 1, uint8_t, 0, 255>(rgba[i * 4 + c])));
+            }
+        }
+        saturating::convert(rgb, saturating::interleaved<4>(back.data(), w, h), settings);
+        assert(back == rgba);
+    }
+
+    // 10 bit in 16 to 8 bit and back, exact, a padded destination
+    std::vector<ten_t> tens(w * h);
+    for (auto& v : tens) v = ten_t::from(gen() % 1200);
+    const std::size_t pad = w + 5;
+    std::vector<uint8_t> bytes(pad * h, 42);
+    saturating::convert(saturating::planar(tens.data(), w, h), saturating::planar(bytes.data(), w, h, pad), streamed);
+    for (std::size_t y = 0; y < h; ++y) {
+        for (std::size_t x = 0; x < w; ++x) {
+            assert(bytes[y * pad + x] == static_cast<uint8_t>(saturating::type<uint8_t>::scale_from(tens[y * w + x])));
+        }
+        for (std::size_t x = w; x < pad; ++x) assert(bytes[y * pad + x] == 42);
+    }
+
+    // Gain and offset in destination units, saturated once
+    saturating::conversion lift;
+    lift.gain = 1.5;
+    lift.offset = -100;
+    std::vector<ten_t> lifted(w * h);
+    saturating::convert(saturating::planar(bytes.data(), w, h, pad), saturating::planar(lifted.data(), w, h), lift);
+    for (std::size_t y = 0; y < h; ++y) {
+        for (std::size_t x = 0; x < w; ++x) {
+            const double e = std::round(std::clamp(bytes[y * pad + x] * 1023.0 / 255.0 * 1.5 - 100, 0.0, 1023.0));
+            if (std::fabs(static_cast<uint16_t>(lifted[y * w + x]) - e) > 0.5) {
+                std::cout << "Error converting " << +bytes[y * pad + x] << ". Expected: " << e
+                          << ", result: " << static_cast<uint16_t>(lifted[y * w + x]) << std::endl;
+                assert(static_cast<uint16_t>(lifted[y * w + x]) == e);
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+#define SATURATING_CALLBACKS
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include "../types.hpp"
+
+namespace policy = saturating::policy;
+using saturating::stats::direction;
+using saturating::stats::op;
+
+static int lows = 0;
+static int highs = 0;
+static op last = op::clamp;
+
+/** Count saturations per direction. */
+void count(op o, direction d) noexcept {
+    (d == direction::low ? lows : highs)++;
+    last = o;
+}
+
+using counted_t = saturating::type<int8_t, -100, 100, policy::callback<count>>;
+using counted_u8 = saturating::type<uint8_t, 0, 255, policy::callback<count>>;
+using counted_f = saturating::type<float, -1, 1, policy::callback<count>>;
+using trapped_t = saturating::type<int16_t, -1000, 1000, policy::trap>;
+using plain_t = saturating::type<int8_t, -100, 100>;
+
+/** Expect `l` more low and `h` more high reports (from `o`) after `f`. */
+template <typename F>
+void expect(F f, int l, int h, op o, const char* name) {
+    const int l0 = lows, h0 = highs;
+    f();
+    if (lows - l0 != l || highs - h0 != h || ((l || h) && last != o)) {
+        std::cout << "Error in " << name << ": " << lows - l0 << " low, " << highs - h0 << " high, expected " << l << ", " << h << std::endl;
+        assert(false);
+    }
+}
+
+int main() {
+    // Same layout and range as the unchecked type, the default policy is the plain type
+    static_assert(sizeof(counted_t) == sizeof(int8_t) && sizeof(trapped_t) == sizeof(int16_t));
+    static_assert(std::is_same_v<saturating::type<int8_t, -100, 100, policy::saturate>, plain_t>);
+    static_assert(std::is_same_v<saturating::base_t<counted_t>, int8_t>);
+    static_assert(saturating::range_of<counted_t>::min_val == -100 && saturating::range_of<counted_t>::max_val == 100);
+    static_assert(saturating::is_saturating_v<trapped_t>);
+#ifdef NDEBUG
+    static_assert(std::is_same_v<policy::debug_trap, policy::saturate>);
+#else
+    static_assert(std::is_same_v<policy::debug_trap, policy::trap>);
+#endif
+
+    // Values still saturate, the callback sees every clip with its direction
+    counted_t a = counted_t::from(90);
+    counted_t b = counted_t::from(-90);
+    expect([&] { assert(a + a == 100); }, 0, 1, op::add, "add");
+    expect([&] { assert(b + b == -100); }, 1, 0, op::add, "add");
+    expect([&] { assert(a + b == 0); }, 0, 0, op::add, "add");
+    expect([&] { assert(a - b == 100); }, 0, 1, op::subtract, "subtract");
+    expect([&] { assert(b * a == -100); }, 1, 0, op::multiply, "multiply");
+    expect([&] { assert(a / counted_t::from(0) == 100); }, 0, 1, op::divide, "divide");
+    expect([&] { assert(b / 0 == -100); }, 1, 0, op::divide, "divide");
+    expect([&] { assert(a / 2 == 45); }, 0, 0, op::divide, "divide");
+    expect([&] { assert(counted_t::from(1000) == 100); }, 0, 1, op::clamp, "from");
+    expect([&] { assert(counted_t::from(-100.4) == -100); }, 0, 0, op::clamp, "from");
+    expect([&] { assert(counted_t::from(-101.0) == -100); }, 1, 0, op::clamp, "from");
+    expect([&] { counted_t c = a; c += 20; assert(c == 100); }, 0, 1, op::add, "+=");
+    expect([&] { counted_t c = b; assert(c.subtract_from(20)); }, 1, 0, op::subtract, "subtract_from");
+    expect([&] { counted_t c = b; c *= 2; assert(c == -100); }, 1, 0, op::multiply, "*=");
+    expect([&] { counted_t c = counted_t::from(100); ++c; c++; assert(c == 100); }, 0, 2, op::add, "++");
+    expect([&] { counted_t c = counted_t::from(-99); --c; --c; assert(c == -100); }, 1, 0, op::subtract, "--");
+
+    // Mixed with plain saturating types, the policy of the result type decides
+    expect([&] { assert(a + plain_t::from(50) == 100); }, 0, 1, op::add, "mixed");
+    expect([&] { assert(plain_t::from(50) + a == 100); }, 0, 0, op::add, "mixed");
+
+    // Unsigned wrap arounds and floating point are reported too
+    expect([&] { assert(counted_u8::from(3) - counted_u8::from(5) == 0); }, 1, 0, op::subtract, "unsigned");
+    expect([&] { assert(counted_u8::from(200) * 200 == 255); }, 0, 1, op::multiply, "unsigned");
+    expect([&] { assert(counted_f::from(0.75f) + 0.5f == 1.0f); }, 0, 1, op::add, "float");
+    expect([&] { assert(counted_f::from(0.75f) - 0.5f == 0.25f); }, 0, 0, op::subtract, "float");
+
+    // Reports follow the rounding of the operation, not the unrounded result
+    using narrow_t = saturating::type<int8_t, -10, 10, policy::callback<count>>;
+    using full_t = saturating::type<int8_t, -128, 127, policy::callback<count>>;
+    expect([&] { assert(narrow_t::divide(21, 2) == 10); }, 0, 1, op::divide, "rounded divide");
+    expect([&] { assert(narrow_t::divide(-21, 2) == -10); }, 1, 0, op::divide, "rounded divide");
+    expect([&] { assert(narrow_t::divide(19, 2) == 10); }, 0, 0, op::divide, "rounded divide");
+    expect([&] { assert(full_t::from(127) + 0.4 == 127); }, 0, 0, op::add, "rounded float");
+    expect([&] { assert(full_t::from(127) + 0.5 == 127); }, 0, 1, op::add, "rounded float");
+    expect([&] { assert(full_t::from(-128) - 0.4 == -128); }, 0, 0, op::subtract, "rounded float");
+    expect([&] { assert(full_t::from(-128) - 0.5 == -128); }, 1, 0, op::subtract, "rounded float");
+
+    // Against the exact result over all 8 bit pairs
+    for (int x = -100; x <= 100; ++x) {
+        for (int y = -100; y <= 100; ++y) {
+            const counted_t cx = counted_t::from(x), cy = counted_t::from(y);
+            const int sum = x + y, product = x * y;
+            expect([&] { cx + cy; }, sum < -100, sum > 100, op::add, "add");
+            expect([&] { cx * cy; }, product < -100, product > 100, op::multiply, "multiply");
+            if (y != 0) {
+                // Quotients round half away from zero
+                const int quotient = (2 * x + ((x < 0) != (y < 0) ? -y : y)) / (2 * y);
+                expect([&] { cx / cy; }, quotient < -100, quotient > 100, op::divide, "divide");
+            }
+        }
+    }
+
+    // Trapping types run as usual as long as nothing clips
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dis(-30, 30);
+    trapped_t t = trapped_t::from(0);
+    for (int i = 0; i < 1000; ++i) {
+        t += trapped_t::from(dis(gen));
+        t = t / 2;
+    }
+    assert(t >= -1000 && t <= 1000);
+
+    // Constant evaluation works for values in range, a clipping one would not compile
+    constexpr trapped_t k = trapped_t::from(999) + trapped_t::from(1);
+    static_assert(k == 1000);
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "../functions.hpp"
+#include "../types.hpp"
+
+using wide_t = __int128;
+using pixel_t = saturating::type<int16_t, 0, 1023>;
+
+static_assert(saturating::pow<int16_t>(10, 1000) == 32767);
+static_assert(saturating::pow<int16_t>(-2, 15) == -32768);
+static_assert(saturating::pow<int16_t>(-2, 16) == 32767);
+static_assert(saturating::pow<uint8_t>(0, 0) == 1);
+static_assert(saturating::square<int32_t>(int16_t{ -32768 }) == 1073741824);
+static_assert(saturating::square<uint8_t>(-20) == 255);
+static_assert(saturating::isqrt<int>(99) == 9);
+static_assert(saturating::isqrt<uint8_t>(-5) == 0);
+static_assert(saturating::shift_left<int8_t>(-3, 6) == -128);
+static_assert(saturating::shift_left<int8_t>(3, 5) == 96);
+static_assert(saturating::shift_left<uint8_t>(1, 200) == 255);
+
+template <typename T, saturating::limit_t<T> MIN, saturating::limit_t<T> MAX>
+wide_t clamped(wide_t v) {
+    return v < MIN ? MIN : (v > MAX ? MAX : v);
+}
+
+/** `pow` against repeated multiplication, saturating only at the end. */
+template <typename T, saturating::limit_t<T> MIN, saturating::limit_t<T> MAX, typename U>
+void check_pow(const U& a, unsigned n) {
+    // Magnitudes beyond 2^80 saturate anyway
+    const wide_t m = a < 0 ? -static_cast<wide_t>(a) : static_cast<wide_t>(a);
+    wide_t e = 1;
+    for (unsigned i = 0; i < n && e <= (wide_t(1) << 80); ++i) e *= m;
+    if (a < 0 && (n & 1)) e = -e;
+    const T r = saturating::pow<T, MIN, MAX>(a, n);
+    if (static_cast<wide_t>(r) != clamped<T, MIN, MAX>(e)) {
+        std::cout << "Error in pow<" << +MIN << ", " << +MAX << "> of " << +a << ", " << n
+                  << ". Expected: " << static_cast<long double>(clamped<T, MIN, MAX>(e)) << ", result: " << +r << std::endl;
+        assert((static_cast<wide_t>(r) == clamped<T, MIN, MAX>(e)));
+    }
+    if (n == 2) assert((saturating::square<T, MIN, MAX>(a) == r));
+}
+
+/** `shift_left` against multiplication by a power of two. */
+template <typename T, saturating::limit_t<T> MIN, saturating::limit_t<T> MAX, typename U>
+void check_shift(const U& a, unsigned n) {
+    wide_t e = 0;
+    if (n >= 126 || __builtin_mul_overflow(static_cast<wide_t>(a), wide_t(1) << (n % 126), &e)) e = a < 0 ? MIN : (a > 0 ? MAX : 0);
+    const T r = saturating::shift_left<T, MIN, MAX>(a, n);
+    if (static_cast<wide_t>(r) != clamped<T, MIN, MAX>(e)) {
+        std::cout << "Error in shift_left<" << +MIN << ", " << +MAX << "> of " << +a << ", " << n
+                  << ". Expected: " << static_cast<long double>(clamped<T, MIN, MAX>(e)) << ", result: " << +r << std::endl;
+        assert((static_cast<wide_t>(r) == clamped<T, MIN, MAX>(e)));
+    }
+}
+
+int main() {
+    std::mt19937_64 gen(17);
+
+    // All 8 bit and a sweep of 16 bit bases
+    for (int a = -128; a < 128; ++a) {
+        for (unsigned n = 0; n < 20; ++n) {
+            check_pow<int8_t, -128, 127>(static_cast<int8_t>(a), n);
+            check_pow<uint8_t, 0, 255>(static_cast<uint8_t>(a), n);
+            check_pow<int8_t, -10, 100>(static_cast<int8_t>(a), n);
+            check_pow<uint8_t, 16, 235>(static_cast<int8_t>(a), n);
+            check_pow<int32_t, -100000, 100000>(static_cast<int8_t>(a), n);
+            check_shift<int8_t, -128, 127>(static_cast<int8_t>(a), n);
+            check_shift<uint8_t, 16, 235>(static_cast<int8_t>(a), n);
+            check_shift<int64_t, std::numeric_limits<int64_t>::lowest(), std::numeric_limits<int64_t>::max()>(static_cast<int8_t>(a), n * 4);
+        }
+    }
+    for (int a = -32768; a < 32768; a += 7) {
+        for (unsigned n : { 0u, 1u, 2u, 3u, 4u, 5u, 64u, 65535u }) {
+            check_pow<int16_t, -32768, 32767>(static_cast<int16_t>(a), n);
+            check_pow<int64_t, std::numeric_limits<int64_t>::lowest(), std::numeric_limits<int64_t>::max()>(a, n);
+            check_pow<uint64_t, 0, std::numeric_limits<uint64_t>::max()>(a, n);
+            check_shift<int16_t, -1000, 1000>(a, n);
+        }
+    }
+    for (int i = 0; i < 100000; ++i) {
+        const auto a = static_cast<int64_t>(gen()) >> (gen() % 64);
+        check_pow<int64_t, std::numeric_limits<int64_t>::lowest(), std::numeric_limits<int64_t>::max()>(a, i % 5);
+        check_shift<int64_t, std::numeric_limits<int64_t>::lowest(), std::numeric_limits<int64_t>::max()>(a, i % 66);
+        check_shift<uint64_t, 0, std::numeric_limits<uint64_t>::max()>(static_cast<uint64_t>(a), i % 66);
+    }
+
+    // Integer square roots, run time estimate against the exact bitwise version
+    for (uint64_t n = 0; n < 70000; ++n) {
+        assert(saturating::isqrt<uint64_t>(n) == saturating::detail::isqrt_bits(n));
+        assert(saturating::isqrt<uint8_t>(n) == (n < 65536 ? saturating::detail::isqrt_bits(n) : 255));
+    }
+    for (int i = 0; i < 1000000; ++i) {
+        const uint64_t n = gen() >> (gen() % 64);
+        const uint64_t r = saturating::isqrt<uint64_t>(n);
+        if (r != saturating::detail::isqrt_bits(n) || static_cast<wide_t>(r) * r > n || static_cast<wide_t>(r + 1) * (r + 1) <= n) {
+            std::cout << "Error in isqrt of " << n << ". Result: " << r << std::endl;
+            assert(false);
+        }
+    }
+    assert(saturating::isqrt<uint64_t>(std::numeric_limits<uint64_t>::max()) == 0xFFFFFFFFu);
+    assert(saturating::isqrt<int8_t>(std::numeric_limits<int64_t>::max()) == 127);
+    assert((saturating::isqrt<int8_t, 3, 100>(4) == 3));
+    assert((saturating::isqrt<int8_t, 3, 100>(-4) == 3));
+
+    // Saturating types bring their limits, floating point operands round once
+    const pixel_t p { 40 };
+    assert((saturating::pow<int16_t, 0, 1023>(p, 2) == 1023));
+    assert(saturating::square<int32_t>(p) == 1600);
+    assert(saturating::isqrt<int16_t>(p) == 6);
+    assert((saturating::shift_left<int16_t, 0, 1023>(p, 5) == 1023));
+    assert((saturating::pow<int16_t, 0, 1000>(2.5, 3) == 16));
+    assert(saturating::pow<int8_t>(-1.5, 3) == -3);
+    assert((saturating::pow<double, -10, 10>(1.5, 2) == 2.25));
+    assert((saturating::pow<float, -10, 10>(-3.0f, 3) == -10.0f));
+    assert(saturating::square<int16_t>(1e10) == 32767);
+}
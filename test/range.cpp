@@ -0,0 +1,96 @@
+#include <iostream>
+#include <cassert>
+#include <limits>
+#include <type_traits>
+#include "../types.hpp"
+
+using saturating::detail::range_op;
+using saturating::detail::provably_fits;
+
+using small_t = saturating::type<int8_t, 0, 50>;
+using tiny_t  = saturating::type<int8_t, -10, 10>;
+using big_t   = saturating::type<int16_t, 1000, 1010>;
+
+// Plain operands use their full range
+static_assert( provably_fits<range_op::add,      int32_t,  INT32_MIN, INT32_MAX, int8_t,   int8_t>());
+static_assert( provably_fits<range_op::subtract, int16_t,  INT16_MIN, INT16_MAX, uint8_t,  uint8_t>());
+static_assert(!provably_fits<range_op::subtract, uint16_t, 0,         UINT16_MAX, uint8_t, uint8_t>());
+static_assert( provably_fits<range_op::multiply, int32_t,  INT32_MIN, INT32_MAX, int16_t,  int16_t>());
+// -32768 * -32768 only just doesn't fit
+static_assert(!provably_fits<range_op::multiply, int32_t,  INT32_MIN, INT32_MAX, int16_t,  int32_t>());
+static_assert( provably_fits<range_op::multiply, int64_t,  INT64_MIN, INT64_MAX, int32_t,  int32_t>());
+static_assert( provably_fits<range_op::multiply, uint32_t, 0,         UINT32_MAX, uint16_t, uint16_t>());
+static_assert(!provably_fits<range_op::add,      int32_t,  INT32_MIN, INT32_MAX, int32_t,  int8_t>());
+static_assert(!provably_fits<range_op::add,      int32_t,  -100,      100,       int8_t,   int8_t>());
+static_assert(!provably_fits<range_op::add,      float,    -1,        1,         int8_t,   int8_t>());
+static_assert(!provably_fits<range_op::add,      int32_t,  INT32_MIN, INT32_MAX, float,    int8_t>());
+static_assert(!provably_fits<range_op::multiply, int64_t,  INT64_MIN, INT64_MAX, int64_t,  int8_t>());
+
+// Saturating operands use their own limits
+static_assert( provably_fits<range_op::add,      int8_t,   INT8_MIN,  INT8_MAX,  small_t,  small_t>());
+static_assert( provably_fits<range_op::multiply, int16_t,  INT16_MIN, INT16_MAX, small_t,  small_t>());
+static_assert(!provably_fits<range_op::multiply, int8_t,   INT8_MIN,  INT8_MAX,  small_t,  small_t>());
+static_assert( provably_fits<range_op::multiply, int8_t,   INT8_MIN,  INT8_MAX,  tiny_t,   tiny_t>());
+// The operands don't fit the result type, their difference does
+static_assert( provably_fits<range_op::subtract, int8_t,   INT8_MIN,  INT8_MAX,  big_t,    big_t>());
+static_assert(!provably_fits<range_op::subtract, int8_t,   0,         INT8_MAX,  big_t,    big_t>());
+
+static_assert(saturating::add<int32_t>(int8_t{ -128 }, int8_t{ -128 }) == -256);
+static_assert(saturating::multiply<uint32_t>(uint16_t{ 65535 }, uint16_t{ 65535 }) == 4294836225u);
+static_assert(int_sat8_t::subtract(big_t{ 1000 }, big_t{ 1010 }) == -10);
+
+/**
+ * Compare `op` on all combinations of values in the ranges of `A` and `B` (both 8 or 16 bit) against the exact
+ * result, clamped to `T`.
+ */
+template <typename T, typename A, typename B, typename F>
+void test_exact(const char* name, long exact(long, long), F&& op) {
+    using R = saturating::range_of<T>;
+    for (long i = saturating::range_of<A>::min_val; i <= saturating::range_of<A>::max_val; ++i) {
+        for (long j = saturating::range_of<B>::min_val; j <= saturating::range_of<B>::max_val; ++j) {
+            const A a { static_cast<typename saturating::range_of<A>::value_type>(i) };
+            const B b { static_cast<typename saturating::range_of<B>::value_type>(j) };
+            const long e = exact(i, j);
+            const long r1 = e < R::min_val ? R::min_val : (e > R::max_val ? R::max_val : e);
+            const long r2 = static_cast<long>(static_cast<typename R::value_type>(op(a, b)));
+            if (r1 != r2) {
+                std::cout << "Error in " << name << " of " << i << " and " << j << ". Expected: " << r1 << ", result: " << r2 << std::endl;
+                assert(r1 == r2);
+            }
+        }
+    }
+}
+
+long exact_add(long a, long b) { return a + b; }
+long exact_subtract(long a, long b) { return a - b; }
+long exact_multiply(long a, long b) { return a * b; }
+
+int main() {
+    // Unclamped paths
+    test_exact<int16_t, int8_t, int8_t>("add", exact_add, [](auto a, auto b) { return saturating::add<int16_t>(a, b); });
+    test_exact<int16_t, uint8_t, int8_t>("subtract", exact_subtract, [](auto a, auto b) { return saturating::subtract<int16_t>(a, b); });
+    test_exact<uint16_t, uint8_t, uint8_t>("multiply", exact_multiply, [](auto a, auto b) { return saturating::multiply<uint16_t>(a, b); });
+    test_exact<int8_t, small_t, small_t>("add", exact_add, [](auto a, auto b) { return int_sat8_t::add(a, b); });
+    test_exact<int8_t, big_t, big_t>("subtract", exact_subtract, [](auto a, auto b) { return int_sat8_t::subtract(a, b); });
+    test_exact<int8_t, tiny_t, tiny_t>("multiply", exact_multiply, [](auto a, auto b) { return int_sat8_t::multiply(a, b); });
+
+    // Clamped paths, with saturating operands
+    test_exact<small_t, small_t, small_t>("add", exact_add, [](auto a, auto b) { return a + b; });
+    test_exact<big_t, big_t, int8_t>("subtract", exact_subtract, [](auto a, auto b) { return a - b; });
+    test_exact<int8_t, small_t, small_t>("multiply", exact_multiply, [](auto a, auto b) { return int_sat8_t::multiply(a, b); });
+    test_exact<small_t, small_t, tiny_t>("multiply", exact_multiply, [](auto a, auto b) { return a * b; });
+
+    // Mixed ranges and base types, the result has the type of the left hand side
+    static_assert(std::is_same_v<decltype(small_t{} + tiny_t{}), small_t> && std::is_same_v<decltype(tiny_t{} * big_t{}), tiny_t>);
+    test_exact<tiny_t, tiny_t, small_t>("add", exact_add, [](auto a, auto b) { return a + b; });
+    test_exact<small_t, small_t, tiny_t>("subtract", exact_subtract, [](auto a, auto b) { return a - b; });
+    test_exact<big_t, big_t, tiny_t>("add", exact_add, [](auto a, auto b) { return a + b; });
+    test_exact<tiny_t, tiny_t, big_t>("multiply", exact_multiply, [](auto a, auto b) { return a * b; });
+    test_exact<uint_sat8_t, uint_sat8_t, uint_sat8_t>("add", exact_add, [](auto a, auto b) { return a + b; });
+
+    small_t s { 40 };
+    s += small_t{ 20 };
+    assert(s == 50);
+    s -= tiny_t{ 10 };
+    assert(s == 40);
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <random>
+#include "../functions.hpp"
+#include "../types.hpp"
+
+using saturating::rounding;
+using wide_t = saturating::detail::widest_t;
+
+static_assert(saturating::round<int, rounding::nearest>(2.5) == 3);
+static_assert(saturating::round<int, rounding::nearest>(-2.5) == -3);
+static_assert(saturating::round<int, rounding::even>(2.5) == 2);
+static_assert(saturating::round<int, rounding::even>(-3.5f) == -4);
+static_assert(saturating::round<long long, rounding::nearest>(1e300) == std::numeric_limits<long long>::max());
+static_assert(saturating::round<long long, rounding::nearest>(-1e300) == std::numeric_limits<long long>::lowest());
+
+/** The inline rounding against `std::lround` / `std::nearbyint` (round to even by default). */
+template <typename F, typename G>
+void test_round(G& gen) {
+    std::uniform_real_distribution<F> dis(-1e6, 1e6);
+    for (int i = 0; i < 1000000; ++i) {
+        F v = dis(gen);
+        if (i % 4 == 0) v = std::floor(v) + F(0.5);
+        if (i % 4 == 1) v = std::ldexp(v, static_cast<int>(gen() % 43)); // Within the range of `std::llround`
+        const long long e = std::llround(v);
+        const long long r = saturating::round<long long, rounding::nearest>(v);
+        const long long even = saturating::round<long long, rounding::even>(v);
+        if (r != e || even != static_cast<long long>(std::nearbyint(v))) {
+            std::cout << "Error rounding " << v << ". Expected: " << e << ", " << std::nearbyint(v)
+                      << ", result: " << r << ", " << even << std::endl;
+            assert(r == e);
+            assert(even == static_cast<long long>(std::nearbyint(v)));
+        }
+    }
+    assert((saturating::round<int, rounding::nearest>(std::numeric_limits<F>::quiet_NaN()) == 0));
+    assert((saturating::round<int, rounding::nearest>(std::numeric_limits<F>::infinity()) == std::numeric_limits<long>::max()));
+    assert((saturating::round<int, rounding::nearest>(-std::numeric_limits<F>::infinity()) == std::numeric_limits<long>::lowest()));
+}
+
+int main() {
+    std::mt19937_64 gen(14);
+    test_round<float>(gen);
+    test_round<double>(gen);
+
+    // Out of range floating point operands saturate to the right side (`std::lround` doesn't)
+    if constexpr (saturating::default_rounding != rounding::library) {
+        volatile double huge = 1e30;
+        assert(saturating::add<int8_t>(huge, 0.0) == 127);
+        assert(saturating::add<int8_t>(-huge, 0) == -128);
+        assert(saturating::multiply<uint16_t>(huge, 2) == 65535);
+        assert(saturating::divide<int32_t>(huge, -0.5) == std::numeric_limits<int32_t>::lowest());
+        assert(int_sat8_t::clamp(-huge) == -128);
+        assert(int_sat16_t::clamp(std::nan("")) == 0);
+    }
+    // Unsigned 64 bit targets round beyond 2^63 and keep negative values for mixed operations
+    static_assert(saturating::round<uint64_t, rounding::nearest>(0x1p63) == (wide_t(1) << 63));
+    static_assert(saturating::round<uint64_t, rounding::even>(0x1.fffffffffffffp63) == wide_t(0xfffffffffffff800));
+    static_assert(saturating::round<uint64_t, rounding::nearest>(-2.5) == -3);
+    for (const rounding r : { rounding::library, rounding::nearest, rounding::even }) {
+        const auto clamp = [r](long double v) {
+            return r == rounding::library ? uint_sat64_t::clamp<long double, rounding::library>(v)
+                 : r == rounding::nearest ? uint_sat64_t::clamp<long double, rounding::nearest>(v)
+                                          : uint_sat64_t::clamp<long double, rounding::even>(v);
+        };
+        assert(clamp(0x1p63L) == uint64_t(1) << 63);
+        assert(clamp(0x1p63L + 4096.0L) == (uint64_t(1) << 63) + 4096);
+        assert(clamp(1.5e19L) == 15000000000000000000ull);
+        assert(clamp(0x1p64L) == std::numeric_limits<uint64_t>::max());
+        assert(clamp(1e30L) == std::numeric_limits<uint64_t>::max());
+        assert(clamp(-1.0L) == 0);
+    }
+    volatile double big = 0x1p63;
+    assert(saturating::add<uint64_t>(big, 0.0) == uint64_t(1) << 63);
+    assert(saturating::multiply<uint64_t>(big, 1.5) == (uint64_t(3) << 62));
+    assert(saturating::add<uint64_t>(-5.0, 10) == 5);
+    assert(saturating::add<uint64_t>(big, uint64_t(1)) == (uint64_t(1) << 63) + 1);
+
+    assert((saturating::type<int8_t, -10, 10>::clamp<double, rounding::even>(4.5) == 4));
+    assert((saturating::type<int8_t, -10, 10>::clamp<double, rounding::library>(4.5) == 5));
+    assert(int_sat8_t::clamp(4.5) == (saturating::default_rounding == rounding::even ? 4 : 5));
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <cassert>
+#include <limits>
+#include <vector>
+#include "../bulk.hpp"
+#include "../types.hpp"
+
+/**
+ * Scale all values of `Src` to `Dst` with both `scale_from` and `scale_buffer`, comparing against an exact
+ * rational reference rounded half up.
+ */
+template <typename Dst, typename Src>
+void test_scale() {
+    using S = typename Src::value_type;
+    using D = typename Dst::value_type;
+    const __int128_t in_width  = static_cast<__int128_t>(Src::max_val) - Src::min_val;
+    const __int128_t out_width = static_cast<__int128_t>(Dst::max_val) - Dst::min_val;
+
+    std::vector<Src> in;
+    for (long i = std::numeric_limits<S>::lowest(); i <= std::numeric_limits<S>::max(); ++i) {
+        in.push_back(Src{ static_cast<S>(i) });
+    }
+    std::vector<Dst> out(in.size());
+    saturating::scale_buffer(in.data(), out.data(), in.size());
+
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        const __int128_t v = static_cast<S>(in[i]);
+        const __int128_t x = (v < Src::min_val ? Src::min_val : (v > Src::max_val ? Src::max_val : v)) - Src::min_val;
+        const auto r1 = static_cast<D>(Dst::min_val + (2 * x * out_width + in_width) / (2 * in_width));
+        const auto r2 = static_cast<D>(Dst::scale_from(in[i]));
+        const auto r3 = static_cast<D>(out[i]);
+        if (r1 != r2 || r1 != r3) {
+            std::cout << "Error scaling " << +static_cast<S>(in[i])
+                      << " (" << +Src::min_val << "..." << +Src::max_val << ") to ("
+                      << +Dst::min_val << "..." << +Dst::max_val << ")"
+                      << ". Exact: " << +r1
+                      << ", scale_from: " << +r2
+                      << ", scale_buffer: " << +r3 << std::endl;
+            assert(r1 == r2);
+            assert(r1 == r3);
+        }
+    }
+}
+
+int main() {
+    using custom1 = saturating::type<int8_t, 16, 32>;
+    using custom2 = saturating::type<uint8_t, 10, 250>;
+    using custom3 = saturating::type<int16_t, -1000, 1000>;
+    using custom4 = saturating::type<uint16_t, 0, 4095>;
+
+    test_scale<custom1, int_sat16_t>();
+    test_scale<custom1, uint_sat16_t>();
+    test_scale<custom1, int_sat8_t>();
+    test_scale<uint_sat8_t, uint_sat16_t>();
+    test_scale<uint_sat16_t, uint_sat8_t>();
+    test_scale<int_sat8_t, uint_sat8_t>();
+    test_scale<int_sat16_t, custom2>();
+    test_scale<custom2, custom3>();
+    test_scale<custom3, custom4>();
+    test_scale<custom4, uint_sat16_t>();
+    test_scale<int_sat32_t, uint_sat16_t>();
+    test_scale<uint_sat64_t, int_sat16_t>();
+    test_scale<int_sat8_t, int_sat8_t>();
+
+    // Range edges map exactly
+    static_assert(custom1::scale_from(int_sat16_t{ -32768 }) == 16);
+    static_assert(custom1::scale_from(int_sat16_t{ 32767 }) == 32);
+    static_assert(uint_sat16_t::scale_from(uint_sat8_t{ 255 }) == 65535);
+    static_assert(uint_sat8_t::scale_from(uint_sat32_t{ 4294967295u }) == 255);
+    // Out of range input is clamped first
+    static_assert(custom4::scale_from(custom3{ 2000 }) == 4095);
+}
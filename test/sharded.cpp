@@ -0,0 +1,109 @@
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../sharded_counter.hpp"
+#include "../types.hpp"
+
+using events_t = saturating::type<uint32_t, 0, 5000000>;
+using level_t  = saturating::type<int16_t, -1000, 1000>;
+
+/** Run `f(thread index)` on `n` threads. */
+template <typename F>
+void run(unsigned n, const F& f) {
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < n; ++t) threads.emplace_back(f, t);
+    for (auto& t : threads) t.join();
+}
+
+int main() {
+    const unsigned threads = 16;
+
+    // More threads than shards, some share the extra shard
+    saturating::sharded_counter<events_t, 4> events;
+    run(threads, [&](unsigned) { for (int i = 0; i < 100000; ++i) ++events; });
+    assert(events.load() == threads * 100000u && !events.saturated());
+    run(threads, [&](unsigned t) { for (int i = 0; i < 10000; ++i) events += t; });
+    assert(events.load() == threads * 100000u + 10000u * (threads * (threads - 1) / 2) && !events.saturated());
+
+    // Exactly `MAX` is not saturated, a single step beyond it is and stays so
+    events.reset();
+    run(4, [&](unsigned) { events.add(1250000); });
+    assert(events.load() == 5000000u && !events.saturated());
+    events.add(1);
+    assert(events.load() == 5000000u && events.saturated());
+    events.subtract(10);
+    assert(events.load() == 4999991u && events.saturated());
+
+    // The total saturates once, not after each update
+    saturating::sharded_counter<level_t> level;
+    std::vector<long> sums(threads);
+    run(threads, [&](unsigned t) {
+        std::mt19937 g(t);
+        for (int i = 0; i < 100000; ++i) {
+            const int d = static_cast<int>(g() % 21) - 10;
+            if (i % 2) {
+                level.add(d);
+                sums[t] += d;
+            } else {
+                level -= d;
+                sums[t] -= d;
+            }
+        }
+    });
+    long total = 0;
+    for (long s : sums) total += s;
+    assert(level.load() == (total < -1000 ? -1000 : (total > 1000 ? 1000 : total)));
+    assert(level.saturated() == (total < -1000 || total > 1000));
+
+    // Shards hold signed partial sums: subtracting on one live thread what another one added leaves no trace
+    saturating::sharded_counter<saturating::type<uint32_t, 0, 1000>> pending;
+    std::atomic<unsigned> arrived{ 0 }, finished{ 0 };
+    const auto barrier = [](std::atomic<unsigned>& count, unsigned n) {
+        count.fetch_add(1);
+        while (count.load() < n) std::this_thread::yield();
+    };
+    run(2, [&](unsigned t) {
+        if (t == 0) pending.add(10);
+        barrier(arrived, 2);
+        if (t == 1) pending.subtract(5);
+        barrier(finished, 2);
+    });
+    assert(pending.load() == 5 && !pending.saturated());
+    pending.reset();
+    arrived = 0;
+    finished = 0;
+    run(threads, [&](unsigned t) {
+        barrier(arrived, threads);
+        for (int i = 0; i < 10000; ++i) {
+            if (t % 2) {
+                pending -= 1;
+            } else {
+                pending += 1;
+            }
+        }
+        barrier(finished, threads);
+    });
+    assert(pending.load() == 0 && !pending.saturated());
+
+    // Full range types saturate the total at the limits of `T`
+    saturating::sharded_counter<uint_sat8_t, 2> small;
+    for (int i = 0; i < 300; ++i) ++small;
+    assert(small.load() == 255 && small.saturated());
+    small.reset();
+    small -= 1;
+    assert(small.load() == 0 && small.saturated());
+
+    // Plain integers use their full range
+    saturating::sharded_counter<int64_t> big;
+    big += std::numeric_limits<int64_t>::max();
+    std::thread([&] { big += 5; }).join();
+    assert(big.load() == std::numeric_limits<int64_t>::max() && big.saturated());
+    big.reset();
+    std::thread([&] { big -= std::numeric_limits<int64_t>::max(); }).join();
+    big += std::numeric_limits<int64_t>::max();
+    assert(big.load() == 0 && !big.saturated());
+}
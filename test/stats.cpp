@@ -0,0 +1,88 @@
+#define SATURATING_STATS
+
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <vector>
+#include "../types.hpp"
+#include "../divider.hpp"
+#include "../stats.hpp"
+
+using saturating::stats::op;
+using saturating::stats::direction;
+
+// Constant evaluation still works, and isn't counted
+static_assert(saturating::add<uint8_t>(200, 100) == 255);
+static_assert(saturating::multiply<int16_t>(-300, 300) == -32768);
+
+void expect(op o, direction d, std::uint64_t n) {
+    const auto s = saturating::stats::snapshot();
+    if (s(o, d) != n) {
+        std::cout << "Error counting op " << unsigned(o) << ", direction " << unsigned(d)
+                  << ". Expected: " << n << ", counted: " << s(o, d) << std::endl;
+        assert(s(o, d) == n);
+    }
+}
+
+int main() {
+    static_assert(saturating::stats::enabled);
+    saturating::stats::reset();
+    assert(saturating::stats::snapshot().total() == 0);
+
+    volatile int8_t big = 100, small = -100, one = 1;
+
+    // No saturation, nothing counted
+    (void)saturating::add<int8_t>(big, small);
+    (void)saturating::multiply<int8_t>(one, small);
+    assert(saturating::stats::snapshot().total() == 0);
+
+    (void)saturating::add<int8_t>(big, big);
+    (void)saturating::add<int8_t>(small, small);
+    (void)saturating::add<int8_t>(small, small);
+    expect(op::add, direction::high, 1);
+    expect(op::add, direction::low, 2);
+
+    (void)saturating::subtract<uint8_t>(uint8_t{ 3 }, uint8_t{ 5 });
+    expect(op::subtract, direction::low, 1);
+    (void)saturating::add<int8_t, -50, 50>(big, small);
+    (void)saturating::add<int8_t, -50, 50>(big, one);
+    expect(op::add, direction::high, 2);
+
+    (void)saturating::multiply<int8_t>(big, small);
+    (void)saturating::multiply<int64_t>(int64_t{ 1 } << 40, int64_t{ 1 } << 40);
+    expect(op::multiply, direction::low, 1);
+    expect(op::multiply, direction::high, 1);
+
+    (void)saturating::divide<int8_t>(small, int8_t{ 0 });
+    (void)saturating::divide<int8_t>(int8_t{ -128 }, int8_t{ -1 });
+    expect(op::divide, direction::low, 1);
+    expect(op::divide, direction::high, 1);
+    const saturating::divider<int8_t> d { int8_t{ -1 } };
+    (void)d(int8_t{ -128 });
+    expect(op::divide, direction::high, 2);
+
+    // Saturating types count through the same functions, `from()` counts as clamp
+    uint_sat8_t s = 250;
+    s += 10;
+    s = uint8_t{ 7 };
+    s -= 8;
+    expect(op::add, direction::high, 3);
+    expect(op::subtract, direction::low, 2);
+    (void)uint_sat8_t::from(300);
+    (void)int_sat8_t::from(-300);
+    expect(op::clamp, direction::high, 1);
+    expect(op::clamp, direction::low, 1);
+
+    // Counters are shared between threads
+    saturating::stats::reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10000; ++i) (void)saturating::add<int8_t>(big, big);
+        });
+    }
+    for (auto& t : threads) t.join();
+    expect(op::add, direction::high, 40000);
+    assert(saturating::stats::snapshot()(op::add) == 40000);
+    assert(saturating::stats::snapshot().total() == 40000);
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../stream.hpp"
+#include "../types.hpp"
+
+using level_t = saturating::type<int16_t, -1000, 1000>;
+
+/** Feed `x` to `p` in chunks of random size, starting at random offsets, and compare with one pass over `x`. */
+template <typename P, typename A, typename T>
+void check_chunked(const std::vector<A>& x, std::mt19937& gen, const char* name) {
+    using VT = typename saturating::range_of<T>::value_type;
+    std::vector<T> once(x.size()), chunked(x.size() + 64);
+    P p1, p2;
+    p1(x.data(), once.data(), x.size());
+
+    // Unaligned output offsets exercise the head, run and tail split
+    std::uniform_int_distribution<std::size_t> size_dis(0, 300);
+    std::uniform_int_distribution<std::size_t> offset_dis(0, 63);
+    const std::size_t offset = offset_dis(gen);
+    for (std::size_t i = 0; i < x.size();) {
+        const std::size_t n = std::min(size_dis(gen), x.size() - i);
+        p2(x.data() + i, chunked.data() + offset + i, n);
+        i += n;
+    }
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        if (chunked[offset + i] != once[i]) {
+            std::cout << "Error in " << name << " at " << i << ": " << +static_cast<VT>(chunked[offset + i])
+                      << ", expected " << +static_cast<VT>(once[i]) << std::endl;
+            assert(chunked[offset + i] == once[i]);
+        }
+    }
+}
+
+int main() {
+    namespace stream = saturating::stream;
+    using saturating::stream_processor;
+    std::mt19937 gen(42);
+
+    std::vector<int8_t> s8(20000);
+    std::uniform_int_distribution<int> dis8(-128, 127);
+    for (auto& v : s8) v = static_cast<int8_t>(dis8(gen));
+    std::vector<int16_t> s16(20000);
+    std::uniform_int_distribution<int> dis16(-1500, 1500);
+    for (auto& v : s16) v = static_cast<int16_t>(dis16(gen));
+
+    // Running sums saturate per step, also across chunks
+    std::vector<int8_t> rs(6);
+    const int8_t steps[6] { 100, 100, -50, -100, -100, 60 };
+    stream_processor<stream::running_sum, int8_t> r;
+    r(steps, rs.data(), 3);
+    r(steps + 3, rs.data() + 3, 3);
+    assert(rs[1] == 127 && rs[2] == 77 && rs[4] == -123 && rs[5] == -63 && r.total() == -63);
+    assert(r.add(steps, 2) == 127);
+    r.reset();
+    assert(r.total() == 0);
+    check_chunked<stream_processor<stream::running_sum, int8_t>, int8_t, int8_t>(s8, gen, "running_sum<int8_t>");
+    check_chunked<stream_processor<stream::running_sum, level_t, int16_t>, int16_t, level_t>(s16, gen, "running_sum<level_t>");
+
+    // Starting at the default 0 below a range excluding it, the first sample is clamped with it
+    using band_t = saturating::type<int32_t, 100, 200>;
+    const uint8_t fives[3] { 5, 5, 5 };
+    band_t bs[3];
+    stream_processor<stream::running_sum, band_t, uint8_t> b;
+    b(fives, bs, 1);
+    b(fives + 1, bs + 1, 2);
+    assert(bs[0] == 100 && bs[1] == 105 && bs[2] == 110 && b.total() == 110);
+    check_chunked<stream_processor<stream::running_sum, band_t, uint8_t>, uint8_t, band_t>(
+        std::vector<uint8_t>(s8.begin(), s8.end()), gen, "running_sum<band_t>");
+
+    // Deltas use the last sample of the previous chunk
+    std::vector<int8_t> d(6);
+    stream_processor<stream::delta, int8_t> dp;
+    dp(steps, d.data(), 2);
+    dp(steps + 2, d.data() + 2, 4);
+    assert(d[0] == 100 && d[1] == 0 && d[2] == -128 && d[3] == -50 && d[4] == 0 && d[5] == 127);
+    assert(dp.previous() == 60);
+    check_chunked<stream_processor<stream::delta, int8_t>, int8_t, int8_t>(s8, gen, "delta<int8_t>");
+    check_chunked<stream_processor<stream::delta, uint8_t, uint8_t>, uint8_t, uint8_t>(
+        std::vector<uint8_t>(s8.begin(), s8.end()), gen, "delta<uint8_t>");
+    check_chunked<stream_processor<stream::delta, int16_t>, int16_t, int16_t>(s16, gen, "delta<int16_t>");
+    check_chunked<stream_processor<stream::delta, level_t, int16_t>, int16_t, level_t>(s16, gen, "delta<level_t>");
+    check_chunked<stream_processor<stream::delta, int32_t, int8_t>, int8_t, int32_t>(s8, gen, "delta<int32_t>");
+
+    // The one pass deltas equal the scalar template
+    std::vector<int16_t> ds(s16.size());
+    stream_processor<stream::delta, int16_t>{}(s16.data(), ds.data(), s16.size());
+    for (std::size_t i = 1; i < s16.size(); ++i) {
+        assert(ds[i] == saturating::subtract<int16_t>(s16[i], s16[i - 1]));
+    }
+
+    // Moving sums are exact within the window and saturated once
+    std::vector<int8_t> m(6);
+    stream_processor<stream::moving_sum<3>, int8_t> mp;
+    mp(steps, m.data(), 4);
+    mp(steps + 4, m.data() + 4, 2);
+    assert(m[0] == 100 && m[1] == 127 && m[2] == 127 && m[3] == -50 && m[4] == -128 && m[5] == -128 && mp.total() == -128);
+    mp.reset();
+    assert(mp.total() == 0);
+    check_chunked<stream_processor<stream::moving_sum<16>, int8_t>, int8_t, int8_t>(s8, gen, "moving_sum<16, int8_t>");
+    check_chunked<stream_processor<stream::moving_sum<1000>, level_t, int16_t>, int16_t, level_t>(s16, gen, "moving_sum<1000, level_t>");
+}
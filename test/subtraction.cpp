@@ -1,6 +1,5 @@
 #include <iostream>
 #include <cassert>
-#include <chrono>
 #include <random>
 #include <limits>
 #include "../functions.hpp"
@@ -44,7 +43,6 @@ int main() {
     std::random_device rd;
     std::uniform_int_distribution<> dis(0, limit);
 
-    auto start = std::chrono::system_clock::now();
     for (unsigned i = 0; i <= samples; ++i) {
         test_subtract<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(dis(rd), dis(rd));
         test_subtract<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(dis(rd),  static_cast<int>(dis(rd)));
@@ -58,7 +56,4 @@ int main() {
         test_subtract<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(dis(rd), 1/static_cast<double>(dis(rd)));
         test_subtract<int_sat8_t, int_sat16_t, int_sat32_t, int_sat64_t, uint_sat8_t, uint_sat16_t, uint_sat32_t, uint_sat64_t, float_sat_t, double_sat_t>(1/static_cast<double>(dis(rd)), dis(rd));
     }
-    auto end = std::chrono::system_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    std::cout << "Subtraction took " << elapsed.count() << " ms" << std::endl;
 }
@@ -0,0 +1,60 @@
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <vector>
+#include "../table.hpp"
+#include "../types.hpp"
+
+using level_t = saturating::type<int8_t, 16, 32>;
+using gain_t  = saturating::type<uint8_t, 0, 100>;
+
+// Filled at compile time, with exactly the results of the scalar functions
+constexpr saturating::table<uint_sat8_t> add_table { [](const uint_sat8_t& a, const uint_sat8_t& b) { return a + b; } };
+static_assert(add_table(uint_sat8_t{ 200 }, uint_sat8_t{ 100 }) == 255 && add_table(uint_sat8_t{ 20 }, uint_sat8_t{ 10 }) == 30);
+constexpr saturating::unary_table<level_t, uint_sat8_t> to_level { [](const uint_sat8_t& a) { return level_t::scale_from(a); } };
+static_assert(to_level(uint_sat8_t{ 0 }) == 16 && to_level(uint_sat8_t{ 255 }) == 32);
+
+/** Compare table `t` against `op` for all operand values. */
+template <typename Table, typename A, typename B, typename F>
+void check(const Table& t, F op, const char* name) {
+    for (int i = 0; i < 256; ++i) {
+        for (int j = 0; j < 256; ++j) {
+            const A a(static_cast<typename saturating::range_of<A>::value_type>(i));
+            const B b(static_cast<typename saturating::range_of<B>::value_type>(j));
+            if (t(a, b) != op(a, b)) {
+                std::cout << "Error in " << name << " table for " << +a << ", " << +b << ": " << +t(a, b) << ", expected " << +op(a, b) << std::endl;
+                assert(t(a, b) == op(a, b));
+            }
+        }
+    }
+}
+
+int main() {
+    check<decltype(saturating::multiply_table<uint_sat8_t>), uint_sat8_t, uint_sat8_t>(saturating::multiply_table<uint_sat8_t>,
+        [](auto a, auto b) { return a * b; }, "uint8 multiply");
+    check<decltype(saturating::multiply_table<int_sat8_t>), int_sat8_t, int_sat8_t>(saturating::multiply_table<int_sat8_t>,
+        [](auto a, auto b) { return a * b; }, "int8 multiply");
+    check<decltype(saturating::divide_table<int_sat8_t>), int_sat8_t, int_sat8_t>(saturating::divide_table<int_sat8_t>,
+        [](auto a, auto b) { return a / b; }, "int8 divide");
+    check<decltype(saturating::divide_table<uint8_t>), uint8_t, uint8_t>(saturating::divide_table<uint8_t>,
+        [](auto a, auto b) { return saturating::divide<uint8_t>(a, b); }, "plain uint8 divide");
+
+    // Bulk lookups over raw bytes and saturating types alike
+    std::mt19937 gen(7);
+    std::vector<uint8_t> a(1001), b(1001);
+    for (auto& v : a) v = static_cast<uint8_t>(gen());
+    for (auto& v : b) v = static_cast<uint8_t>(gen());
+    std::vector<uint_sat8_t> out(a.size());
+    saturating::apply(saturating::multiply_table<uint_sat8_t>, a.data(), b.data(), out.data(), a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        assert(out[i] == saturating::multiply<uint8_t>(a[i], b[i]));
+    }
+
+    std::vector<gain_t> g(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) g[i] = gain_t::from(a[i]);
+    std::vector<level_t> levels(g.size());
+    saturating::apply(saturating::scale_table<level_t, gain_t>, g.data(), levels.data(), g.size());
+    for (std::size_t i = 0; i < g.size(); ++i) {
+        assert(levels[i] == level_t::scale_from(g[i]));
+    }
+}
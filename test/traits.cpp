@@ -0,0 +1,38 @@
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include "../types.hpp"
+
+using level_t = saturating::type<int8_t, 16, 32>;
+using gain_t  = saturating::type<uint16_t, 0, 1000>;
+
+// The standard type categories are left alone, the library's own look through to the base type
+static_assert(!std::is_integral_v<level_t> && !std::is_arithmetic_v<uint_sat8_t>);
+static_assert(saturating::is_integral_v<level_t> && saturating::is_signed_v<level_t> && saturating::is_arithmetic_v<const gain_t&>);
+static_assert(saturating::is_unsigned_v<gain_t> && saturating::is_floating_point_v<float_sat_t> && !saturating::is_floating_point_v<gain_t>);
+static_assert(std::is_same_v<saturating::base_t<const level_t&>, int8_t> && std::is_same_v<saturating::base_t<int>, int>);
+static_assert(saturating::is_saturating_v<level_t> && saturating::is_saturating_v<const float_sat_t&> && !saturating::is_saturating_v<int8_t>);
+
+using lt = saturating::traits<level_t>;
+static_assert(lt::is_saturating && lt::is_integral && lt::is_signed && lt::width == 8);
+static_assert(lt::min_val == 16 && lt::max_val == 32 && !lt::full_range && !lt::has_negative);
+static_assert(saturating::traits<int_sat16_t>::full_range && saturating::traits<int_sat16_t>::has_negative);
+static_assert(!saturating::traits<uint32_t>::is_saturating && saturating::traits<uint32_t>::full_range);
+
+// numeric_limits: limits of the range, representation of the base type
+using nl = std::numeric_limits<level_t>;
+static_assert(nl::is_specialized && nl::is_integer && nl::is_exact && !nl::is_modulo && !nl::traps && nl::is_bounded);
+static_assert(nl::digits == 7 && nl::digits10 == 2 && nl::radix == 2);
+static_assert(nl::min() == 16 && nl::lowest() == 16 && nl::max() == 32);
+static_assert(std::is_same_v<decltype(nl::max()), level_t>);
+static_assert(std::numeric_limits<gain_t>::max() == 1000 && !std::numeric_limits<gain_t>::is_signed);
+
+using fl = std::numeric_limits<float_sat_t>;
+static_assert(!fl::is_integer && !fl::has_infinity && fl::digits == std::numeric_limits<float>::digits);
+static_assert(fl::lowest() == -1.0f && fl::max() == 1.0f && fl::min() == std::numeric_limits<float>::min());
+static_assert(fl::epsilon() == std::numeric_limits<float>::epsilon());
+
+int main() {
+    assert(fl::quiet_NaN() != fl::quiet_NaN());
+}
@@ -0,0 +1,136 @@
+#include <iostream>
+#include <cassert>
+#include <limits>
+#include <random>
+#include <vector>
+#include "../vec.hpp"
+
+using pixel_t = saturating::type<int16_t, 0, 1023>;
+using small_t = saturating::type<int8_t, -100, 27>;
+
+static_assert(sizeof(saturating::vec<int_sat16_t, 8>) == 16);
+static_assert(std::numeric_limits<saturating::vec<pixel_t, 8>>::max() == 1023);
+static_assert(std::numeric_limits<saturating::vec<uint8_t, 16>>::max() == 255);
+
+template <typename S, typename G>
+S random_value(G& gen) {
+    using R = saturating::range_of<S>;
+    using V = typename R::value_type;
+    if constexpr (std::is_floating_point_v<V>) {
+        return S{ static_cast<V>(std::uniform_real_distribution<double>(R::min_val, R::max_val)(gen)) };
+    } else {
+        // Out of range values as well, results must still match the scalar functions
+        return S{ static_cast<V>(gen()) };
+    }
+}
+
+/** Compare all operators of `vec<S, N>` against the scalar functions, lane by lane. */
+template <typename S, std::size_t N, typename G>
+void test_vec(G& gen) {
+    using X = saturating::vec<S, N>;
+    using R = saturating::range_of<S>;
+    using V = typename R::value_type;
+    for (int round = 0; round < 2000; ++round) {
+        S a[N], b[N], out[N];
+        for (std::size_t i = 0; i < N; ++i) {
+            a[i] = random_value<S>(gen);
+            b[i] = random_value<S>(gen);
+        }
+        if (round == 0) {
+            a[0] = S{ std::numeric_limits<V>::lowest() };
+            b[0] = S{ std::numeric_limits<V>::lowest() };
+        }
+        const X va = X::load(a), vb = X::load(b);
+        const S scalar = b[0];
+        const auto check = [&](const char* op, const X& r, auto f) {
+            for (std::size_t i = 0; i < N; ++i) {
+                const V e = f(static_cast<V>(a[i]), static_cast<V>(b[i]));
+                if (static_cast<V>(r[i]) != e && !(e != e)) {
+                    std::cout << "Error in vec " << op << " lane " << i << ": " << +static_cast<V>(a[i]) << ", " << +static_cast<V>(b[i])
+                              << ". Expected: " << +e << ", result: " << +static_cast<V>(r[i]) << std::endl;
+                    assert(static_cast<V>(r[i]) == e);
+                }
+            }
+        };
+        check("add", va + vb, [](V x, V y) { return saturating::add<V, R::min_val, R::max_val>(x, y); });
+        check("subtract", va - vb, [](V x, V y) { return saturating::subtract<V, R::min_val, R::max_val>(x, y); });
+        check("multiply", va * vb, [](V x, V y) { return saturating::multiply<V, R::min_val, R::max_val>(x, y); });
+        check("divide", va / vb, [](V x, V y) { return saturating::divide<V, R::min_val, R::max_val>(x, y); });
+        check("add scalar", va + scalar, [&](V x, V) { return saturating::add<V, R::min_val, R::max_val>(x, static_cast<V>(scalar)); });
+        check("scalar subtract", scalar - va, [&](V x, V) { return saturating::subtract<V, R::min_val, R::max_val>(static_cast<V>(scalar), x); });
+        check("clamp", X::clamp(va), [](V x, V) { return static_cast<V>(saturating::type<V, R::min_val, R::max_val>::clamp(x)); });
+
+        X c = va;
+        c += vb;
+        c *= scalar;
+        c.store(out);
+        for (std::size_t i = 0; i < N; ++i) {
+            const V e = saturating::multiply<V, R::min_val, R::max_val>(saturating::add<V, R::min_val, R::max_val>(static_cast<V>(a[i]), static_cast<V>(b[i])), static_cast<V>(scalar));
+            assert(static_cast<V>(out[i]) == e || e != e);
+        }
+    }
+}
+
+int main() {
+    std::mt19937_64 gen(12);
+    test_vec<int_sat8_t, 16>(gen);
+    test_vec<uint_sat8_t, 32>(gen);
+    test_vec<int_sat16_t, 8>(gen);
+    test_vec<uint_sat16_t, 16>(gen);
+    test_vec<pixel_t, 8>(gen);
+    test_vec<pixel_t, 16>(gen);
+    test_vec<small_t, 4>(gen);
+    test_vec<int_sat32_t, 4>(gen);
+    test_vec<uint_sat32_t, 8>(gen);
+    test_vec<int_sat64_t, 2>(gen);
+    test_vec<uint16_t, 8>(gen);
+    test_vec<float_sat_t, 8>(gen);
+    test_vec<saturating::type<double, -10, 10>, 4>(gen);
+
+    // Conversions between element types
+    using wide_t = saturating::vec<int32_t, 8>;
+    using narrow_t = saturating::vec<pixel_t, 8>;
+    wide_t w;
+    for (int i = 0; i < 8; ++i) w.set(i, i * 400 - 1000);
+    const auto n = narrow_t::from(w);
+    for (int i = 0; i < 8; ++i) assert(n[i] == pixel_t::from(i * 400 - 1000));
+    const auto s = saturating::vec<uint8_t, 8>::scale_from(n);
+    for (int i = 0; i < 8; ++i) assert(s[i] == static_cast<uint8_t>(saturating::type<uint8_t>::scale_from(n[i])));
+    const auto f = saturating::vec<int_sat16_t, 8>::from(saturating::vec<double, 8>{ 1e9 });
+    assert((f == saturating::vec<int_sat16_t, 8>{ int16_t{ 32767 } }));
+    assert(narrow_t::from(2000) == narrow_t{ int16_t{ 1023 } });
+
+    // Scalars beyond the lane type or with a fraction act like the scalar functions, not like a cast
+    using u8_t = saturating::vec<uint_sat8_t, 16>;
+    using i16_t = saturating::vec<int_sat16_t, 8>;
+    using small_v = saturating::vec<small_t, 4>;
+    assert(u8_t{ uint8_t{ 100 } } + 300 == u8_t{ uint8_t{ 255 } });
+    assert(u8_t{ uint8_t{ 100 } } - 300 == u8_t{});
+    assert(u8_t{ uint8_t{ 100 } } - (-300) == u8_t{ uint8_t{ 255 } });
+    assert(400 - u8_t{ uint8_t{ 200 } } == u8_t{ uint8_t{ 200 } });
+    assert(u8_t{ uint8_t{ 100 } } * 256 == u8_t{ uint8_t{ 255 } });
+    assert(u8_t{ uint8_t{ 100 } } / 256 == u8_t{});
+    assert(i16_t{ int16_t{ 1000 } } * 0.5 == i16_t{ int16_t{ 500 } });
+    assert(i16_t{ int16_t{ 1000 } } / 0.25 == i16_t{ int16_t{ 4000 } });
+    assert(i16_t{ int16_t{ 1000 } } + 0.75 == i16_t{ int16_t{ 1001 } });
+    assert(i16_t{ int16_t{ -1000 } } + 100000 == i16_t{ int16_t{ 32767 } });
+    assert(i16_t{ int16_t{ 1000 } } - 40000u == i16_t{ int16_t{ -32768 } });
+    assert(small_v{ int8_t{ -100 } } + 200 == small_v{ int8_t{ 27 } });
+    assert(small_v{ int8_t{ -100 } } + 120 == small_v{ int8_t{ 20 } });
+    assert((0.25 * saturating::vec<float, 4>{ 0.5f } == saturating::vec<float, 4>{ 0.125f }));
+    assert((saturating::vec<float, 4>{ 0.5f } + 2.0 == saturating::vec<float, 4>{ 1.0f }));
+    for (int round = 0; round < 2000; ++round) {
+        const auto x = static_cast<int16_t>(gen());
+        const auto y = static_cast<int32_t>(gen()) >> (gen() % 32);
+        const double z = std::uniform_real_distribution<double>(-70000, 70000)(gen);
+        const i16_t v{ x };
+        for (std::size_t i = 0; i < 8; ++i) {
+            assert((v + y)[i] == saturating::add<int_sat16_t>(x, y));
+            assert((y - v)[i] == saturating::subtract<int_sat16_t>(y, x));
+            assert((v * y)[i] == saturating::multiply<int_sat16_t>(x, y));
+            assert((v / y)[i] == saturating::divide<int_sat16_t>(x, y));
+            assert((v * z)[i] == saturating::multiply<int_sat16_t>(x, z));
+            assert((z / v)[i] == saturating::divide<int_sat16_t>(z, x));
+        }
+    }
+}
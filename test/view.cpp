@@ -0,0 +1,44 @@
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <vector>
+#include "../view.hpp"
+#include "../bulk.hpp"
+#include "../types.hpp"
+
+using level_t = saturating::type<int8_t, 16, 32>;
+
+int main() {
+    // Full range types use the buffer as it is
+    std::vector<uint8_t> packet { 10, 200, 250, 0 };
+    saturating::view<uint_sat8_t, saturating::load::unchecked> v(packet.data(), packet.size());
+    saturating::add(v.data(), v.data(), v.data(), v.size());
+    assert(packet[0] == 20 && packet[1] == 255 && packet[2] == 255 && packet[3] == 0);
+    v[0] += 240;
+    assert(packet[0] == 255);
+
+    // Clamped when read, the buffer itself is left alone
+    const std::vector<int8_t> raw { 0, 20, 40, -5 };
+    saturating::view<const level_t> c(raw.data(), raw.size());
+    assert(c[0] == 16 && c[1] == 20 && c[2] == 32 && c[3] == 16);
+    int sum = 0;
+    for (level_t x : c) sum += x;
+    assert(sum == 16 + 20 + 32 + 16 && raw[2] == 40);
+
+    // Clamping in place makes the buffer usable unchecked
+    std::vector<int8_t> samples { 0, 20, 40, 17, 100 };
+    saturating::view<level_t> s(samples.data(), samples.size());
+    s.store(3, 1000);
+    auto u = s.clamp();
+    assert(samples[0] == 16 && samples[2] == 32 && samples[3] == 32 && samples[4] == 32);
+    assert(&u[1] == reinterpret_cast<level_t*>(&samples[1]) && u.subview(1, 2).size() == 2);
+
+    // Memory regions, trailing bytes are left out
+    alignas(int16_t) unsigned char region[7];
+    const int16_t values[3] { -1, 2, 300 };
+    std::memcpy(region, values, sizeof(values));
+    auto r = saturating::view<int_sat16_t, saturating::load::unchecked>::from_bytes(region, sizeof(region));
+    assert(r.size() == 3 && r[0] == -1 && r[2] == 300);
+    saturating::view<int_sat16_t> rc = r;
+    assert(rc[1] == 2);
+}
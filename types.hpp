@@ -3,7 +3,12 @@
  *
  * Some assumptions and notes:
  * - The operators are 'viral', adding a saturating type and any other returns another saturating type.
+ * - The result has the type of the left hand side, also when both operands are saturating types of different
+ *   ranges: `a + b` saturates to the limits of `a`, `b + a` to those of `b`. Compound assignment stores in the left
+ *   hand side as well. Assign to a wider type and use `type::add(a, b)` and friends for other limits.
  * - Divide by zero clips the value to `min` or `max`
+ * - The optional fourth parameter, a policy, selects what happens on saturation: clamp silently (the default),
+ *   trap or call a hook, see `policy.hpp`.
  * - Tries to avoid the normal promotion rules
  * - The separate `add`, `subtract`, etc functions can be used to define extra external operators
  *   returning saturated types.
@@ -26,6 +31,8 @@
 
 #include "./utilities.hpp"
 #include "./functions.hpp"
+#include "./scale.hpp"
+#include "./policy.hpp"
 #include "./std_saturating_awareness.hpp"
 
 namespace saturating {
@@ -44,10 +51,12 @@ namespace saturating {
                                                                                             ? static_cast<std::conditional_t<std::is_integral_v<T>,
                                                                                                                              std::decay_t<T>,
                                                                                                                              int>>(std::numeric_limits<T>::max())
-                                                                                            : 1>
+                                                                                            : 1,
+              typename P = policy::saturate>
     class type {
     public:
         using value_type = std::decay_t<T>;
+        using policy_type = P;
 
         static constexpr value_type min_val = MIN;
         static constexpr value_type max_val = MAX;
@@ -76,9 +85,22 @@ namespace saturating {
          */
         template <typename UA, typename UB>
         static constexpr
-        std::enable_if_t<std::is_arithmetic_v<UA> && std::is_arithmetic_v<UB>, type>
-        __attribute__((const))
+        std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>, type>
+        SATURATING_CONST
         add(const UA& a, const UB& b) noexcept {
+            if constexpr (P::checked && std::is_integral_v<value_type> && is_floating_point_v<UA> != is_floating_point_v<UB>) {
+                // A single floating point operand is rounded before the addition
+                const auto rounded = [](const auto& v) {
+                    if constexpr (is_floating_point_v<std::decay_t<decltype(v)>>) {
+                        return static_cast<detail::widest_t>(saturating::round<value_type>(detail::value_of(v)));
+                    } else {
+                        return detail::value_of(v);
+                    }
+                };
+                check<stats::op::add>(exact<stats::op::add>(rounded(a), rounded(b)));
+            } else if constexpr (P::checked) {
+                check<stats::op::add>(exact<stats::op::add>(a, b));
+            }
             return { saturating::add<value_type, MIN, MAX, UA, UB>(a, b) };
         }
 
@@ -90,9 +112,10 @@ namespace saturating {
          */
         template <typename UA, typename UB>
         static constexpr
-        std::enable_if_t<std::is_arithmetic_v<UA> && std::is_arithmetic_v<UB>, type>
-        __attribute__((const))
+        std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>, type>
+        SATURATING_CONST
         subtract(const UA& a, const UB& b) noexcept {
+            if constexpr (P::checked) check<stats::op::subtract>(exact<stats::op::subtract>(a, b));
             return { saturating::subtract<value_type, MIN, MAX>(a, b) };
         }
 
@@ -104,9 +127,10 @@ namespace saturating {
          */
         template <typename UA, typename UB>
         static constexpr
-        std::enable_if_t<std::is_arithmetic_v<UA> && std::is_arithmetic_v<UB>, type>
-        __attribute__((const))
+        std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>, type>
+        SATURATING_CONST
         multiply(const UA& a, const UB& b) noexcept {
+            if constexpr (P::checked) check<stats::op::multiply>(exact<stats::op::multiply>(a, b));
             return { saturating::multiply<value_type, MIN, MAX>(a, b) };
         }
 
@@ -118,57 +142,130 @@ namespace saturating {
          */
         template <typename UA, typename UB>
         static constexpr
-        std::enable_if_t<std::is_arithmetic_v<UA> && std::is_arithmetic_v<UB>, type>
-        __attribute__((const))
+        std::enable_if_t<is_arithmetic_v<UA> && is_arithmetic_v<UB>, type>
+        SATURATING_CONST
         divide(const UA& a, const UB& b) noexcept {
+            if constexpr (P::checked) check<stats::op::divide>(exact<stats::op::divide>(a, b));
             return { saturating::divide<value_type, MIN, MAX>(a, b) };
         }
 
-        constexpr auto& operator++() noexcept {
-            if (value < MAX - 1) ++value;
+        /** Increment, up to and including `MAX`, without branches. */
+        constexpr type& operator++() noexcept {
+            if constexpr (P::checked) check<stats::op::add>(exact<stats::op::add>(value, 1));
+            if constexpr (std::is_floating_point_v<value_type>) {
+                value = value < MAX - 1 ? value + 1 : static_cast<value_type>(MAX);
+            } else {
+                value = static_cast<value_type>(value + !detail::overflowed<stats::op::add>(!(value < MAX), true));
+            }
             return *this;
         }
-        constexpr auto operator++(int) noexcept {
-            type<type, MIN, MAX> temp { value };
-            if (value < MAX - 1) ++value;
+        constexpr type operator++(int) noexcept {
+            const type temp { *this };
+            ++*this;
             return temp;
         }
 
-        constexpr auto& operator--() noexcept {
-            if (value > MIN + 1) --value;
+        /** Decrement, down to and including `MIN`, without branches. */
+        constexpr type& operator--() noexcept {
+            if constexpr (P::checked) check<stats::op::subtract>(exact<stats::op::subtract>(value, 1));
+            if constexpr (std::is_floating_point_v<value_type>) {
+                value = value > MIN + 1 ? value - 1 : static_cast<value_type>(MIN);
+            } else {
+                value = static_cast<value_type>(value - !detail::overflowed<stats::op::subtract>(!(value > MIN), false));
+            }
             return *this;
         }
-        constexpr auto operator--(int) noexcept {
-            type<type, MIN, MAX> temp { value };
-            if (value > MIN + 1) --value;
+        constexpr type operator--(int) noexcept {
+            const type temp { *this };
+            --*this;
             return temp;
         }
 
-        template <typename U> constexpr auto& operator= (const U& other) noexcept { value = clamp(other); return *this; }
+        /**
+         * Add `other` in place, like `+=`. Floating point values are added exactly and the sum rounded once,
+         * where `+=` rounds like `+`.
+         * @param  other Value of any (saturating or plain) arithmetic type
+         * @return       Did the sum fall outside of `MIN` ... `MAX`?
+         */
+        template <typename U>
+        constexpr std::enable_if_t<is_arithmetic_v<U>, bool> add_to(const U& other) noexcept {
+            if constexpr (P::checked) check<stats::op::add>(exact<stats::op::add>(value, other));
+            return saturating::add_to<value_type, MIN, MAX>(value, other);
+        }
 
-        template <typename U> constexpr decltype(auto) __attribute__((const)) operator+(const U& other) const noexcept { return add(value, other); }
-        template <typename U> constexpr decltype(auto) __attribute__((const)) operator-(const U& other) const noexcept { return subtract(value, other); }
-        template <typename U> constexpr decltype(auto) __attribute__((const)) operator*(const U& other) const noexcept { return multiply(value, other); }
-        template <typename U> constexpr decltype(auto) __attribute__((const)) operator/(const U& other) const noexcept { return divide(value, other); }
+        /**
+         * Subtract `other` in place, like `-=`.
+         * @param  other Value of any (saturating or plain) arithmetic type
+         * @return       Did the difference fall outside of `MIN` ... `MAX`?
+         */
+        template <typename U>
+        constexpr std::enable_if_t<is_arithmetic_v<U>, bool> subtract_from(const U& other) noexcept {
+            if constexpr (P::checked) check<stats::op::subtract>(exact<stats::op::subtract>(value, other));
+            return saturating::subtract_from<value_type, MIN, MAX>(value, other);
+        }
 
-        template <typename U> constexpr type __attribute__((const)) operator%(const U& other) const noexcept { return value % other; }
+        template <typename U, std::enable_if_t<is_arithmetic_v<U>, int> = 0>
+        constexpr auto& operator= (const U& other) noexcept { value = clamp(other); return *this; }
 
-        template <typename U> constexpr auto& operator+=(const U& other) noexcept { value = add(value, other); return *this; }
-        template <typename U> constexpr auto& operator-=(const U& other) noexcept { value = subtract(value, other); return *this; }
-        template <typename U> constexpr auto& operator*=(const U& other) noexcept { value = multiply(value, other); return *this; }
-        template <typename U> constexpr auto& operator/=(const U& other) noexcept { value = divide(value, other); return *this; }
+        template <typename U, std::enable_if_t<is_arithmetic_v<U>, int> = 0>
+        constexpr decltype(auto) SATURATING_CONST operator+(const U& other) const noexcept { return add(*this, other); }
+        template <typename U, std::enable_if_t<is_arithmetic_v<U>, int> = 0>
+        constexpr decltype(auto) SATURATING_CONST operator-(const U& other) const noexcept { return subtract(*this, other); }
+        template <typename U, std::enable_if_t<is_arithmetic_v<U>, int> = 0>
+        constexpr decltype(auto) SATURATING_CONST operator*(const U& other) const noexcept { return multiply(*this, other); }
+        template <typename U, std::enable_if_t<is_arithmetic_v<U>, int> = 0>
+        constexpr decltype(auto) SATURATING_CONST operator/(const U& other) const noexcept { return divide(*this, other); }
+
+        /**
+         * Operators on two saturating types, of any range and base type, return the type of the left hand side like
+         * the others. The limits of both operands select the kernel at compile time: no clamp when the result
+         * provably fits, otherwise one exact operation in the narrowest type holding every possible result and a
+         * compare against only the limits that can be crossed (see `detail::ranged`).
+         */
+        template <typename U, auto UMIN, auto UMAX, typename UP>
+        constexpr type SATURATING_CONST operator+(const type<U, UMIN, UMAX, UP>& other) const noexcept { return add(*this, other); }
+        template <typename U, auto UMIN, auto UMAX, typename UP>
+        constexpr type SATURATING_CONST operator-(const type<U, UMIN, UMAX, UP>& other) const noexcept { return subtract(*this, other); }
+        template <typename U, auto UMIN, auto UMAX, typename UP>
+        constexpr type SATURATING_CONST operator*(const type<U, UMIN, UMAX, UP>& other) const noexcept { return multiply(*this, other); }
+        template <typename U, auto UMIN, auto UMAX, typename UP>
+        constexpr type SATURATING_CONST operator/(const type<U, UMIN, UMAX, UP>& other) const noexcept { return divide(*this, other); }
+
+        template <typename U> constexpr type __attribute__((pure)) operator%(const U& other) const noexcept { return value % other; }
+
+        // Floating point operands of integral types round like `+` and `-` do, all others take the in place path
+        template <typename U> constexpr auto& operator+=(const U& other) noexcept {
+            if constexpr (is_floating_point_v<U> && std::is_integral_v<value_type>) {
+                value = add(*this, other);
+            } else {
+                add_to(other);
+            }
+            return *this;
+        }
+        template <typename U> constexpr auto& operator-=(const U& other) noexcept {
+            if constexpr (is_floating_point_v<U> && std::is_integral_v<value_type>) {
+                value = subtract(*this, other);
+            } else {
+                subtract_from(other);
+            }
+            return *this;
+        }
+        template <typename U> constexpr auto& operator*=(const U& other) noexcept { value = multiply(*this, other); return *this; }
+        template <typename U> constexpr auto& operator/=(const U& other) noexcept { value = divide(*this, other); return *this; }
         template <typename U> constexpr auto& operator%=(const U& other) noexcept { value %= other; return *this; }
 
         /**
-         * Clamp value `val` to the base type limits. With float rounding.
+         * Clamp value `val` to the base type limits. With float rounding, `R` (see `rounding`).
          */
-        template <typename U>
-        static constexpr type __attribute__((const))
+        template <typename U, rounding R = default_rounding>
+        static constexpr type SATURATING_CONST
         clamp(const U& val) noexcept {
-            if constexpr (std::is_floating_point_v<U> && std::is_integral_v<value_type>) {
-                return static_cast<value_type>(minmax(MIN, round(val), MAX));
+            if constexpr (is_floating_point_v<U> && std::is_integral_v<value_type>) {
+                if constexpr (P::checked) check<stats::op::clamp>(static_cast<detail::widest_t>(saturating::round<value_type, R>(val)));
+                return static_cast<value_type>(detail::saturate<stats::op::clamp>(MIN, saturating::round<value_type, R>(val), MAX));
             } else {
-                return static_cast<value_type>(minmax(MIN, val, MAX));
+                if constexpr (P::checked) check<stats::op::clamp>(exact<stats::op::clamp>(val, 0));
+                return static_cast<value_type>(detail::saturate<stats::op::clamp>(MIN, val, MAX));
             }
         }
 
@@ -178,10 +275,19 @@ namespace saturating {
          * @return     Saturating type with initial value clamped.
          */
         template <typename U>
-        static constexpr type __attribute__((const)) from(const U& val) noexcept {
+        static constexpr type SATURATING_CONST from(const U& val) noexcept {
             return { clamp(val) };
         }
 
+        /**
+         * Create a new instance of this type without clamping, `val` must be in `MIN` ... `MAX` already.
+         * @param  val Initial value
+         * @return     Saturating type with value `val`.
+         */
+        static constexpr type SATURATING_CONST from_unchecked(const value_type& val) noexcept {
+            return { val };
+        }
+
         /**
          * Scale the value of another saturating type to this one.
          * @param  val Saturating type
@@ -191,43 +297,23 @@ namespace saturating {
         constexpr auto& scale_from(const U& val) noexcept { value = type::scale_from(val); return *this; }
 
         /**
-         * Convert one saturating type to another, scaling the value.
+         * Convert one saturating type to another, scaling the value. `in_min` maps to `MIN`, `in_max` to `MAX`,
+         * values in between are rounded to nearest (see `saturating::scale`).
          * @param  val Saturating type
          * @return     New saturating type
          */
         template <typename U,
-                  std::conditional_t<std::is_floating_point_v<U>, int, std::decay_t<U>> in_min,
-                  std::conditional_t<std::is_floating_point_v<U>, int, std::decay_t<U>> in_max,
-                  typename DISCARD = void>
-        static constexpr type __attribute__((const))
-        scale_from(const type<U, in_min, in_max>& val) noexcept {
-            if constexpr (static_cast<fit_all_t<type, std::decay_t<U>>>(MIN) == static_cast<fit_all_t<type, std::decay_t<U>>>(in_min)) {
-                if constexpr (static_cast<fit_all_t<type, std::decay_t<U>>>(MAX) == static_cast<fit_all_t<type, std::decay_t<U>>>(in_max)) {
-                    return { static_cast<value_type>(val) };
-                } else {
-                    //TODO: Check overflow
-                    return { static_cast<value_type>(((static_cast<next_up_t<T>>(val) - MIN) * in_max / MAX) + MIN) };
-                }
-            } else {
-                if constexpr (static_cast<next_up_t<T>>(MAX) - MIN == static_cast<next_up_t<U>>(in_max) - in_min) {
-                    // Range shift only
-                    return { static_cast<value_type>(val + (static_cast<next_up_t<U>>(in_min) - MIN)) };
-                } else {
-                    if constexpr (static_cast<fit_all_t<type, std::decay_t<U>>>(MAX) == static_cast<fit_all_t<type, std::decay_t<U>>>(in_max)) {
-                        return { static_cast<value_type>((val * (static_cast<next_up_t<T>>(MAX) - MIN))/(MAX - in_min)) };
-                    } else {
-                        auto temp = (static_cast<next_up_t<fit_all_t<T, U>>>(val) - in_min) *
-                                    (static_cast<next_up_t<fit_all_t<T, U>>>(MAX) - MIN) /
-                                    (static_cast<next_up_t<fit_all_t<T, U>>>(in_max) - in_min) + MIN + 1; // 1 for integer rounding
-                        return { static_cast<value_type>(temp) };
-                    }
-                }
-            }
+                  std::conditional_t<is_floating_point_v<U>, int, base_t<U>> in_min,
+                  std::conditional_t<is_floating_point_v<U>, int, base_t<U>> in_max,
+                  typename UP>
+        static constexpr type __attribute__((pure))
+        scale_from(const type<U, in_min, in_max, UP>& val) noexcept {
+            return { saturating::scale<value_type, MIN, MAX, base_t<U>, in_min, in_max>(static_cast<const U&>(val)) };
         }
 
         template <typename U, typename V>
-        static constexpr std::enable_if_t<std::is_floating_point_v<U> & std::is_floating_point_v<V>, type>
-        __attribute__((const))
+        static constexpr std::enable_if_t<is_floating_point_v<U> & is_floating_point_v<V>, type>
+        __attribute__((pure))
         scale_from(const U& val,
                    const V& in_min,
                    const V& in_max) noexcept
@@ -239,7 +325,7 @@ namespace saturating {
         }
 
         // template <typename U, typename V = int>
-        // static constexpr std::enable_if_t<std::is_floating_point_v<U> && std::is_integral_v<V>, type>
+        // static constexpr std::enable_if_t<is_floating_point_v<U> && is_integral_v<V>, type>
         // __attribute__((const)) /**TODO: Starting the range for unsigned values from 0 instead of -1 feels optimal, at the cost of complex default behaviour */
         // scale_from(const U& val,
         //            const V& in_min = std::is_signed_v<value_type> ? -1 : 0,
@@ -252,8 +338,88 @@ namespace saturating {
         // }
 
     private:
+        /**
+         * Result of `a O b` (`a` itself for `clamp`) before saturation, rounded like the operations round: in
+         * `long double` when floating point values are involved (rounded to `detail::widest_t` for integral
+         * `value_type`), otherwise in `long long` for operands of up to 32 bits and `detail::widest_t` beyond, where
+         * only results beyond it saturate (to its limits). Integer quotients round half away from zero.
+         */
+        template <stats::op O, typename UA, typename UB>
+        static constexpr auto exact(const UA& a, const UB& b) noexcept {
+            if constexpr (is_floating_point_v<value_type> || is_floating_point_v<UA> || is_floating_point_v<UB>) {
+                const long double x = detail::value_of(a);
+                const long double y = detail::value_of(b);
+                long double r = x;
+                if constexpr (O == stats::op::add)           r = x + y;
+                else if constexpr (O == stats::op::subtract) r = x - y;
+                else if constexpr (O == stats::op::multiply) r = x * y;
+                else if constexpr (O == stats::op::divide)   r = x / y;
+                if constexpr (std::is_integral_v<value_type>) {
+                    return detail::round_inline<detail::widest_t, default_rounding == rounding::even ? rounding::even : rounding::nearest>(r);
+                } else {
+                    return r;
+                }
+            } else {
+                using W = std::conditional_t<(sizeof(value_type) <= 4 && sizeof(base_t<UA>) <= 4 && sizeof(base_t<UB>) <= 4),
+                                             long long, detail::widest_t>;
+                constexpr W lowest = std::numeric_limits<W>::lowest();
+                constexpr W highest = std::numeric_limits<W>::max();
+                const W x = static_cast<W>(detail::value_of(a));
+                const W y = static_cast<W>(detail::value_of(b));
+                W r = x;
+                if constexpr (O == stats::op::add) {
+                    if (__builtin_add_overflow(x, y, &r)) r = y < 0 ? lowest : highest;
+                } else if constexpr (O == stats::op::subtract) {
+                    if (__builtin_sub_overflow(x, y, &r)) r = y > 0 ? lowest : highest;
+                } else if constexpr (O == stats::op::multiply) {
+                    if (__builtin_mul_overflow(x, y, &r)) r = (x < 0) != (y < 0) ? lowest : highest;
+                } else if constexpr (O == stats::op::divide) {
+                    // Like the division itself, dividing by zero goes to the limit of the sign of `a`
+                    if (y == 0) {
+                        r = x < 0 ? lowest : highest;
+                    } else if (x == lowest && y == -1) {
+                        r = highest;
+                    } else {
+                        using M = unsigned_t<W>;
+                        const W q = x / y;
+                        const M rest = magnitude<M>(static_cast<W>(x % y));
+                        r = rest >= static_cast<M>(magnitude<M>(y) - rest) ? ((x < 0) != (y < 0) ? q - 1 : q + 1) : q;
+                    }
+                }
+                return r;
+            }
+        }
+
+        /** Pass a saturation of `O` to the policy if `x` lies outside of `MIN` ... `MAX`. */
+        template <stats::op O, typename W>
+        static constexpr void check(const W& x) noexcept {
+            if (x < static_cast<W>(MIN)) {
+                P::saturated(O, stats::direction::low);
+            } else if (static_cast<W>(MAX) < x) {
+                P::saturated(O, stats::direction::high);
+            }
+        }
+
         T value;
     };
+
+    namespace detail {
+        /**
+         * Does `S` have the layout of its base type? Then buffers of `S` and of the base type can be used as each
+         * other (see `view.hpp`), and copied with `memcpy`.
+         */
+        template <typename S>
+        constexpr bool same_layout_v = std::is_standard_layout_v<S> && std::is_trivially_copyable_v<S> &&
+                                       sizeof(S) == sizeof(typename range_of<S>::value_type) &&
+                                       alignof(S) == alignof(typename range_of<S>::value_type);
+    } // namespace detail
+
+    static_assert(detail::same_layout_v<type<std::int8_t>>   && detail::same_layout_v<type<std::uint8_t>>);
+    static_assert(detail::same_layout_v<type<std::int16_t>>  && detail::same_layout_v<type<std::uint16_t>>);
+    static_assert(detail::same_layout_v<type<std::int32_t>>  && detail::same_layout_v<type<std::uint32_t>>);
+    static_assert(detail::same_layout_v<type<std::int64_t>>  && detail::same_layout_v<type<std::uint64_t>>);
+    static_assert(detail::same_layout_v<type<float>>         && detail::same_layout_v<type<double>>);
+    static_assert(detail::same_layout_v<type<std::int8_t, 16, 32>>);
 } // namespace saturating
 
 #ifndef SATURATING_TYPES_h_NO_GLOBALS
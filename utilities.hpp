@@ -9,6 +9,8 @@
 
 #include <arithmetic_type_tools/arithmetic_type_tools.hpp>
 
+#include "./forward_decl.hpp"
+
 namespace saturating {
     using arithmetic_type_tools::min;
     using arithmetic_type_tools::max;
@@ -16,14 +18,205 @@ namespace saturating {
     using arithmetic_type_tools::fit_all_t;
     using arithmetic_type_tools::next_up_t;
 
-    template <typename Tout, typename Tin>
-    constexpr decltype(auto) __attribute__((const))
+    /** Base type of saturating type `T`, `std::decay_t<T>` for any other type. */
+    template <typename T>
+    struct base_type { using type = std::decay_t<T>; };
+    template <typename T, auto MIN, auto MAX, typename P>
+    struct base_type<type<T, MIN, MAX, P>> { using type = T; };
+    template <typename T>
+    using base_t = typename base_type<std::remove_cv_t<std::remove_reference_t<T>>>::type;
+
+    /**
+     * The standard type categories of the base type, so saturating types are arithmetic as well. The standard
+     * traits themselves can't be specialized, use these in generic code that takes saturating types.
+     */
+    template <typename T> constexpr bool is_arithmetic_v     = std::is_arithmetic_v<base_t<T>>;
+    template <typename T> constexpr bool is_integral_v       = std::is_integral_v<base_t<T>>;
+    template <typename T> constexpr bool is_floating_point_v = std::is_floating_point_v<base_t<T>>;
+    template <typename T> constexpr bool is_signed_v         = std::is_signed_v<base_t<T>>;
+    template <typename T> constexpr bool is_unsigned_v       = std::is_unsigned_v<base_t<T>>;
+
+    /** The signed counterpart of integral `T`, any other type is left as is. */
+    template <typename T, bool = is_unsigned_v<T>>
+    struct signed_type { using type = T; };
+    template <typename T>
+    struct signed_type<T, true> { using type = std::make_signed_t<T>; };
+    template <typename T>
+    using signed_t = typename signed_type<base_t<T>>::type;
+
+    /** The unsigned counterpart of integral `T`, any other type is left as is. */
+    template <typename T, bool = is_signed_v<T> && is_integral_v<T>>
+    struct unsigned_type { using type = T; };
+    template <typename T>
+    struct unsigned_type<T, true> { using type = std::make_unsigned_t<T>; };
+#ifdef __SIZEOF_INT128__
+    // The std traits only know the 128 bit types with GNU extensions, map them explicitly for strict modes
+    template <> struct signed_type<unsigned __int128, false> { using type = __int128; };
+    template <> struct signed_type<unsigned __int128, true> { using type = __int128; };
+    template <> struct unsigned_type<__int128, false> { using type = unsigned __int128; };
+    template <> struct unsigned_type<__int128, true> { using type = unsigned __int128; };
+#endif
+    template <typename T>
+    using unsigned_t = typename unsigned_type<base_t<T>>::type;
+
+    /** Is `val` below zero? Avoids 'always false' comparison warnings for unsigned types. */
+    template <typename T>
+    constexpr bool __attribute__((pure))
+    is_negative(const T& val) noexcept {
+        if constexpr (is_signed_v<T>) {
+            return val < 0;
+        } else {
+            return false;
+        }
+    }
+
+    /** Absolute value of integral `val` as unsigned `TU`, also valid for the lowest signed value. */
+    template <typename TU, typename T>
+    constexpr TU __attribute__((pure))
+    magnitude(const T& val) noexcept {
+        return is_negative(val) ? static_cast<TU>(TU(0) - static_cast<TU>(val)) : static_cast<TU>(val);
+    }
+
+    /**
+     * Type of the `MIN` and `MAX` template parameters for base type `T` (floating point types use `int`). Class
+     * types have no limits, which keeps templates taking them out of overload resolution.
+     */
+    template <typename T>
+    using limit_t = std::enable_if_t<!std::is_class_v<base_t<T>>, std::conditional_t<is_floating_point_v<T>, int, base_t<T>>>;
+
+    /** Default lower limit for base type `T`. */
+    template <typename T>
+    constexpr limit_t<T> default_min_v = is_floating_point_v<T> ? -1 : static_cast<limit_t<T>>(std::numeric_limits<T>::lowest());
+
+    /** Default upper limit for base type `T`. */
+    template <typename T>
+    constexpr limit_t<T> default_max_v = is_floating_point_v<T> ?  1 : static_cast<limit_t<T>>(std::numeric_limits<T>::max());
+
+    /** Value type and limits of plain arithmetic types and saturating types alike. */
+    template <typename T>
+    struct range_of {
+        using value_type = std::decay_t<T>;
+        static constexpr limit_t<T> min_val = default_min_v<T>;
+        static constexpr limit_t<T> max_val = default_max_v<T>;
+    };
+
+    template <typename T, auto MIN, auto MAX, typename P>
+    struct range_of<type<T, MIN, MAX, P>> {
+        using value_type = std::decay_t<T>;
+        static constexpr limit_t<T> min_val = MIN;
+        static constexpr limit_t<T> max_val = MAX;
+    };
+
+    /** Is `T` a `saturating::type`? */
+    template <typename T>
+    constexpr bool is_saturating_v = !std::is_same_v<base_t<T>, std::remove_cv_t<std::remove_reference_t<T>>>;
+
+    /**
+     * Compile time properties of saturating or plain arithmetic type `S`, for algorithms to specialize on.
+     * `std::numeric_limits` is specialized as well (see `std_saturating_awareness.hpp`).
+     */
+    template <typename S>
+    struct traits {
+        using value_type = base_t<S>;
+
+        static constexpr bool is_saturating     = is_saturating_v<S>;
+        static constexpr bool is_integral       = std::is_integral_v<value_type>;
+        static constexpr bool is_floating_point = std::is_floating_point_v<value_type>;
+        static constexpr bool is_signed         = std::is_signed_v<value_type>;
+
+        /** Limits of the values, `range_of<S>`. */
+        static constexpr limit_t<value_type> min_val = range_of<std::remove_cv_t<std::remove_reference_t<S>>>::min_val;
+        static constexpr limit_t<value_type> max_val = range_of<std::remove_cv_t<std::remove_reference_t<S>>>::max_val;
+
+        /** Bits of storage. */
+        static constexpr unsigned width = sizeof(value_type) * 8;
+
+        /** Do the limits cover every value of the base type (integral types only)? */
+        static constexpr bool full_range = is_integral && min_val == std::numeric_limits<value_type>::lowest() &&
+                                           max_val == std::numeric_limits<value_type>::max();
+
+        /** Can values be below zero? */
+        static constexpr bool has_negative = is_negative(min_val);
+    };
+
+    namespace detail {
+        /** Widest integer available, used for exact intermediate results. */
+        using widest_t = next_up_t<std::int64_t>;
+
+        /** Cache line size assumed for padding and work splitting. */
+        constexpr std::size_t cache_line = 64;
+
+        /** The plain value of `v`, which may be a saturating type. */
+        template <typename V>
+        constexpr const typename range_of<V>::value_type& value_of(const V& v) noexcept {
+            return static_cast<const typename range_of<V>::value_type&>(v);
+        }
+    } // namespace detail
+
+    /** Floating point to integer rounding methods. */
+    enum class rounding {
+        library,    ///< `std::lround` / `std::llround`
+        nearest,    ///< Half away from zero, like `std::lround`, computed inline
+        even        ///< Half to even, like `cvtps2dq` in the default rounding mode, computed inline
+    };
+
+    /**
+     * Rounding used by the functions and types, defining `SATURATING_ROUNDING` (for all translation units) as
+     * one of the `rounding` names selects another one.
+     */
+#ifdef SATURATING_ROUNDING
+    constexpr rounding default_rounding = rounding::SATURATING_ROUNDING;
+#else
+    constexpr rounding default_rounding = rounding::nearest;
+#endif
+
+    namespace detail {
+        /**
+         * Round `val` to `TR` without the floating point environment: clamp in the floating point domain,
+         * truncate and correct by the remainder (exact, values beyond the mantissa are integral already).
+         * NaN maps to zero.
+         */
+        template <typename TR, rounding R, typename F>
+        constexpr TR round_inline(const F& val) noexcept {
+            // -2^digits and 2^digits are exact, the latter is out of range
+            constexpr F lo = -static_cast<F>(std::numeric_limits<TR>::max() / 2 + 1) * 2;
+            constexpr F hi = -lo;
+            if (!(val == val)) return 0;
+            if (val < lo)      return std::numeric_limits<TR>::lowest();
+            if (val >= hi)     return std::numeric_limits<TR>::max();
+            const TR t = static_cast<TR>(val);
+            const F  d = val - static_cast<F>(t);
+            if constexpr (R == rounding::even) {
+                const bool odd = (t & 1) != 0;
+                return static_cast<TR>(t + (d > F(0.5) || (d == F(0.5) && odd)) - (d < F(-0.5) || (d == F(-0.5) && odd)));
+            } else {
+                return static_cast<TR>(t + (d >= F(0.5)) - (d <= F(-0.5)));
+            }
+        }
+    } // namespace detail
+
+    /**
+     * Round floating point `val` to an integer wide enough for `Tout` (`long` or `long long`), values beyond
+     * that saturate. Unsigned 64 bit `Tout` rounds to `detail::widest_t`, which holds values from 2^63 on as well
+     * as negative ones; `rounding::library` rounds like `rounding::nearest` then.
+     * @param  val Value
+     * @return     Rounded value
+     */
+    template <typename Tout, rounding R = default_rounding, typename Tin>
+    constexpr decltype(auto) __attribute__((pure))
     round(const Tin& val) {
-        // Yup, the return types differ, but it seems the `constexpr` okays this for GCC at least
-        if constexpr (sizeof(Tout) > sizeof(long)) {
-            return std::llround(val);
+        using TR = std::conditional_t<(sizeof(Tout) > sizeof(long)), long long, long>;
+        if constexpr (is_unsigned_v<Tout> && sizeof(Tout) >= sizeof(long long) && sizeof(detail::widest_t) > sizeof(Tout)) {
+            return detail::round_inline<detail::widest_t, R == rounding::library ? rounding::nearest : R>(val);
+        } else if constexpr (R == rounding::library) {
+            // Yup, the return types differ, but it seems the `constexpr` okays this for GCC at least
+            if constexpr (sizeof(Tout) > sizeof(long)) {
+                return std::llround(val);
+            } else {
+                return std::lround(val);
+            }
         } else {
-            return std::lround(val);
+            return detail::round_inline<TR, R>(val);
         }
     }
 
@@ -31,12 +224,12 @@ namespace saturating {
      * Test for equality, accounting for floating point rounding differences
      */
     template <typename TA, typename TB>
-    constexpr bool __attribute__((const))
+    constexpr bool __attribute__((pure))
     fp_safe_equals(const TA& a, const TB& b) noexcept {
-        using A = std::decay_t<TA>;
-        using B = std::decay_t<TB>;
-        if constexpr (std::is_floating_point_v<A>) {
-            if constexpr (std::is_floating_point_v<B>) {
+        using A = base_t<TA>;
+        using B = base_t<TB>;
+        if constexpr (is_floating_point_v<A>) {
+            if constexpr (is_floating_point_v<B>) {
                 if constexpr (sizeof(double) > sizeof(A) || sizeof(double) > sizeof(B)) {
                     return std::fabs(a - b) < std::numeric_limits<float>::epsilon();
                 } else {
@@ -46,7 +239,7 @@ namespace saturating {
                 return std::fabs(static_cast<A>(a) - static_cast<A>(b)) < std::numeric_limits<A>::epsilon();
             }
         } else {
-            if constexpr (std::is_floating_point_v<B>) {
+            if constexpr (is_floating_point_v<B>) {
                 return std::fabs(static_cast<B>(a) - static_cast<B>(b)) < std::numeric_limits<B>::epsilon();
             } else {
                 return a == b;
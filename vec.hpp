@@ -0,0 +1,296 @@
+/**@file
+ * @brief Packed saturating vectors.
+ *
+ * `saturating::vec<S, N>` holds `N` lanes of element type `S` (a `saturating::type` or plain arithmetic type,
+ * using its full range) in a GCC / Clang vector extension register, with the same operator surface as
+ * `saturating::type`: `+ - * /` with another vector or a scalar, `clamp`, `from` and `scale_from`.
+ * Results are identical to applying the scalar functions lane by lane:
+ *
+ *     using pixel_t = saturating::type<int16_t, 0, 1023>;
+ *     auto v = saturating::vec<pixel_t, 16>::load(row);
+ *     (v * 3 - bias).store(row);
+ *
+ * Same type 8 and 16 bit vectors of the native register width use the saturating instructions through
+ * `simd.hpp`. 8 to 32 bit integers otherwise work in double width lanes, clamped with vector compares.
+ * 64 bit integers, all divisions and scalars the lane type can't hold exactly (out of range or floating point)
+ * go lane by lane through the scalar functions. Saturations aren't counted by `SATURATING_STATS`.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "./utilities.hpp"
+#include "./functions.hpp"
+#include "./scale.hpp"
+#include "./types.hpp"
+#include "./simd.hpp"
+
+namespace saturating {
+    namespace detail {
+        /** Vector extension register of `N` lanes of `V`. */
+        template <typename V, std::size_t N>
+        struct vector_register {
+            typedef V type __attribute__((vector_size(sizeof(V) * N)));
+        };
+
+        template <typename V, std::size_t N>
+        using vector_register_t = typename vector_register<V, N>::type;
+
+        /**
+         * Lane type `+ - *` of `V` are computed in, `V` itself if no vector wide enough exists. Signed for
+         * differences, unsigned products need the full double width.
+         */
+        template <typename V, bool Multiply>
+        using vector_wide_t = std::conditional_t<is_integral_v<V> && sizeof(V) <= 4,
+                                                 std::conditional_t<Multiply && is_unsigned_v<V>, next_up_t<V>, signed_t<next_up_t<V>>>,
+                                                 V>;
+    } // namespace detail
+
+    /** `N` lanes of element type `S`, saturating to the limits of `S`. */
+    template <typename S, std::size_t N>
+    class vec {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "The number of lanes must be a power of two");
+
+    public:
+        using element_type  = S;
+        using value_type    = typename range_of<S>::value_type;
+        using register_type = detail::vector_register_t<value_type, N>;
+
+        static constexpr std::size_t size = N;
+        static constexpr limit_t<value_type> min_val = range_of<S>::min_val;
+        static constexpr limit_t<value_type> max_val = range_of<S>::max_val;
+
+        /** Create a new zero-initialized vector. */
+        constexpr vec() noexcept : value{} {}
+
+        /** Broadcast `v` to all lanes, *NOT* clamped (use `from()`). */
+        constexpr vec(const S& v) noexcept : value{} { value += static_cast<value_type>(v); }
+
+        /** Wrap a register, *NOT* clamped. */
+        explicit constexpr vec(const register_type& v) noexcept : value{ v } {}
+
+        /** Load `N` elements from `p`, no alignment required. */
+        static vec load(const S* p) noexcept {
+            vec out;
+            std::memcpy(&out.value, static_cast<const void*>(p), sizeof(register_type));
+            return out;
+        }
+
+        /** Store all lanes to `p`, no alignment required. */
+        void store(S* p) const noexcept { std::memcpy(static_cast<void*>(p), &value, sizeof(register_type)); }
+
+        /** Lane `i`. */
+        constexpr S operator[](std::size_t i) const noexcept { return S{ value[i] }; }
+
+        /** Set lane `i` to `v`, *NOT* clamped. */
+        constexpr void set(std::size_t i, const S& v) noexcept { value[i] = static_cast<value_type>(v); }
+
+        /** The underlying register. */
+        constexpr const register_type& data() const noexcept { return value; }
+
+        friend vec operator+(const vec& a, const vec& b) noexcept { return a.template wide<op::add>(b); }
+        friend vec operator-(const vec& a, const vec& b) noexcept { return a.template wide<op::subtract>(b); }
+        friend vec operator*(const vec& a, const vec& b) noexcept { return a.template wide<op::multiply>(b); }
+        friend vec operator/(const vec& a, const vec& b) noexcept {
+            vec out;
+            for (std::size_t i = 0; i < N; ++i) {
+                out.value[i] = saturating::divide<value_type, min_val, max_val>(a.value[i], b.value[i]);
+            }
+            return out;
+        }
+
+        template <typename U> friend std::enable_if_t<is_arithmetic_v<U>, vec> operator+(const vec& a, const U& b) noexcept { return a.template with<op::add>(b); }
+        template <typename U> friend std::enable_if_t<is_arithmetic_v<U>, vec> operator-(const vec& a, const U& b) noexcept { return a.template with<op::subtract>(b); }
+        template <typename U> friend std::enable_if_t<is_arithmetic_v<U>, vec> operator*(const vec& a, const U& b) noexcept { return a.template with<op::multiply>(b); }
+        template <typename U> friend std::enable_if_t<is_arithmetic_v<U>, vec> operator/(const vec& a, const U& b) noexcept { return a.template with<op::divide>(b); }
+        template <typename U> friend std::enable_if_t<is_arithmetic_v<U>, vec> operator+(const U& a, const vec& b) noexcept { return b.template with<op::add, true>(a); }
+        template <typename U> friend std::enable_if_t<is_arithmetic_v<U>, vec> operator-(const U& a, const vec& b) noexcept { return b.template with<op::subtract, true>(a); }
+        template <typename U> friend std::enable_if_t<is_arithmetic_v<U>, vec> operator*(const U& a, const vec& b) noexcept { return b.template with<op::multiply, true>(a); }
+        template <typename U> friend std::enable_if_t<is_arithmetic_v<U>, vec> operator/(const U& a, const vec& b) noexcept { return b.template with<op::divide, true>(a); }
+
+        template <typename U> vec& operator+=(const U& other) noexcept { return *this = *this + other; }
+        template <typename U> vec& operator-=(const U& other) noexcept { return *this = *this - other; }
+        template <typename U> vec& operator*=(const U& other) noexcept { return *this = *this * other; }
+        template <typename U> vec& operator/=(const U& other) noexcept { return *this = *this / other; }
+
+        /** All lanes equal? */
+        friend bool operator==(const vec& a, const vec& b) noexcept {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (a.value[i] != b.value[i]) return false;
+            }
+            return true;
+        }
+        friend bool operator!=(const vec& a, const vec& b) noexcept { return !(a == b); }
+
+        /**
+         * Clamp the lanes of `v` to the limits of `S`, like `type::clamp` (floating point values are rounded).
+         * @param  v Vector of any element type with `N` lanes
+         * @return   Clamped vector
+         */
+        template <typename U>
+        static vec clamp(const vec<U, N>& v) noexcept {
+            using UV = typename vec<U, N>::value_type;
+            if constexpr (std::is_integral_v<value_type> && is_integral_v<UV> && sizeof(UV) < 8 && sizeof(value_type) < 8) {
+                using C = std::conditional_t<(sizeof(UV) > sizeof(value_type)), signed_t<next_up_t<UV>>, signed_t<next_up_t<value_type>>>;
+                using CV = detail::vector_register_t<C, N>;
+                return narrow(__builtin_convertvector(v.data(), CV));
+            } else {
+                vec out;
+                for (std::size_t i = 0; i < N; ++i) {
+                    out.value[i] = static_cast<value_type>(type<value_type, min_val, max_val>::clamp(v.data()[i]));
+                }
+                return out;
+            }
+        }
+
+        /** New vector with the lanes of `v` clamped to the limits of `S`. */
+        template <typename U>
+        static vec from(const vec<U, N>& v) noexcept { return clamp(v); }
+
+        /** Broadcast `v`, clamped to the limits of `S`. */
+        template <typename U>
+        static std::enable_if_t<is_arithmetic_v<U>, vec> from(const U& v) noexcept {
+            return vec{ static_cast<value_type>(type<value_type, min_val, max_val>::from(v)) };
+        }
+
+        /**
+         * Scale the lanes of `v` from the range of `U` to the range of `S`, like `type::scale_from`.
+         * @param  v Vector of any element type with `N` lanes
+         * @return   Scaled vector
+         */
+        template <typename U>
+        static vec scale_from(const vec<U, N>& v) noexcept {
+            using R = range_of<U>;
+            vec out;
+            for (std::size_t i = 0; i < N; ++i) {
+                out.value[i] = saturating::scale<value_type, min_val, max_val, typename R::value_type, R::min_val, R::max_val>(v.data()[i]);
+            }
+            return out;
+        }
+
+    private:
+        enum class op { add, subtract, multiply, divide };
+
+        /** Does scalar `v` convert to `value_type` without changing its value? */
+        template <typename U>
+        static constexpr bool exact(const U& v) noexcept {
+            using B = base_t<U>;
+            if constexpr (std::is_same_v<B, value_type>) {
+                return true;
+            } else if constexpr (std::is_integral_v<value_type> && is_integral_v<B>) {
+                const B x = detail::value_of(v);
+                const value_type c = static_cast<value_type>(x);
+                return static_cast<B>(c) == x && is_negative(c) == is_negative(x);
+            } else {
+                // Floating point on either side rounds differently once converted
+                return false;
+            }
+        }
+
+        /**
+         * `O` on all lanes and scalar `v` (the left hand side if `Reversed`), with the results of the scalar
+         * functions. Scalars `value_type` holds exactly are broadcast, any other goes lane by lane.
+         */
+        template <op O, bool Reversed = false, typename U>
+        vec with(const U& v) const noexcept {
+            if (exact(v)) {
+                const vec b{ static_cast<value_type>(detail::value_of(v)) };
+                const vec& x = Reversed ? b : *this;
+                const vec& y = Reversed ? *this : b;
+                if constexpr (O == op::add) {
+                    return x + y;
+                } else if constexpr (O == op::subtract) {
+                    return x - y;
+                } else if constexpr (O == op::multiply) {
+                    return x * y;
+                } else {
+                    return x / y;
+                }
+            }
+            const auto f = [](const auto& x, const auto& y) {
+                if constexpr (O == op::add) {
+                    return saturating::add<value_type, min_val, max_val>(x, y);
+                } else if constexpr (O == op::subtract) {
+                    return saturating::subtract<value_type, min_val, max_val>(x, y);
+                } else if constexpr (O == op::multiply) {
+                    return saturating::multiply<value_type, min_val, max_val>(x, y);
+                } else {
+                    return saturating::divide<value_type, min_val, max_val>(x, y);
+                }
+            };
+            vec out;
+            for (std::size_t i = 0; i < N; ++i) {
+                out.value[i] = Reversed ? f(v, value[i]) : f(value[i], v);
+            }
+            return out;
+        }
+
+        /** Clamp double width (or otherwise wider) lanes back to `value_type`. */
+        template <typename CV>
+        static vec narrow(const CV& r) noexcept {
+            using C = base_t<decltype(r[0])>;
+            const CV lo = CV{} + static_cast<C>(min_val);
+            const CV hi = CV{} + static_cast<C>(max_val);
+            const CV c = r < lo ? lo : (r > hi ? hi : r);
+            return vec{ __builtin_convertvector(c, register_type) };
+        }
+
+        /** `O` on all lanes, saturating. */
+        template <op O>
+        vec wide(const vec& other) const noexcept {
+            using W = detail::vector_wide_t<value_type, O == op::multiply>;
+            if constexpr (std::is_integral_v<value_type> && sizeof(value_type) <= 2 && O != op::multiply &&
+                          simd::native_v<simd::native, value_type> && sizeof(register_type) == simd::native::bytes) {
+                // Native saturating instructions, with an extra clamp for custom limits
+                using ISA = simd::native;
+                const auto a = ISA::template load<value_type>(reinterpret_cast<const value_type*>(&value));
+                const auto b = ISA::template load<value_type>(reinterpret_cast<const value_type*>(&other.value));
+                auto r = O == op::add ? ISA::template adds<value_type>(a, b) : ISA::template subs<value_type>(a, b);
+                if constexpr (min_val != std::numeric_limits<value_type>::lowest() || max_val != std::numeric_limits<value_type>::max()) {
+                    r = ISA::template max<value_type>(ISA::template min<value_type>(r, ISA::template set1<value_type>(max_val)),
+                                                      ISA::template set1<value_type>(min_val));
+                }
+                vec out;
+                ISA::template store<value_type>(reinterpret_cast<value_type*>(&out.value), r);
+                return out;
+            } else if constexpr (!std::is_same_v<W, value_type> || std::is_floating_point_v<value_type>) {
+                using WV = detail::vector_register_t<W, N>;
+                const WV a = __builtin_convertvector(value, WV);
+                const WV b = __builtin_convertvector(other.value, WV);
+                if constexpr (O == op::add) {
+                    return narrow(a + b);
+                } else if constexpr (O == op::subtract) {
+                    return narrow(a - b);
+                } else {
+                    return narrow(a * b);
+                }
+            } else {
+                vec out;
+                for (std::size_t i = 0; i < N; ++i) {
+                    if constexpr (O == op::add) {
+                        out.value[i] = saturating::add<value_type, min_val, max_val>(value[i], other.value[i]);
+                    } else if constexpr (O == op::subtract) {
+                        out.value[i] = saturating::subtract<value_type, min_val, max_val>(value[i], other.value[i]);
+                    } else {
+                        out.value[i] = saturating::multiply<value_type, min_val, max_val>(value[i], other.value[i]);
+                    }
+                }
+                return out;
+            }
+        }
+
+        register_type value;
+    };
+} // namespace saturating
+
+namespace std {
+    /** The limits of a vector are those of its element type. */
+    template <typename S, std::size_t N>
+    class numeric_limits<saturating::vec<S, N>> : public numeric_limits<S> {};
+} // namespace std
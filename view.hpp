@@ -0,0 +1,167 @@
+/**@file
+ * @brief Saturating types over raw buffers, without copying.
+ *
+ * A `saturating::type` has the layout of its base type (see `detail::same_layout_v` in `types.hpp`), so a buffer
+ * of plain integers, from the network or a memory mapped file, can be used as saturating values in place.
+ * `saturating::view<S, L>` wraps such a buffer. With `load::unchecked` the elements are `S` as they are, which
+ * requires every value to be in `MIN` ... `MAX` already (always the case for full range types like `uint_sat8_t`),
+ * and `data()` can be passed to the bulk functions directly. With `load::clamp` each element is clamped with
+ * `S::clamp` as it is read, or the whole buffer once with `clamp()`, after which it can be used unchecked.
+ *
+ * Views are `const` when `S` is: `view<const uint_sat8_t>` wraps a `const uint8_t*`.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#if __has_include(<span>) && __cplusplus > 201703L
+#include <span>
+#endif
+
+#include "./utilities.hpp"
+#include "./types.hpp"
+
+namespace saturating {
+    /** How a `view` treats the values in its buffer. */
+    enum class load {
+        /** Use the values as they are, they must be in `MIN` ... `MAX`. */
+        unchecked,
+        /** Clamp every value to `MIN` ... `MAX` as it is read. */
+        clamp
+    };
+
+    /**
+     * Saturating values stored in a buffer of their base type.
+     * @tparam S Element type, a (possibly `const`) `saturating::type`
+     * @tparam L Treatment of the values in the buffer, see `load`
+     */
+    template <typename S, load L = load::clamp>
+    class view {
+        using V = std::remove_const_t<S>;
+        using T = typename range_of<V>::value_type;
+
+        static_assert(is_saturating_v<V>, "Views hold saturating types");
+        static_assert(detail::same_layout_v<V>, "A saturating type has the layout of its base type");
+
+    public:
+        using element_type = S;
+        using value_type = V;
+        using raw_type = std::conditional_t<std::is_const_v<S>, const T, T>;
+        using size_type = std::size_t;
+
+        /** Element read with clamping. */
+        class clamping_iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = V;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = V;
+
+            constexpr clamping_iterator() noexcept = default;
+            constexpr explicit clamping_iterator(const T* p) noexcept : p{ p } {}
+
+            constexpr V operator*() const noexcept { return V::clamp(*p); }
+            constexpr clamping_iterator& operator++() noexcept { ++p; return *this; }
+            constexpr clamping_iterator operator++(int) noexcept { return clamping_iterator{ p++ }; }
+
+            constexpr bool operator==(const clamping_iterator& other) const noexcept { return p == other.p; }
+            constexpr bool operator!=(const clamping_iterator& other) const noexcept { return p != other.p; }
+
+        private:
+            const T* p = nullptr;
+        };
+
+        using iterator = std::conditional_t<L == load::unchecked, S*, clamping_iterator>;
+
+        constexpr view() noexcept = default;
+
+        /** View of `raw[0] ... raw[n - 1]`. */
+        constexpr view(raw_type* raw, std::size_t n) noexcept : ptr{ raw }, count{ n } {}
+
+#ifdef __cpp_lib_span
+        template <typename U, std::size_t E, typename = std::enable_if_t<std::is_convertible_v<U (*)[], raw_type (*)[]>>>
+        constexpr view(std::span<U, E> raw) noexcept : ptr{ raw.data() }, count{ raw.size() } {}
+#endif
+
+        /** The same buffer treated the other way. */
+        template <load O>
+        constexpr view(const view<S, O>& other) noexcept : ptr{ other.raw() }, count{ other.size() } {}
+
+        /**
+         * View of a memory region, such as a memory mapped file. Trailing bytes that don't make up a whole element
+         * are left out.
+         * @param  bytes Start of the region, aligned for `T`
+         * @param  size  Size of the region in bytes
+         */
+        static view from_bytes(std::conditional_t<std::is_const_v<S>, const void, void>* bytes, std::size_t size) noexcept {
+            return { static_cast<raw_type*>(bytes), size / sizeof(T) };
+        }
+
+        constexpr std::size_t size() const noexcept { return count; }
+        constexpr bool empty() const noexcept { return count == 0; }
+
+        /** The buffer as its base type. */
+        constexpr raw_type* raw() const noexcept { return ptr; }
+
+        /** The buffer as saturating types, for the bulk functions. Only for `load::unchecked` views. */
+        template <load M = L, typename = std::enable_if_t<M == load::unchecked>>
+        S* data() const noexcept { return reinterpret_cast<S*>(ptr); }
+
+        /** Element `i`, a reference for `load::unchecked` views and clamped to `MIN` ... `MAX` otherwise. */
+        constexpr decltype(auto) operator[](std::size_t i) const noexcept {
+            if constexpr (L == load::unchecked) {
+                return reinterpret_cast<S&>(ptr[i]);
+            } else {
+                return V::clamp(ptr[i]);
+            }
+        }
+
+        /** Store `val` in element `i`, clamped to `MIN` ... `MAX`. */
+        template <typename U, typename R = raw_type>
+        constexpr std::enable_if_t<!std::is_const_v<R>> store(std::size_t i, const U& val) const noexcept {
+            ptr[i] = V::clamp(detail::value_of(val));
+        }
+
+        iterator begin() const noexcept {
+            if constexpr (L == load::unchecked) {
+                return reinterpret_cast<S*>(ptr);
+            } else {
+                return iterator{ ptr };
+            }
+        }
+        iterator end() const noexcept {
+            if constexpr (L == load::unchecked) {
+                return reinterpret_cast<S*>(ptr + count);
+            } else {
+                return iterator{ ptr + count };
+            }
+        }
+
+        /** Elements `offset ... offset + n - 1`. */
+        constexpr view subview(std::size_t offset, std::size_t n) const noexcept { return { ptr + offset, n }; }
+
+        /**
+         * Clamp every element in place, a single pass the compiler can vectorize.
+         * @return The same buffer, to be used unchecked
+         */
+        template <typename R = raw_type>
+        std::enable_if_t<!std::is_const_v<R>, view<S, load::unchecked>> clamp() const noexcept {
+            if constexpr (range_of<V>::min_val != std::numeric_limits<T>::lowest() || range_of<V>::max_val != std::numeric_limits<T>::max()) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    ptr[i] = V::clamp(ptr[i]);
+                }
+            }
+            return { ptr, count };
+        }
+
+    private:
+        raw_type* ptr = nullptr;
+        std::size_t count = 0;
+    };
+} // namespace saturating